@@ -21,7 +21,7 @@ int main(void) {
     GPIOC->MODER &= ~(3u<<(13*2));
     GPIOC->MODER |=  (1u<<(13*2));
     serial_stdio_init(115200);
-    i2c1_init_100k(50000000u);
+    i2c1_init(50000000u, 400000u);   // fast mode (DUTY 16:9, CCR=5)
 
     if (mpu6050_init() < 0) {
         for (;;) { GPIOC->ODR ^= (1u<<13); delay_ms(150); }
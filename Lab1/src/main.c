@@ -2,7 +2,7 @@
 #include <stdlib.h>
 #include "stm32f4xx.h"
 #include "delay.h"
-#include "serial.h"
+#include "serial_stdio.h"
 #include "st7789.h"
 #include "board.h"
 #include "main.h" 
@@ -17,9 +17,6 @@ static const uint16_t colors[] = {
 
 #define COLORS_LEN (sizeof(colors)/sizeof(colors[0]))
 
-static inline int  uart_rx_ready(void) { return (USART1->SR & USART_SR_RXNE) != 0; }
-static inline char uart_getc(void)     { return (char)USART1->DR; }
-
 uint32_t last_tick_ms = 0;
 uint32_t last_tick_s = 0;
 uint32_t color_tick_ms = 1000;
@@ -98,6 +95,7 @@ void animate_bouncing_circle(void) {
 int main(void){
     delay_init();
     serial_stdio_init(115200);
+    serial_rx_async_init();   // comandos chegam por DMA enquanto o quadro desenha
 
     st7789_init();
     st7789_set_speed_div(0);
@@ -113,9 +111,10 @@ int main(void){
     for(;;){
         draw_header(millis());
         animate_bouncing_circle();
-        if (uart_rx_ready()){
-            char c = uart_getc();
-            switch(c){
+        char cmd[16];
+        int n = serial_read(cmd, sizeof(cmd));
+        for (int i = 0; i < n; i++){
+            switch(cmd[i]){
                 case '1': increase_ball_speed(); break;
                 case '2': decrease_ball_speed(); break;
                 default: break;
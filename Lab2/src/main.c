@@ -2,7 +2,9 @@
 #include <stdio.h>
 #include <string.h>
 #include "serial_stdio.h"
+#include "fmt.h"
 #include "mpu6050.h"
+#include "filt.h"
 #include "st7789.h"
 #include "delay.h"
 
@@ -11,6 +13,8 @@
 #define LED_BLUE_PIN    4
 #define BUTTON_PIN      0
 
+/* ±8 g / ±500 dps como o transmissor ESP32; limiares e telemetria em
+   contagens de ±2 g / ±250 dps (mpu6050_accel_base/gyro_base). */
 #define ACCEL_BRAKE_THRESHOLD    -8000
 #define ACCEL_CRASH_THRESHOLD    20000
 #define GYRO_CURVE_THRESHOLD     8000
@@ -85,10 +89,12 @@ static uint8_t button_read(void) {
 
 static void update_display(void) {
     char buf[8];
+    fmt_t w;
     
     st7789_fill_screen_dma(COLOR_BLACK);
     
-    snprintf(buf, sizeof(buf), "%02lu", total_events);
+    fmt_init(&w, buf, sizeof(buf));
+    FMT(&w, FMT_U(total_events, 2, '0'));
     st7789_draw_text_5x7(80, 100, buf, COLOR_WHITE, 8, 0, 0);
 }
 
@@ -111,26 +117,54 @@ static void update_leds(void) {
     }
 }
 
-static void detect_events(mpu6050_raw_t *data) {
+/* Filtros da detecção (amostragem 20 Hz): mediana de 3 tira picos isolados
+   e o passa-baixa de 3 Hz suaviza frenagem e curva. A batida é justamente
+   um pico, então usa o dado cru; a telemetria também segue crua. */
+#define SAMPLE_HZ 20.0f
+
+static filt_median_t med_ax, med_gz;
+static filt_biquad_t lp_ax, lp_gz;
+static int16_t med_ax_buf[3], med_gz_buf[3];
+
+static void filters_init(void) {
+    filt_median_init(&med_ax, med_ax_buf, 3);
+    filt_median_init(&med_gz, med_gz_buf, 3);
+    filt_biquad_lowpass(&lp_ax, SAMPLE_HZ, 3.0f, 0.707f);
+    filt_biquad_lowpass(&lp_gz, SAMPLE_HZ, 3.0f, 0.707f);
+}
+
+static void filters_apply(const mpu6050_raw_t *in, mpu6050_raw_t *out) {
+    *out = *in;
+    filt_median(&med_ax, &out->ax, &out->ax, 1);
+    filt_biquad(&lp_ax, &out->ax, &out->ax, 1);
+    filt_median(&med_gz, &out->gz, &out->gz, 1);
+    filt_biquad(&lp_gz, &out->gz, &out->gz, 1);
+}
+
+static void detect_events(const mpu6050_raw_t *raw, const mpu6050_raw_t *filt) {
     static uint8_t brake_detected = 0;
     static uint8_t crash_detected = 0;
     static uint8_t curve_detected = 0;
+    int32_t fax = mpu6050_accel_base(filt->ax);
+    int32_t fgz = mpu6050_gyro_base(filt->gz);
+    int32_t ay = mpu6050_accel_base(raw->ay);
+    int32_t az = mpu6050_accel_base(raw->az);
     
-    if (data->ax < ACCEL_BRAKE_THRESHOLD && !brake_detected) {
+    if (fax < ACCEL_BRAKE_THRESHOLD && !brake_detected) {
         total_events++;
         brake_detected = 1;
         led_on(LED_RED_PIN);
         led_red_timer = millis();
         update_display();
-    } else if (data->ax > ACCEL_BRAKE_THRESHOLD) {
+    } else if (fax > ACCEL_BRAKE_THRESHOLD) {
         brake_detected = 0;
     }
     
-    int16_t total_accel = data->ax;
-    if (data->ay < 0) total_accel -= data->ay;
-    else total_accel += data->ay;
-    if (data->az < 0) total_accel -= data->az;
-    else total_accel += data->az;
+    int32_t total_accel = mpu6050_accel_base(raw->ax);
+    if (ay < 0) total_accel -= ay;
+    else total_accel += ay;
+    if (az < 0) total_accel -= az;
+    else total_accel += az;
     
     if (total_accel > ACCEL_CRASH_THRESHOLD && !crash_detected) {
         total_events++;
@@ -142,13 +176,13 @@ static void detect_events(mpu6050_raw_t *data) {
         crash_detected = 0;
     }
     
-    if ((data->gz > GYRO_CURVE_THRESHOLD || data->gz < -GYRO_CURVE_THRESHOLD) && !curve_detected) {
+    if ((fgz > GYRO_CURVE_THRESHOLD || fgz < -GYRO_CURVE_THRESHOLD) && !curve_detected) {
         total_events++;
         curve_detected = 1;
         led_on(LED_BLUE_PIN);
         led_blue_timer = millis();
         update_display();
-    } else if (data->gz < GYRO_CURVE_THRESHOLD/2 && data->gz > -GYRO_CURVE_THRESHOLD/2) {
+    } else if (fgz < GYRO_CURVE_THRESHOLD/2 && fgz > -GYRO_CURVE_THRESHOLD/2) {
         curve_detected = 0;
     }
 }
@@ -176,7 +210,7 @@ int main(void) {
     st7789_set_speed_div(2);
     printf("Display initialized\n");
     
-    i2c1_init_100k(50000000u);
+    i2c1_init(50000000u, 400000u);   // fast mode (DUTY 16:9, CCR=5)
     
     if (mpu6050_init() < 0) {
         printf("MPU6050 INIT FAILED\n");
@@ -190,7 +224,13 @@ int main(void) {
         }
     }
     
+    mpu6050_set_accel_range(MPU6050_ACCEL_8G);
+    mpu6050_set_gyro_range(MPU6050_GYRO_500DPS);
     printf("MPU6050 initialized\n");
+    filters_init();
+#ifdef FILT_BENCH
+    filt_bench();   // ciclos/amostra de cada estágio (SIMD vs. referência)
+#endif
     update_display();
     hc12_send_string("SYSTEM READY\n");
     printf("System ready, starting loop\n");
@@ -198,7 +238,7 @@ int main(void) {
     uint32_t tx_count = 0;
     
     for (;;) {
-        mpu6050_raw_t r;
+        mpu6050_raw_t r, rf;
         
         uint8_t button_curr = button_read();
         if (button_curr && !button_prev) {
@@ -214,11 +254,16 @@ int main(void) {
         button_prev = button_curr;
         
         if (mpu6050_read_all(&r) == 0) {
-            detect_events(&r);
+            filters_apply(&r, &rf);
+            detect_events(&r, &rf);
             
             char buf[80];
-            snprintf(buf, sizeof(buf), "[CAMARADAS DO EDU]: %d, %d, %d, %d, %d, %d\n",
-                     r.ax, r.ay, r.az, r.gx, r.gy, r.gz);
+            fmt_t w;
+            fmt_init(&w, buf, sizeof(buf));
+            FMT(&w, "[CAMARADAS DO EDU]: ",
+                mpu6050_accel_base(r.ax), ", ", mpu6050_accel_base(r.ay), ", ",
+                mpu6050_accel_base(r.az), ", ", mpu6050_gyro_base(r.gx), ", ",
+                mpu6050_gyro_base(r.gy), ", ", mpu6050_gyro_base(r.gz), "\n");
             
             hc12_send_string(buf);
             tx_count++;
@@ -8,7 +8,7 @@
  * Kernel
  * ---------------------------------------------------------- */
 #define configUSE_PREEMPTION                         1
-#define configUSE_IDLE_HOOK                          0
+#define configUSE_IDLE_HOOK                          1
 #define configUSE_TICK_HOOK                          0
 #define configCPU_CLOCK_HZ                           ( SystemCoreClock )
 #define configTICK_RATE_HZ                           ( 1000 )
@@ -33,6 +33,7 @@
  * ---------------------------------------------------------- */
 #define configUSE_MUTEXES                            1
 #define configUSE_TASK_NOTIFICATIONS                 1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES        2   /* [1] = fim de transação I2C */
 #define configUSE_TIMERS                             0
 #define configQUEUE_REGISTRY_SIZE                    8
 
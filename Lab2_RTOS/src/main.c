@@ -4,14 +4,18 @@
 #include <stdint.h>
 
 #include "serial_stdio.h"
+#include "log_task.h"
+#include "fmt.h"
 #include "mpu6050.h"
+#include "mpu6050_dual.h"
+#include "spsc.h"
+#include "drv_time.h"
 #include "st7789.h"
 // NÃO usar delay_rtos aqui antes do scheduler
 // #include "delay_rtos.h"
 
 #include "FreeRTOS.h"
 #include "task.h"
-#include "queue.h"
 
 /* ==== FreeRTOS hooks ==== */
 
@@ -37,6 +41,12 @@ void vApplicationMallocFailedHook(void) {
     }
 }
 
+/* nada pronto para rodar: core em sleep até a próxima IRQ (SysTick, EXTI).
+   O CYCCNT segue contando no WFI por causa do DBG_SLEEP (drv_cycles_init). */
+void vApplicationIdleHook(void) {
+    __WFI();
+}
+
 /* ==== busy delay só para antes do scheduler ==== */
 
 static void busy_delay_cycles(volatile uint32_t cycles) {
@@ -58,10 +68,21 @@ static void busy_delay_ms(uint32_t ms) {
 #define LED_BLUE_PIN    4
 #define BUTTON_PIN      0
 
+/* Sensor em ±8 g / ±500 dps (mesmas escalas do transmissor ESP32); os
+   limiares e a telemetria seguem em contagens de ±2 g / ±250 dps
+   (mpu6050_accel_base/gyro_base), que é o que o cliente espera, mas agora
+   passam de 32767 em vez de saturar em 2 g. */
 #define ACCEL_BRAKE_THRESHOLD    -8000
 #define ACCEL_CRASH_THRESHOLD    20000
 #define GYRO_CURVE_THRESHOLD     8000
 
+/* estacionado: amostras quase iguais por PARK_MS -> MPU em wake-on-motion */
+#define PARK_MS                  10000u
+#define PARK_ACCEL_DELTA         400     /* LSB entre amostras (±2 g: ~24 mg) */
+#define PARK_GYRO_MAX            400     /* LSB (±250 dps: ~3 dps)           */
+#define WOM_THR_MG               40u
+#define WOM_DUR_MS               1u
+
 #define COLOR_RED       0xF800
 #define COLOR_GREEN     0x07E0
 #define COLOR_BLUE      0x001F
@@ -71,14 +92,27 @@ static void busy_delay_ms(uint32_t ms) {
 /* ==== shared state ==== */
 
 static volatile uint32_t total_events = 0;
+static volatile uint8_t parked = 0;         /* TelemetryTask escreve, DisplayTask lê */
+static TaskHandle_t displayTask = NULL;
 static uint8_t button_prev = 0;
 
 static TickType_t led_red_timer   = 0;
 static TickType_t led_green_timer = 0;
 static TickType_t led_blue_timer  = 0;
 
-/* queue para eventos (MPU -> EventTask) */
-static QueueHandle_t mpuQueue = NULL;
+/* amostras TelemetryTask -> EventTask: anel SPSC sem kernel. A leitura do
+   I2C cai direto no slot e o EventTask processa o trecho inteiro de uma
+   vez; a notificação só acorda, quem carrega os dados é o anel. */
+#define IMU_RING_LEN             16u     /* potência de 2 */
+static mpu6050_dual_sample_t imu_ring_buf[IMU_RING_LEN];
+static spsc_t imu_ring;
+static TaskHandle_t eventTask = NULL;
+
+/* chassi = mpu6050_main (0x68); direção opcional em 0x69 (AD0 = VCC) */
+#define IMU_STEER_ADDR           0x69u
+#define DUAL_REPORT_SAMPLES      200u    /* skew/anel no printf a cada ~10 s */
+static mpu6050_t imu_steer;
+static mpu6050_dual_t imu_pair;
 
 /* ==== HC-12 / USART2 ==== */
 
@@ -158,10 +192,12 @@ static uint8_t button_read(void) {
 
 static void update_display(void) {
     char buf[8];
+    fmt_t w;
 
     st7789_fill_screen_dma(COLOR_BLACK);
 
-    snprintf(buf, sizeof(buf), "%02lu", (unsigned long)total_events);
+    fmt_init(&w, buf, sizeof(buf));
+    FMT(&w, FMT_U(total_events, 2, '0'));
     st7789_draw_text_5x7(80, 100, buf, COLOR_WHITE, 8, 0, 0);
 }
 
@@ -187,25 +223,40 @@ static void update_leds(void) {
 
 /* ==== event detection ==== */
 
-static void detect_events(const mpu6050_raw_t *data) {
+/* ax + |ay| + |az| em contagens de ±2 g */
+static int32_t accel_total(const mpu6050_t *m, const mpu6050_raw_t *r) {
+    int32_t ay = mpu6050_dev_accel_base(m, r->ay);
+    int32_t az = mpu6050_dev_accel_base(m, r->az);
+    return mpu6050_dev_accel_base(m, r->ax) + (ay < 0 ? -ay : ay) + (az < 0 ? -az : az);
+}
+
+/* Freada e curva pelo chassi; batida por qualquer um dos sensores (a
+   direção pega o impacto frontal antes do chassi). */
+static void detect_events(const mpu6050_dual_sample_t *s) {
     static uint8_t brake_detected = 0;
     static uint8_t crash_detected = 0;
     static uint8_t curve_detected = 0;
+    const mpu6050_raw_t *data = &s->raw[0];
 
-    if (data->ax < ACCEL_BRAKE_THRESHOLD && !brake_detected) {
+    if (!(s->ok & 1u)) return;
+
+    int32_t ax = mpu6050_accel_base(data->ax);
+    int32_t gz = mpu6050_gyro_base(data->gz);
+
+    if (ax < ACCEL_BRAKE_THRESHOLD && !brake_detected) {
         total_events++;
         brake_detected = 1;
         led_on(LED_RED_PIN);
         led_red_timer = xTaskGetTickCount();
-    } else if (data->ax > ACCEL_BRAKE_THRESHOLD) {
+    } else if (ax > ACCEL_BRAKE_THRESHOLD) {
         brake_detected = 0;
     }
 
-    int16_t total_accel = data->ax;
-    if (data->ay < 0) total_accel -= data->ay;
-    else total_accel += data->ay;
-    if (data->az < 0) total_accel -= data->az;
-    else total_accel += data->az;
+    int32_t total_accel = accel_total(&mpu6050_main, data);
+    if (s->ok & 2u) {
+        int32_t t2 = accel_total(&imu_steer, &s->raw[1]);
+        if (t2 > total_accel) total_accel = t2;
+    }
 
     if (total_accel > ACCEL_CRASH_THRESHOLD && !crash_detected) {
         total_events++;
@@ -216,42 +267,110 @@ static void detect_events(const mpu6050_raw_t *data) {
         crash_detected = 0;
     }
 
-    if ((data->gz > GYRO_CURVE_THRESHOLD ||
-         data->gz < -GYRO_CURVE_THRESHOLD) && !curve_detected) {
+    if ((gz > GYRO_CURVE_THRESHOLD ||
+         gz < -GYRO_CURVE_THRESHOLD) && !curve_detected) {
         total_events++;
         curve_detected = 1;
         led_on(LED_BLUE_PIN);
         led_blue_timer = xTaskGetTickCount();
-    } else if (data->gz < GYRO_CURVE_THRESHOLD/2 &&
-               data->gz > -GYRO_CURVE_THRESHOLD/2) {
+    } else if (gz < GYRO_CURVE_THRESHOLD/2 &&
+               gz > -GYRO_CURVE_THRESHOLD/2) {
         curve_detected = 0;
     }
 }
 
 /* ==== tasks ==== */
 
-/* Task de telemetria: única que envia pelo HC-12 */
+static int32_t abs32(int32_t v) { return v < 0 ? -v : v; }
+
+/* limiares em contagens de ±2 g / ±250 dps, como os de eventos */
+static int is_still(const mpu6050_raw_t *r, const mpu6050_raw_t *prev) {
+    return abs32(mpu6050_accel_base(r->ax - prev->ax)) < PARK_ACCEL_DELTA &&
+           abs32(mpu6050_accel_base(r->ay - prev->ay)) < PARK_ACCEL_DELTA &&
+           abs32(mpu6050_accel_base(r->az - prev->az)) < PARK_ACCEL_DELTA &&
+           abs32(mpu6050_gyro_base(r->gx)) < PARK_GYRO_MAX &&
+           abs32(mpu6050_gyro_base(r->gy)) < PARK_GYRO_MAX &&
+           abs32(mpu6050_gyro_base(r->gz)) < PARK_GYRO_MAX;
+}
+
+/* Task de telemetria: única que envia pelo HC-12.
+   Parada por PARK_MS: MPU em modo ciclo (giros off, accel a 20 Hz),
+   telemetria pausada e display apagado; a task dorme no INT de movimento
+   e volta a amostrar assim que ele chega. */
 static void TelemetryTask(void *arg) {
     (void)arg;
     uint32_t tx_count = 0;
+    uint32_t still_ms = 0;
+    mpu6050_raw_t prev = {0};
 
     for (;;) {
-        mpu6050_raw_t r;
+        mpu6050_dual_sample_t spill;
+
+        if (parked) {
+            (void)drv_cycles64();   // estacionado por minutos: não perder a volta do CYCCNT
+            if (mpu6050_wom_wait(1000u)) {
+                mpu6050_wom_exit();
+                parked = 0;
+                still_ms = 0;
+                xTaskNotifyGive(displayTask);
+                LOG_I("[WOM] movimento, telemetria retomada\n");
+            }
+            continue;   // lê já, sem esperar o período
+        }
 
-        if (mpu6050_read_all(&r) == 0) {
+        // chassi e direção na mesma passada do I2C, cada um com seu carimbo,
+        // lidos direto no slot do anel (cheio: lê à parte, conta overflow)
+        mpu6050_dual_sample_t *slot = spsc_write_ptr(&imu_ring);
+        mpu6050_dual_sample_t *s = slot ? slot : &spill;
+        (void)mpu6050_dual_read(&imu_pair, s);
+        if (s->ok & 1u) {
+            const mpu6050_raw_t *r = &s->raw[0];
             char buf[80];
+            fmt_t w;
 
-            snprintf(buf, sizeof(buf),
-                     "[CAMARADAS DO EDU]: %d, %d, %d, %d, %d, %d\n",
-                     r.ax, r.ay, r.az, r.gx, r.gy, r.gz);
+            // mesma linha do snprintf "%ld, ..." sem passar pelo vfprintf
+            fmt_init(&w, buf, sizeof(buf));
+            FMT(&w, "[CAMARADAS DO EDU]: ",
+                mpu6050_accel_base(r->ax), ", ", mpu6050_accel_base(r->ay), ", ",
+                mpu6050_accel_base(r->az), ", ", mpu6050_gyro_base(r->gx), ", ",
+                mpu6050_gyro_base(r->gy), ", ", mpu6050_gyro_base(r->gz), "\n");
 
-            hc12_send_string(buf);
+            hc12_send_string(buf);   // formato do rádio inalterado
 
             tx_count++;
-            printf("TX[%lu]: %s",
-                   (unsigned long)tx_count, buf);
-
-            (void)xQueueSend(mpuQueue, &r, 0);
+            LOG_D("TX[%lu] t=%lu ms: %s",
+                  (unsigned long)tx_count, (unsigned long)drv_cyc_to_ms(s->t_cyc[0]), buf);
+
+            if (slot) {
+                spsc_commit(&imu_ring);
+                xTaskNotifyGive(eventTask);
+            }
+
+            if ((tx_count % DUAL_REPORT_SAMPLES) == 0u) {
+                LOG_I("[RING] overflows %lu, pico %lu/%lu\n",
+                      (unsigned long)imu_ring.overflows, (unsigned long)imu_ring.high_water,
+                      (unsigned long)spsc_capacity(&imu_ring));
+                const serial_tx_stats_t *tx = serial_tx_get_stats();
+                LOG_I("[UART] %lu B, descartados %lu, pico %lu/%u\n",
+                      (unsigned long)tx->bytes, (unsigned long)tx->dropped,
+                      (unsigned long)tx->high_water, STDIO_TX_RING_SIZE);
+                const log_stats_t *lg = log_get_stats();
+                LOG_I("[LOG] %lu linhas, descartadas %lu, pico %lu/%u B\n",
+                      (unsigned long)lg->written, (unsigned long)lg->dropped,
+                      (unsigned long)lg->high_water, LOG_RING_SIZE);
+                if (imu_pair.imu[1]) mpu6050_dual_print(&imu_pair);
+            }
+
+            still_ms = is_still(r, &prev) ? still_ms + 50u : 0u;
+            prev = *r;
+            if (still_ms >= PARK_MS &&
+                mpu6050_wom_enter(xTaskGetCurrentTaskHandle(), WOM_THR_MG,
+                                  WOM_DUR_MS, MPU6050_LP_WAKE_20HZ) >= 0) {
+                LOG_I("[WOM] parado, dormindo\n");
+                parked = 1;
+                xTaskNotifyGive(displayTask);
+                continue;
+            }
         }
 
         vTaskDelay(pdMS_TO_TICKS(50));
@@ -260,11 +379,18 @@ static void TelemetryTask(void *arg) {
 
 static void EventTask(void *arg) {
     (void)arg;
-    mpu6050_raw_t r;
 
     for (;;) {
-        if (xQueueReceive(mpuQueue, &r, pdMS_TO_TICKS(20)) == pdPASS) {
-            detect_events(&r);
+        (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(20));
+
+        void *p;
+        uint32_t n;
+        while ((n = spsc_read_span(&imu_ring, &p)) != 0u) {
+            const mpu6050_dual_sample_t *s = p;
+            for (uint32_t i = 0; i < n; i++) {
+                detect_events(&s[i]);
+            }
+            spsc_release(&imu_ring, n);
         }
         update_leds();
     }
@@ -273,14 +399,20 @@ static void EventTask(void *arg) {
 static void DisplayTask(void *arg) {
     (void)arg;
     uint32_t last_events = (uint32_t)-1;
+    uint8_t asleep = 0;
 
     for (;;) {
+        if (parked != asleep) {
+            asleep = parked;
+            st7789_sleep(asleep);           // backlight + SLPIN / SLPOUT
+        }
         uint32_t current = total_events;
-        if (current != last_events) {
+        if (!asleep && current != last_events) {
             update_display();
             last_events = current;
         }
-        vTaskDelay(pdMS_TO_TICKS(100));
+        // TelemetryTask notifica ao dormir/acordar
+        (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
     }
 }
 
@@ -298,7 +430,7 @@ static void ButtonTask(void *arg) {
             led_blue_timer  = 0;
             taskEXIT_CRITICAL();
 
-            printf("Counter reset\n");
+            LOG_I("Counter reset\n");
         }
         button_prev = button_curr;
 
@@ -315,6 +447,8 @@ int main(void) {
     button_init();
 
     serial_stdio_init(115200);
+    // printf só copia para o anel e volta; o DMA2 manda (linha cheia: descarta)
+    serial_tx_async_init(SERIAL_TX_DROP);
     printf("=== SERVER DEBUG ===\n");
 
     hc12_init(9600);
@@ -330,7 +464,7 @@ int main(void) {
     st7789_set_speed_div(2);
     printf("Display initialized\n");
 
-    i2c1_init_100k(50000000u);
+    i2c1_init(50000000u, 400000u);   // fast mode (DUTY 16:9, CCR=5)
 
     if (mpu6050_init() < 0) {
         printf("MPU6050 INIT FAILED\n");
@@ -344,22 +478,37 @@ int main(void) {
         }
     }
 
+    mpu6050_set_accel_range(MPU6050_ACCEL_8G);
+    mpu6050_set_gyro_range(MPU6050_GYRO_500DPS);
+
+    // segundo sensor opcional (direção): sem ele, só o chassi
+    if (mpu6050_dev_init(&imu_steer, IMU_STEER_ADDR) == 0) {
+        mpu6050_dev_set_accel_range(&imu_steer, MPU6050_ACCEL_8G);
+        mpu6050_dev_set_gyro_range(&imu_steer, MPU6050_GYRO_500DPS);
+        mpu6050_dual_init(&imu_pair, &mpu6050_main, &imu_steer);
+        printf("MPU6050 #2 (direcao) em 0x%02X\n", IMU_STEER_ADDR);
+    } else {
+        mpu6050_dual_init(&imu_pair, &mpu6050_main, NULL);
+    }
+
+    // I2C por interrupção: TelemetryTask dorme durante a leitura do MPU
+    i2c1_async_init();
+    // CYCCNT rodando também no WFI do idle hook (timeouts do I2C, carimbos)
+    drv_cycles_init();
+
     printf("MPU6050 initialized\n");
     update_display();
     hc12_send_string("SYSTEM READY\n");
     printf("System ready, starting scheduler\n");
 
-    mpuQueue = xQueueCreate(8, sizeof(mpu6050_raw_t));
-    if (mpuQueue == NULL) {
-        printf("Queue create failed\n");
-        for (;;) {
-        }
-    }
+    (void)spsc_init(&imu_ring, imu_ring_buf, sizeof(imu_ring_buf[0]), IMU_RING_LEN);
 
     xTaskCreate(TelemetryTask, "MPU_TX",   256, NULL, 3, NULL);
-    xTaskCreate(EventTask,     "EVENTS",   256, NULL, 2, NULL);
-    xTaskCreate(DisplayTask,   "DISPLAY",  256, NULL, 1, NULL);
+    xTaskCreate(EventTask,     "EVENTS",   256, NULL, 2, &eventTask);
+    xTaskCreate(DisplayTask,   "DISPLAY",  256, NULL, 1, &displayTask);
     xTaskCreate(ButtonTask,    "BUTTON",   128, NULL, 1, NULL);
+    // só a task de log formata e escreve na serial; as outras enfileiram
+    log_task_start(1);
 
     vTaskStartScheduler();
 
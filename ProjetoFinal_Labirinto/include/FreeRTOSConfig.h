@@ -33,6 +33,7 @@
  * ---------------------------------------------------------- */
 #define configUSE_MUTEXES                            1
 #define configUSE_TASK_NOTIFICATIONS                 1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES        2   /* [1] = fim de transação I2C */
 #define configUSE_TIMERS                             1
 #define configTIMER_TASK_PRIORITY                    (configMAX_PRIORITIES - 1)
 #define configTIMER_QUEUE_LENGTH                     10
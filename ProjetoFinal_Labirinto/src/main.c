@@ -18,8 +18,16 @@
 #include <math.h>
 
 #include "serial_stdio.h"
+#include "dlog.h"
+#include "log_task.h"
+#include "fmt.h"
+#include "st7789_prof.h"
 #include "mpu6050.h"
+#include "mpu6050_cal.h"
+#include "ahrs.h"
+#include "drv_time.h"
 #include "st7789.h"
+#include "rgb565_blend.h"
 #include "delay_rtos.h"
 
 #include "FreeRTOS.h"
@@ -136,7 +144,7 @@ static ClockTime system_clock = {0, 0, 0};
 static volatile uint8_t clock_updated = 0;
 
 /* REQUISITO: Objetos de Sincronização */
-static QueueHandle_t imu_queue = NULL;           // Queue para dados IMU
+static QueueHandle_t imu_queue = NULL;           // Queue para dados IMU (imu_msg_t)
 static SemaphoreHandle_t display_mutex = NULL;   // Mutex para acesso ao display
 static SemaphoreHandle_t game_state_sem = NULL;  // Semáforo binário para estado do jogo
 static TimerHandle_t clock_timer = NULL;         // Software timer para relógio
@@ -144,7 +152,17 @@ static TimerHandle_t clock_timer = NULL;         // Software timer para relógio
 static volatile uint8_t button_pressed = 0;
 static uint8_t button_prev = 0;
 
-// Offsets de calibração do MPU6050
+// Calibração do MPU6050 (viés/escala/temperatura) aplicada na IMU_Task
+static mpu6050_cal_t imu_cal;
+// Fusão giro+accel: a lógica recebe a gravidade estimada, não o accel cru
+static ahrs_t imu_ahrs;
+
+/* Mensagem IMU -> lógica: gravidade (em g, eixos do sensor) e o instante */
+typedef struct {
+    float    grav[3];
+    uint64_t t_cyc;
+} imu_msg_t;
+// Referência de "nivelado" (amostra corrigida com a placa parada na partida)
 static int16_t accel_offset_x = 0;
 static int16_t accel_offset_y = 0;
 
@@ -324,17 +342,19 @@ static void vClockTimerCallback(TimerHandle_t xTimer) {
 
 static void render_map_selector(void) {
     st7789_fill_screen_dma(COLOR_BLACK);
-    st7789_draw_text_5x7(60, 40, "SELECT MAP", COLOR_WHITE, 2, 0, 0);
+    st7789_draw_text_5x7_aa(60, 40, "SELECT MAP", COLOR_WHITE, 2, COLOR_BLACK);
     
     char buf[32];
-    snprintf(buf, sizeof(buf), "< %s >", map_names[selected_map_idx]);
+    fmt_t w;
+    fmt_init(&w, buf, sizeof(buf));
+    FMT(&w, "< ", map_names[selected_map_idx], " >");
     
     // Centralizar texto (aprox)
     int len = strlen(buf);
     int x = (240 - (len * 12)) / 2; // 12px por char (escala 2)
     if (x < 0) x = 0;
     
-    st7789_draw_text_5x7(x, 100, buf, COLOR_YELLOW, 2, 0, 0);
+    st7789_draw_text_5x7_aa(x, 100, buf, COLOR_YELLOW, 2, COLOR_BLACK);
     
     st7789_draw_text_5x7(80, 160, "Tilt DOWN", COLOR_CYAN, 1, 0, 0);
     st7789_draw_text_5x7(80, 175, "to confirm", COLOR_CYAN, 1, 0, 0);
@@ -342,9 +362,11 @@ static void render_map_selector(void) {
 
 static void render_clock(void) {
     char buf[16];
-    snprintf(buf, sizeof(buf), "%02d:%02d:%02d", 
-             system_clock.hours, system_clock.minutes, system_clock.seconds);
-    st7789_draw_text_5x7(5, 12, buf, COLOR_YELLOW, 1, 1, COLOR_BLACK);
+    fmt_t w;
+    fmt_init(&w, buf, sizeof(buf));
+    FMT(&w, FMT_I(system_clock.hours, 2, '0'), ":", FMT_I(system_clock.minutes, 2, '0'), ":",
+        FMT_I(system_clock.seconds, 2, '0'));
+    st7789_draw_text_5x7_aa(5, 12, buf, COLOR_YELLOW, 1, COLOR_BLACK);
 }
 
 static void render_maze(void) {
@@ -371,36 +393,38 @@ static void render_ball(void) {
     int x = (int)ball.x;
     int y = (int)ball.y;
     
-    // Desenhar círculo simples (quadrado por enquanto)
-    st7789_fill_rect_dma(x - BALL_RADIUS, y - BALL_RADIUS, 
-                         BALL_RADIUS * 2, BALL_RADIUS * 2, COLOR_RED);
+    // Círculo anti-aliased sobre o caminho (branco)
+    st7789_fill_circle_aa(x, y, BALL_RADIUS, COLOR_RED, COLOR_WHITE);
 }
 
 static void render_hud(void) {
     char buf[32];
+    fmt_t w;
     
     // Relógio (REQUISITO: hh:mm:ss)
     render_clock();
     
-    // Vidas
-    snprintf(buf, sizeof(buf), "LIVES:%d", lives);
-    st7789_draw_text_5x7(90, 12, buf, COLOR_WHITE, 1, 1, COLOR_BLACK);
+    // Vidas (10 Hz: fmt.h em vez de snprintf)
+    fmt_init(&w, buf, sizeof(buf));
+    FMT(&w, "LIVES:", lives);
+    st7789_draw_text_5x7_aa(90, 12, buf, COLOR_WHITE, 1, COLOR_BLACK);
     
     // Tempo do jogo
     uint32_t sec = game_time_ms / 1000;
     uint32_t ms = game_time_ms % 1000;
-    snprintf(buf, sizeof(buf), "T:%02lu.%03lu", (unsigned long)sec, (unsigned long)ms);
-    st7789_draw_text_5x7(165, 12, buf, COLOR_CYAN, 1, 1, COLOR_BLACK);
+    fmt_reset(&w);
+    FMT(&w, "T:", FMT_U(sec, 2, '0'), ".", FMT_U(ms, 3, '0'));
+    st7789_draw_text_5x7_aa(165, 12, buf, COLOR_CYAN, 1, COLOR_BLACK);
 }
 
 static void render_game_over(void) {
     st7789_fill_screen_dma(COLOR_BLACK);
-    st7789_draw_text_5x7(50, 100, "GAME OVER", COLOR_RED, 2, 0, 0);
+    st7789_draw_text_5x7_aa(50, 100, "GAME OVER", COLOR_RED, 2, COLOR_BLACK);
     
     char buf[32];
-    snprintf(buf, sizeof(buf), "TIME: %lu.%03lu s", 
-             (unsigned long)(game_time_ms/1000), 
-             (unsigned long)(game_time_ms%1000));
+    fmt_t w;
+    fmt_init(&w, buf, sizeof(buf));
+    FMT(&w, "TIME: ", FMT_UFIX(game_time_ms, 3), " s");
     st7789_draw_text_5x7(40, 130, buf, COLOR_WHITE, 1, 0, 0);
     
     st7789_draw_text_5x7(30, 160, "Press button to restart", COLOR_YELLOW, 1, 0, 0);
@@ -408,18 +432,17 @@ static void render_game_over(void) {
 
 static void render_win(void) {
     st7789_fill_screen_dma(COLOR_BLACK);
-    st7789_draw_text_5x7(60, 90, "YOU WIN!", COLOR_GREEN, 2, 0, 0);
+    st7789_draw_text_5x7_aa(60, 90, "YOU WIN!", COLOR_GREEN, 2, COLOR_BLACK);
     
     char buf[32];
-    snprintf(buf, sizeof(buf), "TIME: %lu.%03lu s", 
-             (unsigned long)(game_time_ms/1000), 
-             (unsigned long)(game_time_ms%1000));
+    fmt_t w;
+    fmt_init(&w, buf, sizeof(buf));
+    FMT(&w, "TIME: ", FMT_UFIX(game_time_ms, 3), " s");
     st7789_draw_text_5x7(40, 120, buf, COLOR_WHITE, 1, 0, 0);
     
     if (best_time_ms != 0xFFFFFFFF) {
-        snprintf(buf, sizeof(buf), "BEST: %lu.%03lu s", 
-                 (unsigned long)(best_time_ms/1000), 
-                 (unsigned long)(best_time_ms%1000));
+        fmt_reset(&w);
+        FMT(&w, "BEST: ", FMT_UFIX(best_time_ms, 3), " s");
         st7789_draw_text_5x7(40, 135, buf, COLOR_YELLOW, 1, 0, 0);
     }
     
@@ -441,54 +464,123 @@ static uint8_t button_read(void) {
 
 /* ==== Tasks FreeRTOS - REQUISITO: Mínimo 3 tarefas ==== */
 
-/* Task 1: Leitura do IMU (30Hz) - REQUISITO: Temporização determinística */
+/* Corrige a amostra e passa no AHRS; a primeira só posiciona o quatérnio.
+   O viés do giro da calibração de partida é seguido em janelas de ~0,5 s
+   com a placa parada (só o giro: inclinar a placa é o jogo). */
+static void imu_fuse(mpu6050_raw_t *s, float dt) {
+    static uint8_t seeded = 0;
+    static mpu6050_bias_t bias;
+    if (!seeded) mpu6050_bias_init(&bias, &imu_cal, (uint16_t)(mpu6050_get_rate() / 2u));
+    mpu6050_bias_add(&bias, &imu_cal, s);
+    mpu6050_cal_apply(&imu_cal, s);
+    if (!seeded) {
+        ahrs_reset_to_accel(&imu_ahrs, s->ax, s->ay, s->az);
+        seeded = 1;
+        return;
+    }
+    ahrs_update_raw(&imu_ahrs, s, dt);
+}
+
+static void imu_publish(uint64_t t_cyc) {
+    imu_msg_t m;
+    ahrs_gravity(&imu_ahrs, &m.grav[0], &m.grav[1], &m.grav[2]);
+    m.t_cyc = t_cyc;
+    // REQUISITO: Usar Queue para sincronização
+    xQueueSend(imu_queue, &m, 0);
+}
+
+#ifdef IMU_DRDY
+/* Task 1 (variante -DIMU_DRDY): o próprio sensor dá o ritmo. A cada
+   DATA_RDY (INT em PB5) o ISR marca o instante e acorda esta task, que lê
+   a amostra na hora: latência de entrada = tempo da leitura I2C. */
+static void IMU_Task(void *arg) {
+    (void)arg;
+    mpu6050_sample_t imu_data;
+    uint64_t last_t = 0;
+
+    mpu6050_set_rate(30, 3);                 // 1000/33 = 30.3 Hz, mesmo ritmo da lógica
+    ahrs_init_mahony(&imu_ahrs, 1.0f, 0.02f);
+    mpu6050_drdy_init(xTaskGetCurrentTaskHandle());
+
+    for (;;) {
+        if (!mpu6050_drdy_wait(100, &imu_data.t_cyc)) {
+            LOG_W("[IMU] sem DATA_RDY (INT ligado em PB5?)\n");
+            continue;
+        }
+        if (mpu6050_read_all(&imu_data.raw) == 0) {
+            imu_fuse(&imu_data.raw, last_t ? drv_cyc_to_s(imu_data.t_cyc - last_t) : 0.0f);
+            last_t = imu_data.t_cyc;
+            imu_publish(imu_data.t_cyc);
+        } else {
+            const i2c1_stats_t *st = i2c1_get_stats();
+            LOG_E("[I2C] falha: nack=%lu arlo=%lu berr=%lu timeout=%lu recover=%lu\n",
+                  (unsigned long)st->nack, (unsigned long)st->arlo, (unsigned long)st->berr,
+                  (unsigned long)st->timeout, (unsigned long)st->recover);
+        }
+    }
+}
+#else
+/* Task 1: Leitura do IMU (30Hz) - REQUISITO: Temporização determinística
+   O sensor amostra a 1 kHz na FIFO; a cada período a task drena o bloco
+   (~33 amostras igualmente espaçadas), roda o AHRS em todas e envia a
+   atitude da mais recente. */
 static void IMU_Task(void *arg) {
     (void)arg;
-    mpu6050_raw_t imu_data;
+    static mpu6050_raw_t block[48];
     TickType_t xLastWakeTime;
     const TickType_t xPeriod = pdMS_TO_TICKS(33); // ~30Hz
+    const float dt = 1000.0f / (float)mpu6050_get_rate_mhz();   // taxa real do divisor
     
+    ahrs_init_mahony(&imu_ahrs, 1.0f, 0.02f);
+    mpu6050_fifo_start();
     xLastWakeTime = xTaskGetTickCount();
     
     for (;;) {
-        if (mpu6050_read_all(&imu_data) == 0) {
-            // REQUISITO: Usar Queue para sincronização
-            xQueueSend(imu_queue, &imu_data, 0);
+        int n = mpu6050_fifo_read(block, sizeof(block) / sizeof(block[0]));
+        if (n > 0) {
+            // fusão na taxa cheia do sensor (1 kHz)
+            for (int i = 0; i < n; i++) {
+                imu_fuse(&block[i], dt);
+            }
+            imu_publish(mpu6050_fifo_sample_time((uint32_t)n - 1u));
+        } else if (n < 0) {
+            const i2c1_stats_t *st = i2c1_get_stats();
+            LOG_E("[I2C] falha: nack=%lu arlo=%lu berr=%lu timeout=%lu recover=%lu\n",
+                  (unsigned long)st->nack, (unsigned long)st->arlo, (unsigned long)st->berr,
+                  (unsigned long)st->timeout, (unsigned long)st->recover);
         }
         
         // REQUISITO: Temporização determinística com vTaskDelayUntil
         vTaskDelayUntil(&xLastWakeTime, xPeriod);
     }
 }
+#endif
 
 /* Task 2: Lógica do Jogo (30Hz) - REQUISITO: Máquina de Estados */
 static void GameLogic_Task(void *arg) {
     (void)arg;
-    mpu6050_raw_t imu_data;
+    imu_msg_t imu_data;
     TickType_t xLastWakeTime;
     const TickType_t xPeriod = pdMS_TO_TICKS(33); // ~30Hz
-    TickType_t last_physics_time;
+    uint64_t last_sample_t = 0;    // carimbo da última amostra integrada
     uint32_t start_ticks = 0;
     
     xLastWakeTime = xTaskGetTickCount();
-    last_physics_time = xLastWakeTime;
     
     for (;;) {
         TickType_t now = xTaskGetTickCount();
-        float dt = (float)(now - last_physics_time) / configTICK_RATE_HZ;
-        last_physics_time = now;
         
         /* REQUISITO: Máquina de Estados */
         switch (game_state) {
             case GAME_INIT:
-                printf("[STATE] INIT -> SELECT_MAP\n");
+                DLOG("[STATE] INIT -> SELECT_MAP\n");
                 game_state = GAME_SELECT_MAP;
                 break;
 
             case GAME_SELECT_MAP:
                 if (xQueueReceive(imu_queue, &imu_data, 0) == pdPASS) {
-                    float tilt_x = (float)(imu_data.ax - accel_offset_x);
-                    float tilt_y = (float)(imu_data.ay - accel_offset_y);
+                    float tilt_x = (imu_data.grav[0] * MPU6050_CAL_ONE_G - accel_offset_x);
+                    float tilt_y = (imu_data.grav[1] * MPU6050_CAL_ONE_G - accel_offset_y);
                     
                     // Screen X = -tilt_y (Direita/Esquerda)
                     // Screen Y = -tilt_x (Cima/Baixo)
@@ -502,17 +594,17 @@ static void GameLogic_Task(void *arg) {
                         if (screen_x > 4000) { // Direita
                             selected_map_idx = (selected_map_idx + 1) % 3;
                             last_move_time = now;
-                            printf("[MENU] Map: %d\n", selected_map_idx);
+                            DLOG("[MENU] Map: %d\n", selected_map_idx);
                         } else if (screen_x < -4000) { // Esquerda
                             selected_map_idx = (selected_map_idx + 2) % 3; // -1
                             last_move_time = now;
-                            printf("[MENU] Map: %d\n", selected_map_idx);
+                            DLOG("[MENU] Map: %d\n", selected_map_idx);
                         }
                     }
                     
                     // Confirmação (Baixo)
                     if (screen_y > 5000) { // Baixo
-                         printf("[STATE] SELECT_MAP -> READY (Map %d)\n", selected_map_idx);
+                         DLOG("[STATE] SELECT_MAP -> READY (Map %d)\n", selected_map_idx);
                          maze_init();
                          ball_init();
                          lives = MAX_LIVES;
@@ -523,7 +615,7 @@ static void GameLogic_Task(void *arg) {
                 break;
                 
             case GAME_READY:
-                printf("[STATE] READY -> PLAYING\n");
+                DLOG("[STATE] READY -> PLAYING\n");
                 start_ticks = xTaskGetTickCount();
                 game_state = GAME_PLAYING;
                 // REQUISITO: Sinalizar com semáforo
@@ -540,8 +632,8 @@ static void GameLogic_Task(void *arg) {
                     // Mapeamento: X do MPU -> X do Display (Horizontal)
                     //             Y do MPU -> Y do Display (Vertical)
                     // Subtraindo offsets de calibração
-                    float tilt_x = (float)(imu_data.ax - accel_offset_x);
-                    float tilt_y = (float)(imu_data.ay - accel_offset_y);
+                    float tilt_x = (imu_data.grav[0] * MPU6050_CAL_ONE_G - accel_offset_x);
+                    float tilt_y = (imu_data.grav[1] * MPU6050_CAL_ONE_G - accel_offset_y);
                     
                     // Mapeamento corrigido conforme log:
                     // "Virar pra baixo" gerou AX negativo (-14000).
@@ -549,6 +641,12 @@ static void GameLogic_Task(void *arg) {
                     // Assumindo rotação de 90 graus: Display X = Sensor Y.
                     // Invertendo X (Direita/Esquerda) conforme solicitado.
                     
+                    // dt = intervalo real entre as amostras (carimbos do CYCCNT),
+                    // limitado para a volta de pausa/vida perdida
+                    float dt = last_sample_t ? drv_cyc_to_s(imu_data.t_cyc - last_sample_t) : 0.0f;
+                    if (dt > 0.1f) dt = 0.1f;
+                    last_sample_t = imu_data.t_cyc;
+
                     ball_update_physics(dt, -tilt_y, -tilt_x);
 
                     // DEBUG: Imprimir valores do MPU a cada ~1 segundo (50 ciclos de 20ms)
@@ -561,25 +659,25 @@ static void GameLogic_Task(void *arg) {
                 // Verificar queda em buraco
                 if (ball_check_hole()) {
                     lives--;
-                    printf("[EVENT] Fell in hole! Lives: %d\n", lives);
+                    DLOG("[EVENT] Fell in hole! Lives: %d\n", lives);
                     
                     if (lives > 0) {
-                        printf("[STATE] PLAYING -> LOST_LIFE\n");
+                        DLOG("[STATE] PLAYING -> LOST_LIFE\n");
                         game_state = GAME_LOST_LIFE;
                     } else {
-                        printf("[STATE] PLAYING -> GAME_OVER\n");
+                        DLOG("[STATE] PLAYING -> GAME_OVER\n");
                         game_state = GAME_OVER;
                     }
                 }
                 
                 // Verificar chegada ao objetivo
                 if (ball_check_goal()) {
-                    printf("[STATE] PLAYING -> GAME_WON\n");
+                    DLOG("[STATE] PLAYING -> GAME_WON\n");
                     game_state = GAME_WON;
                     if (game_time_ms < best_time_ms) {
                         best_time_ms = game_time_ms;
                     }
-                    printf("[EVENT] You Won! Time: %lu ms\n", (unsigned long)game_time_ms);
+                    DLOG("[EVENT] You Won! Time: %lu ms\n", (unsigned long)game_time_ms);
                 }
                 break;
                 
@@ -587,7 +685,7 @@ static void GameLogic_Task(void *arg) {
                 // Resetar posição da bola
                 ball_init();
                 vTaskDelay(pdMS_TO_TICKS(1000)); // Pausa de 1 segundo
-                printf("[STATE] LOST_LIFE -> PLAYING\n");
+                DLOG("[STATE] LOST_LIFE -> PLAYING\n");
                 game_state = GAME_PLAYING;
                 break;
                 
@@ -601,8 +699,14 @@ static void GameLogic_Task(void *arg) {
                 // Aguardar botão para reiniciar
                 if (button_pressed) {
                     button_pressed = 0;
-                    printf("[STATE] %s -> INIT\n", 
+                    DLOG("[STATE] %s -> INIT\n", 
                            game_state == GAME_WON ? "GAME_WON" : "GAME_OVER");
+#ifdef DLOG_BINARY
+                    const dlog_stats_t *ds = dlog_get_stats();
+                    DLOG("[DLOG] quadros=%lu descartados=%lu custo=%lu ciclos (max %lu)\n",
+                         (unsigned long)ds->frames, (unsigned long)ds->dropped,
+                         (unsigned long)ds->cyc_last, (unsigned long)ds->cyc_max);
+#endif
                     game_state = GAME_INIT;
                 }
                 break;
@@ -637,6 +741,8 @@ static void Display_Task(void *arg) {
             last_drawn_state = game_state;
             last_drawn_map_idx = selected_map_idx;
 
+            st7789_prof_frame_begin();
+
             switch (game_state) {
                 case GAME_SELECT_MAP:
                     if (state_changed || map_changed) {
@@ -667,6 +773,18 @@ static void Display_Task(void *arg) {
                 default:
                     break;
             }
+
+            st7789_prof_frame_end();
+#ifdef ST7789_PROFILE
+            // 'p' na serial imprime o resumo; 'o' liga/desliga o overlay
+            static int prof_overlay = 1;
+            if (serial_readable()) {
+                int c = serial_getc_blocking();
+                if (c == 'p') st7789_prof_print();
+                if (c == 'o') prof_overlay = !prof_overlay;
+            }
+            if (prof_overlay) st7789_prof_draw_overlay(ST7789_PROF_BOTTOM_RIGHT);
+#endif
             
             xSemaphoreGive(display_mutex);
         }
@@ -690,7 +808,7 @@ static void Button_Task(void *arg) {
         // Detecção de borda de subida (botão pressionado)
         if (button_curr && !button_prev) {
             button_pressed = 1;
-            printf("[INPUT] Button pressed\n");
+            DLOG("[INPUT] Button pressed\n");
         }
         
         button_prev = button_curr;
@@ -737,23 +855,30 @@ static void calibrate_mpu(void) {
     
     delay_ms(1000); // Espera estabilizar
     
-    int32_t sum_x = 0;
-    int32_t sum_y = 0;
+    mpu6050_cal_avg_t acc = {0};
     const int samples = 50;
     mpu6050_raw_t raw;
     
     for (int i = 0; i < samples; i++) {
         if (mpu6050_read_all(&raw) == 0) {
-            sum_x += raw.ax;
-            sum_y += raw.ay;
+            mpu6050_cal_avg_add(&acc, &raw);
         }
         delay_ms(20);
     }
     
-    accel_offset_x = (int16_t)(sum_x / samples);
-    accel_offset_y = (int16_t)(sum_y / samples);
+    // Parada: viés do giro e temperatura de referência; accel sem 6 posições
+    // fica com escala 1 e o nivelamento abaixo absorve o offset de X/Y
+    mpu6050_cal_identity(&imu_cal);
+    if (mpu6050_cal_avg_get(&acc, &raw) == 0) {
+        mpu6050_cal_set_still(&imu_cal, &raw);
+        mpu6050_cal_apply(&imu_cal, &raw);
+        accel_offset_x = raw.ax;
+        accel_offset_y = raw.ay;
+    }
     
     printf("[CALIB] Offsets definidos: X=%d, Y=%d\n", accel_offset_x, accel_offset_y);
+    printf("[CALIB] Giro: %d %d %d  T_raw=%d\n", imu_cal.off[3], imu_cal.off[4], imu_cal.off[5],
+           imu_cal.t_ref);
     
     st7789_fill_screen_dma(COLOR_GREEN);
     st7789_draw_text_5x7(60, 110, "OK!", COLOR_BLACK, 3, 0, 0);
@@ -769,6 +894,9 @@ int main(void) {
     button_init();
     
     serial_stdio_init(115200);
+#ifdef DLOG_BINARY
+    serial_tx_async_init(SERIAL_TX_DROP);   // quadro do DLOG entra inteiro no anel
+#endif
     printf("\n╔════════════════════════════════════════╗\n");
     printf("║  SIMULADOR DIGITAL DE LABIRINTO       ║\n");
     printf("║  Equipe: Alfons, Mateus, Guilherme    ║\n");
@@ -781,9 +909,19 @@ int main(void) {
     delay_ms(100);
     st7789_set_speed_div(2);
     printf("[OK] Display ST7789 inicializado\n");
+
+#ifdef RGB565_BLEND_BENCH
+    rgb565_blend_bench();   // ciclos/pixel do blending (referência vs. kernels)
+#endif
+#ifdef AHRS_BENCH
+    ahrs_bench();           // ciclos por update do Mahony/Madgwick
+#endif
+#ifdef FMT_BENCH
+    fmt_bench();            // ciclos por linha: snprintf vs. fmt.h (telemetria, HUD)
+#endif
     
     // Inicializar I2C e MPU6050
-    i2c1_init_100k(50000000u);
+    i2c1_init(50000000u, 400000u);   // fast mode (DUTY 16:9, CCR=5)
 
     // --- DIAGNÓSTICO I2C ---
     printf("Procurando MPU6050...\n");
@@ -797,7 +935,9 @@ int main(void) {
     else               printf(" > Falha em 0x69\n");
     // -----------------------
 
-    if (mpu6050_init() < 0) {
+    // endereço decidido aqui: 0x68, ou 0x69 se só ele respondeu (AD0 = VCC)
+    uint8_t imu_addr = (found_68 != 0 && found_69 == 0) ? 0x69u : 0x68u;
+    if (mpu6050_dev_init(&mpu6050_main, imu_addr) < 0) {
         printf("[ERRO] MPU6050 não detectado!\n");
         st7789_fill_screen_dma(COLOR_RED);
         st7789_draw_text_5x7(20, 100, "MPU6050 ERROR", COLOR_WHITE, 2, 0, 0);
@@ -805,10 +945,16 @@ int main(void) {
             delay_ms(500);
         }
     }
-    printf("[OK] MPU6050 inicializado\n");
+    printf("[OK] MPU6050 inicializado em 0x%02X\n", imu_addr);
+
+    // I2C por interrupção: IMU_Task dorme durante a leitura de 14 bytes
+    i2c1_async_init();
     
     // Calibrar MPU6050
     calibrate_mpu();
+
+    // 1 kHz com DLPF 44 Hz; IMU_Task drena a FIFO em blocos
+    mpu6050_set_rate(1000, 3);
     
     // Mensagem inicial
     st7789_fill_screen_dma(COLOR_BLACK);
@@ -820,7 +966,7 @@ int main(void) {
     printf("\n[INIT] Criando objetos de sincronização...\n");
     
     // REQUISITO: Queue para comunicação IMU -> GameLogic
-    imu_queue = xQueueCreate(10, sizeof(mpu6050_raw_t));
+    imu_queue = xQueueCreate(10, sizeof(imu_msg_t));
     if (imu_queue == NULL) {
         printf("[ERRO] Falha ao criar IMU Queue\n");
         for (;;) {}
@@ -906,6 +1052,13 @@ int main(void) {
         for (;;) {}
     }
     printf("[OK] Task ClockDisplay criada (Pri:1, 1Hz)\n");
+
+    // Task 6: Log (Prioridade 1): só ela formata e escreve na serial
+    if (log_task_start(1) < 0) {
+        printf("[ERRO] Falha ao criar Log_Task\n");
+        for (;;) {}
+    }
+    printf("[OK] Task Log criada (Pri:1, %ums)\n", (unsigned)LOG_TASK_PERIOD_MS);
     
     
     printf("\n[START] Iniciando scheduler FreeRTOS...\n");
@@ -0,0 +1,539 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "st7789.h"
+#include "mpu6050.h"
+#include "mpu6050_dual.h"
+#include "mpu6050_dmp.h"
+#include "mpu6050_cal.h"
+#include "serial_stdio.h"
+#include "rgb565_blend.h"
+#include "drivers_native.h"
+#include "st7789_prof.h"
+#include "drv_time.h"
+#include "ahrs.h"
+#include "filt.h"
+#include "spsc.h"
+#include "log_task.h"
+#include "fmt.h"
+
+#define C_BLACK 0x0000
+#define C_WHITE 0xFFFF
+#define C_RED   0xF800
+#define C_BLUE  0x001F
+#define C_YELL  0xFFE0
+
+/* MPU6050 emulado (drivers_native.h): 0x68 principal, 0x69 para o par. */
+static mpu6050_sim_t imu_sim, imu_sim_b;
+static int falhas;
+
+#define CHECK(cond, ...) do { if (!(cond)) { falhas++; printf("[FALHA] " __VA_ARGS__); printf("\n"); } } while (0)
+
+/* Rampa em X (1 g/s): quadro fora de ordem ou repetido aparece logo. */
+static void rampa(void *ctx, double t, float acc[3], float gyr[3], float *temp){
+    (void)ctx; (void)gyr; (void)temp;
+    acc[0] = (float)t;
+}
+
+/* Trecho gravado da telemetria (contagens de ±2 g / ±250 dps). */
+static const int32_t trilha[4][6] = {
+    {   120,  -40, 16380,   10,  -5,  2 },
+    {  4096,  -40, 16000,  300,  -5,  2 },
+    {  8192,  800, 12000, 1310, 200,  2 },
+    {  -800, -800, 16384,  -10,   0,  0 },
+};
+
+/* Caminho do sensor pelo banco de registros emulado: FIFO (ordem, estouro
+   e ressincronização), custo em bytes, trilha gravada, DATA_RDY e
+   wake-on-motion. */
+static void mpu_sim_checks(void){
+    static mpu6050_raw_t q[MPU6050_FIFO_SIZE / MPU6050_FIFO_FRAME];
+    mpu6050_raw_t s;
+
+    i2c1_init(50000000u, 400000u);
+    mpu6050_set_accel_range(MPU6050_ACCEL_2G);
+    mpu6050_set_rate(1000, 3);
+    mpu6050_sim_set_motion(&imu_sim, rampa, NULL);
+    mpu6050_fifo_start();
+    uint32_t n = mpu6050_sim_run_ms(&imu_sim, 33);
+    uint32_t b0 = imu_sim.stats.bytes_read;
+    uint64_t c0 = drv_cycles64();
+    int got = mpu6050_fifo_read(q, 80);
+    uint64_t c1 = drv_cycles64();
+    uint32_t bytes = imu_sim.stats.bytes_read - b0;
+    int ordem = 1;
+    for (int i = 1; i < got; i++) if (q[i].ax <= q[i - 1].ax) ordem = 0;
+    CHECK(got == (int)n && n == 33u, "fifo %d de %lu quadros", got, (unsigned long)n);
+    CHECK(ordem, "fifo fora de ordem");
+    /* a 400 kHz cada byte custa 9 bits no fio (22.5 us) */
+    uint32_t fio_us = bytes * 45u / 2u;
+    printf("[SIM] fifo %d quadros, %lu B, fio a 400k %lu us (%lu%% de %lu ms), host %llu us\n",
+           got, (unsigned long)bytes, (unsigned long)fio_us,
+           (unsigned long)(fio_us / 10u / (n ? n : 1u)), (unsigned long)n,
+           (unsigned long long)drv_cyc_to_us(c1 - c0));
+
+    /* O mock aplica o timeout pelo tempo no fio: o burst acima passou com
+       o timeout esticado; os mesmos 462 B presos em 5 ms abortam. */
+    static uint8_t longo[462];
+    const i2c1_dev_t curto = { MPU6050_ADDR, I2C1_PRIO_HIGH, DRV_I2C_TIMEOUT_US };
+    uint32_t to = i2c1_get_stats()->timeout;
+    CHECK(i2c1_dev_read(&curto, MPU6050_REG_ACCEL, longo, sizeof(longo)) < 0 &&
+          i2c1_get_stats()->timeout == to + 1u, "burst de %u B sem timeout", (unsigned)sizeof(longo));
+
+    /* 100 ms a 1 kHz = 1400 B > 1024: descarta, zera e volta a alinhar */
+    uint32_t ovf = mpu6050_fifo_get_stats()->overflows;
+    mpu6050_sim_run_ms(&imu_sim, 100);
+    got = mpu6050_fifo_read(q, 80);
+    CHECK(got == 0 && mpu6050_fifo_get_stats()->overflows == ovf + 1u, "estouro não visto (%d)", got);
+    mpu6050_sim_run_ms(&imu_sim, 10);
+    got = mpu6050_fifo_read(q, 80);
+    CHECK(got == 10, "depois do estouro: %d quadros", got);
+    /* 30 Hz pedidos = 1000/33: quadros a 33 ms, não a 1/30 s */
+    mpu6050_set_rate(30, 3);
+    uint64_t per = mpu6050_fifo_sample_time(1) - mpu6050_fifo_sample_time(0);
+    CHECK(mpu6050_get_rate_mhz() == 30303u && per == (uint64_t)SystemCoreClock / 1000u * 33u,
+          "taxa %lu mHz, periodo %llu cyc", (unsigned long)mpu6050_get_rate_mhz(), (unsigned long long)per);
+    mpu6050_set_rate(1000, 3);
+    printf("[SIM] estouro: %lu B sobrescritos, resyncs=%lu, depois %d quadros\n",
+           (unsigned long)imu_sim.stats.fifo_overflows,
+           (unsigned long)mpu6050_fifo_get_stats()->resyncs, got);
+    mpu6050_fifo_stop();
+
+    /* trilha gravada lida a ±8 g: contagens de ±2 g / 4 */
+    mpu6050_set_accel_range(MPU6050_ACCEL_8G);
+    mpu6050_sim_play(&imu_sim, trilha, 4, 1000);
+    mpu6050_sim_advance(&imu_sim, 1);
+    CHECK(mpu6050_read_all(&s) == 0, "leitura da trilha");
+    int ok = 0;
+    for (int i = 0; i < 4; i++) if (s.ax == trilha[i][0] / 4) ok = 1;
+    CHECK(ok, "trilha ax=%d", s.ax);
+    printf("[SIM] trilha a 8 g: ax=%d (base %ld)\n", s.ax, (long)mpu6050_accel_base(s.ax));
+    mpu6050_sim_set_static(&imu_sim, 0, 0, 1, 0, 0, 0);
+    mpu6050_set_accel_range(MPU6050_ACCEL_2G);
+
+    /* DATA_RDY: duas bordas antes da espera -> 1 amostra + 1 perdida */
+    uint64_t t = 0;
+    mpu6050_drdy_init(NULL);
+    mpu6050_sim_advance(&imu_sim, 2);
+    int r = mpu6050_drdy_wait(10, &t);
+    CHECK(r == 1 && mpu6050_drdy_get_stats()->missed == 1u, "drdy %d", r);
+    printf("[MPU] drdy t=%llu us perdidas=%lu timeout=%d\n", (unsigned long long)drv_cyc_to_us(t),
+           (unsigned long)mpu6050_drdy_get_stats()->missed, mpu6050_drdy_wait(1, NULL) == 0);
+    mpu6050_drdy_stop();
+
+    /* wake-on-motion: 1 s parado não acorda, 0.3 g em X acorda */
+    mpu6050_wom_enter(NULL, 100, 1, MPU6050_LP_WAKE_20HZ);
+    uint32_t lp = mpu6050_sim_run_ms(&imu_sim, 1000);
+    int quieto = mpu6050_wom_wait(0);
+    mpu6050_sim_set_static(&imu_sim, 0.3f, 0, 1, 0, 0, 0);
+    mpu6050_sim_run_ms(&imu_sim, 100);
+    int acordou = mpu6050_wom_wait(0);
+    CHECK(quieto == 0 && acordou == 1, "wom %d/%d", quieto, acordou);
+    printf("[SIM] wom %lu amostras em 1 s parado, acordou=%d\n", (unsigned long)lp, acordou);
+    mpu6050_wom_exit();
+    mpu6050_sim_set_static(&imu_sim, 0, 0, 1, 0, 0, 0);
+    mpu6050_sim_advance(&imu_sim, 1);
+}
+
+/* Atitude por amostra nos dois modos, a 200 Hz e 30° de pitch: modo cru
+   (FIFO de 14 B + Mahony no MCU, partindo do nível e ainda convergindo
+   em 2 s) contra DMP (pacote de 28 ou 16 B + só a conversão do Q30).
+   Bytes exatos; ciclos do host (no alvo o Mahony é o do ahrs_bench). A
+   imagem aqui é de mentira: o modelo guarda e confere, mas não executa. */
+static uint8_t dmp_code[3062];
+
+static void dmp_bench(void){
+    static mpu6050_raw_t q[MPU6050_FIFO_SIZE / MPU6050_FIFO_FRAME];
+    static mpu6050_dmp_packet_t pk[MPU6050_FIFO_SIZE / MPU6050_DMP_QUAT];
+    static ahrs_t a;
+    const uint32_t rounds = 20;
+    float roll, pitch;
+
+    mpu6050_sim_set_static(&imu_sim, -0.5f, 0, 0.866f, 0, 0, 0);
+
+    /* cru */
+    ahrs_init_mahony(&a, 1.0f, 0.0f);
+    ahrs_reset_to_accel(&a, 0, 0, 1);
+    mpu6050_set_rate(MPU6050_DMP_RATE_HZ, 2);     /* DLPF 2: dmp_stop tem que devolver */
+    mpu6050_fifo_start();
+    uint32_t b0 = imu_sim.stats.bytes_read, upd = 0;
+    uint64_t cyc = 0;
+    for (uint32_t r = 0; r < rounds; r++){
+        mpu6050_sim_run_ms(&imu_sim, 50);
+        uint64_t t0 = drv_cycles64();
+        int n = mpu6050_fifo_read(q, 80);
+        for (int i = 0; i < n; i++) ahrs_update_raw(&a, &q[i], 1.0f / MPU6050_DMP_RATE_HZ);
+        cyc += drv_cycles64() - t0;
+        upd += (uint32_t)(n > 0 ? n : 0);
+    }
+    mpu6050_fifo_stop();
+    ahrs_tilt(&a, &roll, &pitch);
+    printf("[DMP] cru   %3lu atualizacoes, %2lu B/atualizacao, %5lu cyc/atualizacao, pitch %.1f\n",
+           (unsigned long)upd, (unsigned long)((imu_sim.stats.bytes_read - b0) / (upd ? upd : 1u)),
+           (unsigned long)(cyc / (upd ? upd : 1u)), pitch * 57.2958f);
+
+    /* DMP, pacote longo e só quatérnio */
+    for (uint32_t i = 0; i < sizeof(dmp_code); i++) dmp_code[i] = (uint8_t)(i * 7u + 3u);
+    static const uint8_t patch_rate[2] = { 0x00, 0x00 };
+    const mpu6050_dmp_patch_t patch[1] = { { 0x0216, 2, patch_rate } };
+    for (int k = 0; k < 2; k++){
+        uint8_t len = k ? MPU6050_DMP_QUAT : MPU6050_DMP_QUAT_RAW;
+        const mpu6050_dmp_image_t img = { dmp_code, sizeof(dmp_code), 0x0400, len, 1, patch };
+        imu_sim.dmp_packet_len = len;
+        CHECK(mpu6050_dmp_load(&img) == 0 && mpu6050_dmp_start() == 0, "dmp load/start");
+        mpu6050_dmp_read(pk, 0);                     /* descarta o que sobrou */
+        const mpu6050_dmp_stats_t *st = mpu6050_dmp_get_stats();
+        uint32_t by = st->bytes, p0 = st->packets;
+        cyc = 0;
+        for (uint32_t r = 0; r < rounds; r++){
+            mpu6050_sim_run_ms(&imu_sim, 50);
+            uint64_t t0 = drv_cycles64();
+            int n = mpu6050_dmp_read(pk, 80);
+            for (int i = 0; i < n; i++) mpu6050_dmp_to_ahrs(&pk[i], &a);
+            cyc += drv_cycles64() - t0;
+        }
+        upd = st->packets - p0;
+        ahrs_tilt(&a, &roll, &pitch);
+        CHECK(upd == rounds * 10u && pitch * 57.2958f > 29.5f && pitch * 57.2958f < 30.5f,
+              "dmp %lu pacotes, pitch %.2f", (unsigned long)upd, pitch * 57.2958f);
+        printf("[DMP] dmp%-2u %3lu atualizacoes, %2lu B/atualizacao, %5lu cyc/atualizacao, pitch %.1f\n",
+               len, (unsigned long)upd, (unsigned long)((st->bytes - by) / (upd ? upd : 1u)),
+               (unsigned long)(cyc / (upd ? upd : 1u)), pitch * 57.2958f);
+        CHECK(mpu6050_dmp_stop() == 0 && mpu6050_scale.fs == MPU6050_GYRO_250DPS &&
+              mpu6050_get_dlpf() == 2u && mpu6050_get_rate() == MPU6050_DMP_RATE_HZ, "dmp stop");
+    }
+    mpu6050_sim_set_static(&imu_sim, 0, 0, 1, 0, 0, 0);
+    mpu6050_sim_advance(&imu_sim, 1);
+}
+
+/* Viés online: calibra com 0.5 °/s de viés em X, o viés sobe para 0.8 °/s
+   (placa esquentando) e o estimador segue com a placa parada; girando a
+   30 °/s as janelas são descartadas. */
+static void bias_check(void){
+    static mpu6050_raw_t q[MPU6050_FIFO_SIZE / MPU6050_FIFO_FRAME];
+    static mpu6050_cal_t cal;
+    static mpu6050_bias_t bias;
+    mpu6050_cal_avg_t avg = {0};
+    mpu6050_raw_t mean;
+
+    mpu6050_sim_set_noise(&imu_sim, 8, 1234);
+    mpu6050_sim_set_static(&imu_sim, 0, 0, 1, 0.5f, 0, 0);
+    mpu6050_set_rate(1000, 3);
+    mpu6050_fifo_start();
+    mpu6050_sim_run_ms(&imu_sim, 50);
+    int n = mpu6050_fifo_read(q, 80);
+    for (int i = 0; i < n; i++) mpu6050_cal_avg_add(&avg, &q[i]);
+    mpu6050_cal_identity(&cal);
+    mpu6050_cal_avg_get(&avg, &mean);
+    mpu6050_cal_set_still(&cal, &mean);
+    int16_t boot = cal.off[3];
+
+    mpu6050_bias_init(&bias, &cal, 500);
+    bias.track_acc = 1;
+    mpu6050_sim_set_static(&imu_sim, 0.01f, 0, 1, 0.8f, 0, 0);
+    uint64_t cyc = 0;
+    uint32_t amostras = 0;
+    for (int r = 0; r < 12000 / 30; r++){
+        mpu6050_sim_run_ms(&imu_sim, 30);
+        n = mpu6050_fifo_read(q, 80);
+        uint64_t t0 = drv_cycles64();
+        for (int i = 0; i < n; i++) mpu6050_bias_add(&bias, &cal, &q[i]);
+        cyc += drv_cycles64() - t0;
+        amostras += (uint32_t)(n > 0 ? n : 0);
+    }
+    uint32_t still = bias.still;
+    mpu6050_sim_set_static(&imu_sim, 0, 0, 1, 30.0f, 0, 0);
+    for (int r = 0; r < 1000 / 30; r++){
+        mpu6050_sim_run_ms(&imu_sim, 30);
+        n = mpu6050_fifo_read(q, 80);
+        for (int i = 0; i < n; i++) mpu6050_bias_add(&bias, &cal, &q[i]);
+    }
+    mpu6050_fifo_stop();
+    CHECK(cal.off[3] > 100 && cal.off[3] < 110 && bias.still == still && cal.off[0] > 150,
+          "bias gx %d (boot %d) parado %lu/%lu ax %d", cal.off[3], boot,
+          (unsigned long)bias.still, (unsigned long)bias.windows, cal.off[0]);
+    printf("[BIAS] gx %d -> %d LSB (0.8 dps = 105), ax %d, janelas %lu paradas %lu, %lu cyc/amostra\n",
+           boot, cal.off[3], cal.off[0], (unsigned long)bias.windows, (unsigned long)bias.still,
+           (unsigned long)(cyc / (amostras ? amostras : 1u)));
+    mpu6050_sim_set_noise(&imu_sim, 0, 0);
+    mpu6050_sim_set_static(&imu_sim, 0, 0, 1, 0, 0, 0);
+    mpu6050_sim_advance(&imu_sim, 1);
+}
+
+/* fmt.h contra o snprintf: extremos de 32/64 bits, largura com sinal,
+   ponto fixo, hexa e corte no fim do buffer. */
+static void fmt_check(void){
+    char a[96], b[96];
+    fmt_t w;
+
+    fmt_init(&w, b, sizeof(b));
+    FMT(&w, INT32_MIN, " ", UINT32_MAX, " ", (long long)INT64_MIN, " ", FMT_I(-7, 5, '0'), "|",
+        FMT_I(-7, 5, ' '), "|", FMT_U(0, 3, '0'), "|", FMT_HEX(0xCAFEu, 8));
+    snprintf(a, sizeof(a), "%ld %lu %lld %05d|%5d|%03u|%08X", (long)INT32_MIN, (unsigned long)UINT32_MAX,
+             (long long)INT64_MIN, -7, -7, 0u, 0xCAFEu);
+    CHECK(strcmp(a, b) == 0 && fmt_len(&w) == strlen(a) && !w.truncated, "fmt: '%s' != '%s'", b, a);
+
+    fmt_init(&w, b, sizeof(b));
+    FMT(&w, 18446744073709551615ull, " ", FMT_UFIX(83071u, 3), " ", FMT_FIX(-5, 2), " ", FMT_UFIX(7u, 0),
+        " ", (uint8_t)200, (char)'!');
+    CHECK(strcmp(b, "18446744073709551615 83.071 -0.05 7 200!") == 0, "fmt: '%s'", b);
+
+    char itoa_buf[12];
+    uint32_t n = fmt_itoa(itoa_buf, -100);
+    CHECK(n == 4 && strcmp(itoa_buf, "-100") == 0, "fmt_itoa: '%s' %lu", itoa_buf, (unsigned long)n);
+
+    fmt_init(&w, b, 8);
+    n = FMT(&w, "LIVES:", 12345);
+    CHECK(n == 7 && w.truncated && strcmp(b, "LIVES:1") == 0, "fmt corte: '%s' %lu", b, (unsigned long)n);
+
+    fmt_bench();
+}
+
+/* Log enfileirado: a linha formatada no consumidor tem que sair igual ao
+   snprintf direto; nível desligado não entra; anel cheio descarta e conta
+   sem bloquear, e o anel dá várias voltas (PAD no fim). */
+static char log_out[8][LOG_LINE_MAX];
+static int log_nout;
+static void log_capture(const char *line){
+    if (log_nout < 8) snprintf(log_out[log_nout], LOG_LINE_MAX, "%s", line);
+    log_nout++;
+}
+
+static void log_check(void){
+    char ref[LOG_LINE_MAX];
+    char tmp[16] = "volatil";
+    log_set_sink(log_capture);
+    log_init();
+
+    LOG_I("[T] %d %u %5ld|%-4s|%c %x %08lX %.2f %s\n", -7, 4000000000u, 123456L, "ab", 'Z',
+          0xBEEFu, 0xCAFEUL, 3.14159, tmp);
+    snprintf(ref, sizeof(ref), "[T] %d %u %5ld|%-4s|%c %x %08lX %.2f %s\n", -7, 4000000000u, 123456L, "ab",
+             'Z', 0xBEEFu, 0xCAFEUL, 3.14159, "volatil");
+    strcpy(tmp, "mudou");                           /* string vai por valor */
+    LOG_W("[T] %*d|%.*s|%hhu %%\n", 6, 42, 3, "abcdef", 300);
+    log_set_level(LOG_WARN);
+    LOG_I("[T] filtrada\n");
+    LOG_D("[T] filtrada\n");
+    log_set_level(LOG_DEBUG);
+    log_nout = 0;
+    log_poll();
+    CHECK(log_nout == 2 && strcmp(log_out[0], ref) == 0, "log: '%s' != '%s'", log_out[0], ref);
+    CHECK(strcmp(log_out[1], "[T]     42|abc|44 %\n") == 0, "log star: '%s'", log_out[1]);
+
+    /* rajada sem consumidor: enche e descarta; depois muitas voltas */
+    const log_stats_t *st = log_get_stats();
+    uint32_t q0 = st->queued;
+    for (int i = 0; i < 200; i++) LOG_I("[T] rajada %d %s\n", i, "xxxxxxxxxxxxxxxxxxxxxxxx");
+    uint32_t aceitos = st->queued - q0, perdidos = st->dropped;
+    log_nout = 0;
+    log_poll();
+    int ok = 1;
+    for (int v = 0; v < 50; v++){
+        for (int i = 0; i < 7; i++) LOG_I("[T] volta %d.%d\n", v, i);
+        log_nout = 0;
+        log_poll();
+        snprintf(ref, sizeof(ref), "[T] volta %d.%d\n", v, 6);
+        if (log_nout != 7 || strcmp(log_out[6], ref) != 0) ok = 0;
+    }
+    CHECK(perdidos > 0 && aceitos + perdidos == 200 && ok && st->filtered == 2,
+          "log: aceitos %lu perdidos %lu voltas %d filtradas %lu", (unsigned long)aceitos,
+          (unsigned long)perdidos, ok, (unsigned long)st->filtered);
+    printf("[LOG] rajada de 200: %lu no anel, %lu descartadas; pico %lu/%u B\n",
+           (unsigned long)aceitos, (unsigned long)perdidos, (unsigned long)st->high_water, LOG_RING_SIZE);
+    log_set_sink(NULL);
+}
+
+/* Sensor com erro conhecido (±2 g / ±250 dps, LSB): offset, ganho do accel
+   e deriva linear com temp_raw a partir de 25 °C. A calibração tem que
+   devolver esses números. */
+static const float cal_off[6]  = { 120, -200, 300, 40, -25, 10 };
+static const float cal_gain[3] = { 1.02f, 0.98f, 1.01f };
+static const float cal_tc[6]   = { 0.05f, -0.03f, 0.02f, 0.10f, -0.08f, 0.04f };
+
+/* Amostra crua com a face 'face' (0..5 = +X -X +Y -Y +Z -Z) para cima a
+   temp_c, mais um ruído de ±1 LSB que a média tem que tirar. */
+static void cal_sample(int face, float temp_c, int i, mpu6050_raw_t *s){
+    float dtr = (temp_c - 25.0f) * 340.0f;
+    int16_t v[6];
+    for (int k = 0; k < 3; k++){
+        float g = (face >> 1) == k ? ((face & 1) ? -1.0f : 1.0f) : 0.0f;
+        v[k]     = (int16_t)(lrintf(g * 16384.0f * cal_gain[k] + cal_off[k] + cal_tc[k] * dtr) + (i % 3) - 1);
+        v[3 + k] = (int16_t)(lrintf(cal_off[3 + k] + cal_tc[3 + k] * dtr) + (i % 3) - 1);
+    }
+    s->ax = v[0]; s->ay = v[1]; s->az = v[2];
+    s->gx = v[3]; s->gy = v[4]; s->gz = v[5];
+    s->temp_raw = (int16_t)lrintf((temp_c - 36.53f) * 340.0f);
+}
+
+static void cal_mean(int face, float temp_c, mpu6050_raw_t *mean){
+    mpu6050_cal_avg_t avg = {0};
+    mpu6050_raw_t s;
+    for (int i = 0; i < 33; i++){
+        cal_sample(face, temp_c, i, &s);
+        mpu6050_cal_avg_add(&avg, &s);
+    }
+    mpu6050_cal_avg_get(&avg, mean);
+}
+
+/* Calibração completa: rampa de temperatura (tc), placa parada (giro e
+   t_ref), 6 faces (offset/escala do accel) e o caminho quente zerando a
+   saída em outra temperatura. */
+static void cal_check(void){
+    static mpu6050_cal_tc_t tc;
+    mpu6050_cal_t cal;
+    mpu6050_cal6_t six;
+    mpu6050_raw_t s;
+
+    memset(&tc, 0, sizeof(tc));
+    memset(&six, 0, sizeof(six));
+    mpu6050_cal_identity(&cal);
+
+    for (int i = 0; i < 200; i++){                     /* +Z, aquecendo 25 -> 45 °C */
+        cal_sample(4, 25.0f + 20.0f * (float)i / 199.0f, 1, &s);
+        mpu6050_cal_tc_add(&tc, &s);
+    }
+    int tc_ok = mpu6050_cal_tc_solve(&tc, &cal, 340) == 0;
+
+    cal_mean(4, 30.0f, &s);
+    mpu6050_cal_set_still(&cal, &s);
+    int faces = 0;
+    for (int f = 0; f < 6; f++){
+        cal_mean(f, 29.0f + (float)f * 0.4f, &s);         /* cada face numa temperatura */
+        if (mpu6050_cal6_add(&six, &s) == f) faces++;
+    }
+    int six_ok = mpu6050_cal6_solve(&six, &cal) == 0;
+
+    /* t_ref = 30 °C: offsets esperados = offset de 25 °C + tc * 5 °C */
+    int err = 0;
+    for (int i = 0; i < 6; i++){
+        int32_t off = (int32_t)lrintf(cal_off[i] + cal_tc[i] * 1700.0f);
+        int32_t tq  = (int32_t)lrintf(cal_tc[i] * 65536.0f);
+        if (abs(cal.off[i] - off) > 2 || abs(cal.tc_q16[i] - tq) > 150) err++;
+        if (i < 3 && abs(cal.scale_q14[i] - (int32_t)lrintf(16384.0f / cal_gain[i])) > 8) err++;
+    }
+    CHECK(tc_ok && six_ok && faces == 6 && err == 0,
+          "cal: tc %d 6pos %d faces %d erros %d off %d/%d/%d/%d/%d/%d esc %d/%d/%d tc %ld/%ld/%ld",
+          tc_ok, six_ok, faces, err, cal.off[0], cal.off[1], cal.off[2], cal.off[3], cal.off[4],
+          cal.off[5], cal.scale_q14[0], cal.scale_q14[1], cal.scale_q14[2], (long)cal.tc_q16[0],
+          (long)cal.tc_q16[3], (long)cal.tc_q16[5]);
+
+    /* caminho quente a 42 °C (fora de t_ref): parado com Z para cima vira 0/0/1 g, giro 0 */
+    cal_mean(4, 42.0f, &s);
+    mpu6050_cal_apply(&cal, &s);
+    CHECK(abs(s.ax) <= 3 && abs(s.ay) <= 3 && abs(s.az - 16384) <= 4 &&
+          abs(s.gx) <= 2 && abs(s.gy) <= 2 && abs(s.gz) <= 2,
+          "cal apply: %d %d %d / %d %d %d", s.ax, s.ay, s.az, s.gx, s.gy, s.gz);
+    printf("[CAL] off ax %d gx %d, escala x %d q14, tc gx %ld q16; aplicado a 42 C: %d %d %d / %d %d %d\n",
+           cal.off[0], cal.off[3], cal.scale_q14[0], (long)cal.tc_q16[3], s.ax, s.ay, s.az, s.gx, s.gy, s.gz);
+}
+
+/* Mediana com janela par: usa len-1 e não escreve além de 'len' amostras. */
+static void filt_check(void){
+    int16_t buf[5] = { 0, 0, 0, 0, 0x5A5A };
+    static const int16_t in[6] = { 10, 900, 20, 30, -700, 40 };
+    int16_t out[6];
+    filt_median_t md;
+    filt_median_init(&md, buf, 4);
+    filt_median(&md, in, out, 6);
+    CHECK(md.len == 3 && buf[4] == 0x5A5A && out[1] == 10 && out[3] == 30 && out[5] == 30,
+          "mediana par: len %u sentinela 0x%04X saida %d %d %d", md.len, (uint16_t)buf[4], out[1], out[3], out[5]);
+}
+
+int main(void){
+    serial_stdio_init(115200);
+
+    mpu6050_sim_init(&imu_sim, MPU6050_ADDR);
+
+    mpu6050_raw_t s;
+    if (mpu6050_init() == 0 && mpu6050_sim_advance(&imu_sim, 1) && mpu6050_read_all(&s) == 0)
+        printf("[MPU] ax=%d ay=%d az=%d\n", s.ax, s.ay, s.az);
+    else
+        printf("[MPU] falha\n");
+
+    /* mesma leitura pela fila do I2C (no host completa dentro do submit) */
+    static mpu6050_async_t rd;
+    i2c1_async_init();
+    if (mpu6050_read_start(&rd, NULL, NULL) == 0 && i2c1_xfer_wait(&rd.xfer) == I2C1_OK){
+        mpu6050_decode(rd.buf, &s);
+        printf("[MPU] async az=%d\n", s.az);
+    }
+
+    /* handle + scatter-gather: WHO_AM_I e ACCEL_Z numa ida só */
+    static const i2c1_dev_t imu = { MPU6050_ADDR, I2C1_PRIO_HIGH, 0 };
+    uint8_t who = 0, az[2] = {0};
+    const i2c1_sg_t sg[2] = { { 0x75, &who, 1 }, { 0x3F, az, 2 } };
+    if (i2c1_dev_read_sg(&imu, sg, 2) == 0)
+        printf("[I2C] sg who=0x%02X az=%d\n", who, (int16_t)((az[0] << 8) | az[1]));
+
+    /* auto-escala: az encostado no fundo alarga; 4 amostras pequenas estreitam */
+    static mpu6050_autorange_t ar;
+    mpu6050_autorange_init(&ar, 4);
+    s.az = 32767;
+    mpu6050_autorange(&ar, &s);
+    int afs_up = mpu6050_scale.afs;
+    s.az = 8192;
+    for (int i = 0; i < 4; i++) mpu6050_autorange(&ar, &s);
+    printf("[MPU] autorange afs %d -> %d, 1 g = %ld mg, ACCEL_CONFIG=0x%02X\n", afs_up,
+           mpu6050_scale.afs, (long)mpu6050_accel_mg(16384 >> mpu6050_scale.afs), imu_sim.regs[0x1C]);
+
+    /* dois sensores (0x68 e 0x69) numa passada; o INT do segundo fica solto */
+    static mpu6050_t imu_b;
+    static mpu6050_dual_t dual;
+    static mpu6050_dual_sample_t ds;
+    mpu6050_sim_init(&imu_sim_b, 0x69);
+    imu_sim_b.int_pin = 0;
+    if (mpu6050_dev_init(&imu_b, 0x69) == 0) {
+        mpu6050_dual_init(&dual, &mpu6050_main, &imu_b);
+        for (int i = 0; i < 3; i++) {
+            mpu6050_sim_advance(&imu_sim, 1);
+            mpu6050_sim_advance(&imu_sim_b, 1);
+            mpu6050_dual_read(&dual, &ds);
+        }
+        printf("[DUAL] ok=%u az=%d/%d\n", ds.ok, ds.raw[0].az, ds.raw[1].az);
+        mpu6050_dual_print(&dual);
+    }
+
+    /* anel SPSC: 20 amostras em 16 slots -> 4 overflows, lidas em 2 trechos
+       depois que o consumidor avança 10 e o produtor dá a volta */
+    static mpu6050_raw_t ring_buf[16];
+    static spsc_t ring;
+    spsc_init(&ring, ring_buf, sizeof(ring_buf[0]), 16);
+    for (int i = 0; i < 20; i++) { s.ax = (int16_t)i; spsc_push(&ring, &s); }
+    for (int i = 0; i < 10; i++) spsc_pop(&ring, &s);
+    for (int i = 0; i < 6; i++) { s.ax = (int16_t)(100 + i); spsc_push(&ring, &s); }
+    void *span;
+    uint32_t n1 = spsc_read_span(&ring, &span); spsc_release(&ring, n1);
+    uint32_t n2 = spsc_read_span(&ring, &span);
+    printf("[SPSC] overflows=%lu pico=%lu trechos %lu+%lu, ultimo ax=%d\n",
+           (unsigned long)ring.overflows, (unsigned long)ring.high_water,
+           (unsigned long)n1, (unsigned long)n2, ((mpu6050_raw_t *)span)[n2 - 1].ax);
+
+    mpu_sim_checks();
+    dmp_bench();
+    bias_check();
+
+    cal_check();
+    filt_check();
+
+    st7789_init();
+    st7789_prof_frame_end();                 /* abre o 1º período */
+    st7789_prof_frame_begin();
+    st7789_fill_screen_dma(C_BLACK);
+    st7789_fill_rect_dma(20, 20, 200, 40, C_BLUE);
+    st7789_draw_text_5x7_aa(30, 32, "ELF74", C_WHITE, 3, C_BLUE);
+    st7789_fill_circle_aa(120, 150, 40, C_RED, C_BLACK);
+    st7789_draw_line_aa(10, 230, 230, 80, C_YELL, C_BLACK);
+    st7789_prof_frame_end();
+    st7789_prof_draw_overlay(ST7789_PROF_BOTTOM_RIGHT);
+    st7789_prof_print();
+
+    if (st7789_native_save_ppm("lcd.ppm") == 0) printf("[LCD] lcd.ppm salvo\n");
+
+    rgb565_blend_bench();
+    ahrs_bench();
+    filt_bench();
+    fmt_check();
+    log_check();                /* por último: deixa o log enfileirado */
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,47 @@
+#pragma once
+/* Fusão giro + accel (6 eixos) num quatérnio: Mahony (PI sobre o erro
+   entre a gravidade medida e a estimada) ou Madgwick (passo de gradiente).
+   Float simples: no F411 tudo cai no FPU (VSQRT/VDIV inclusive).
+   Sem magnetômetro o yaw deriva; roll/pitch e o vetor gravidade não.
+
+   Amostras com |a| longe de 1 g (vibração, pancada, aceleração linear)
+   não corrigem a atitude: nesse intervalo vale só a integração do giro. */
+#include <stdint.h>
+#include "mpu6050.h"
+
+#define AHRS_MAHONY    0u
+#define AHRS_MADGWICK  1u
+
+typedef struct {
+    float q0, q1, q2, q3;
+    float kp, ki;          /* Mahony                                 */
+    float ix, iy, iz;      /* Mahony: integral do erro (viés residual) */
+    float beta;            /* Madgwick                               */
+    float acc_tol;         /* aceita accel em 1 g ± acc_tol          */
+    uint8_t algo;
+    uint32_t rejected;     /* amostras de accel ignoradas            */
+} ahrs_t;
+
+/* Ganhos típicos: Mahony kp 1.0, ki 0 (viés já calibrado) ou ~0.05;
+   Madgwick beta ~0.1 (maior = segue o accel mais rápido, mais ruído). */
+void ahrs_init_mahony(ahrs_t *a, float kp, float ki);
+void ahrs_init_madgwick(ahrs_t *a, float beta);
+/* Atitude direto da gravidade medida (sem transitório de convergência). */
+void ahrs_reset_to_accel(ahrs_t *a, float ax, float ay, float az);
+
+/* giro em rad/s, accel em qualquer unidade com 1 g = 1 (só a direção
+   importa, o módulo só decide a rejeição), dt em s. */
+void ahrs_update(ahrs_t *a, float gx, float gy, float gz,
+                 float ax, float ay, float az, float dt);
+/* Amostra crua (de preferência já calibrada) na escala ativa do driver. */
+void ahrs_update_raw(ahrs_t *a, const mpu6050_raw_t *s, float dt);
+
+/* Gravidade estimada nos eixos do sensor (unitária): em repouso é o que o
+   accel mostraria sem ruído nem aceleração linear. */
+void ahrs_gravity(const ahrs_t *a, float *gx, float *gy, float *gz);
+/* Roll (em X) e pitch (em Y) em radianos. */
+void ahrs_tilt(const ahrs_t *a, float *roll, float *pitch);
+
+/* Ciclos por update (Mahony e Madgwick) no printf. No alvo requer CYCCNT
+   ligado (delay_init()/drv_cycles_init()). */
+void ahrs_bench(void);
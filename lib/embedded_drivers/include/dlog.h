@@ -0,0 +1,154 @@
+#pragma once
+/* Log diferido: o printf formata no host, não no alvo.
+
+   DLOG("[STATE] %s -> %s\n", a, b) guarda o texto do formato numa seção
+   .dlog que não é carregada (fica só no ELF, não ocupa flash) e manda pela
+   serial só um quadro binário com o id do formato, o carimbo (ciclos) e os
+   argumentos crus:
+
+       0xD1 | len | id (varint) | ciclos (4 B LE) | args... | crc8
+
+   id = posição do texto dentro de .dlog. Inteiros vão em varint zigzag,
+   float/double em float de 4 B, strings com 1 B de tamanho na frente.
+   tools/dlog_decode lê o ELF e remonta as mensagens; o texto de printf
+   normal passa direto (bytes de quadro começam em 0xD1 e têm CRC).
+
+   Ligar com -DDLOG_BINARY. Sem a flag, DLOG vai para log_printf(LOG_INFO)
+   (log_task.h): printf comum até log_init(), depois a task de log.
+   O tipo de cada argumento sai do _Generic; o formato é conferido pelo
+   -Wformat como num printf. No máximo DLOG_MAX_ARGS argumentos.
+   Com o TX por DMA ligado (serial_tx_async_init) o quadro entra no anel
+   inteiro ou não entra (DROP) e a chamada não espera o fio (custo medido
+   em dlog_get_stats()->cyc_last/cyc_max); sem ele, espera como o printf.
+   No backend de host os ids só valem com executável não-PIE (-no-pie). */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "drivers_config.h"
+#include "drv_hal.h"
+#include "log_task.h"
+
+#define DLOG_SYNC      0xD1u
+#define DLOG_MAX_ARGS  8
+
+typedef struct {
+    uint32_t frames;       /* quadros entregues à serial        */
+    uint32_t dropped;      /* sem espaço no anel                */
+    uint32_t truncated;    /* argumentos não couberam no quadro */
+    uint32_t cyc_last;     /* custo da última chamada (ciclos)  */
+    uint32_t cyc_max;
+} dlog_stats_t;
+
+const dlog_stats_t *dlog_get_stats(void);
+
+#ifdef DLOG_BINARY
+
+typedef struct {
+    uint8_t n;                          /* próximo byte livre em b[] */
+    uint8_t over;
+    uint32_t t0;                        /* = carimbo, mede o custo   */
+    uint8_t b[DLOG_FRAME_MAX + 3u];     /* sync, len, payload, crc   */
+} dlog_frame_t;
+
+/* Fecha o quadro (len + CRC) e manda; chamado pela macro. */
+void dlog_end(dlog_frame_t *f);
+
+static inline void dlog_put_u32(dlog_frame_t *f, uint32_t v){
+    if (f->n + 5u > DLOG_FRAME_MAX + 2u){ f->over = 1; return; }
+    while (v >= 0x80u){ f->b[f->n++] = (uint8_t)(v | 0x80u); v >>= 7; }
+    f->b[f->n++] = (uint8_t)v;
+}
+static inline void dlog_put_u64(dlog_frame_t *f, uint64_t v){
+    if (f->n + 10u > DLOG_FRAME_MAX + 2u){ f->over = 1; return; }
+    while (v >= 0x80u){ f->b[f->n++] = (uint8_t)(v | 0x80u); v >>= 7; }
+    f->b[f->n++] = (uint8_t)v;
+}
+static inline void dlog_put_i32(dlog_frame_t *f, int32_t v){
+    dlog_put_u32(f, ((uint32_t)v << 1) ^ (uint32_t)(v >> 31));
+}
+static inline void dlog_put_i64(dlog_frame_t *f, int64_t v){
+    dlog_put_u64(f, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+}
+static inline void dlog_put_ptr(dlog_frame_t *f, const void *p){
+    dlog_put_u64(f, (uint64_t)(uintptr_t)p << 1);
+}
+static inline void dlog_put_f32(dlog_frame_t *f, float v){
+    if (f->n + 4u > DLOG_FRAME_MAX + 2u){ f->over = 1; return; }
+    memcpy(&f->b[f->n], &v, 4);
+    f->n = (uint8_t)(f->n + 4u);
+}
+static inline void dlog_put_f64(dlog_frame_t *f, double v){ dlog_put_f32(f, (float)v); }
+static inline void dlog_put_str(dlog_frame_t *f, const char *s){
+    uint32_t room = DLOG_FRAME_MAX + 2u - f->n;
+    uint32_t len = 0;
+    if (room == 0u){ f->over = 1; return; }
+    if (s == NULL) s = "(null)";
+    while (s[len] && len < room - 1u && len < 255u) len++;
+    if (s[len]) f->over = 1;                       /* cortada, mas decodificável */
+    f->b[f->n++] = (uint8_t)len;
+    memcpy(&f->b[f->n], s, len);
+    f->n = (uint8_t)(f->n + len);
+}
+
+static inline void dlog_begin(dlog_frame_t *f, uint32_t id){
+    f->n = 2u;
+    f->over = 0u;
+    dlog_put_u32(f, id);
+    f->t0 = drv_cycles();
+    memcpy(&f->b[f->n], &f->t0, 4);                /* Cortex-M e x86: LE */
+    f->n = (uint8_t)(f->n + 4u);
+}
+
+/* long de 64 bits só no host; no ARM uint32_t é unsigned long */
+#if __SIZEOF_LONG__ == 8
+#define DLOG_PUT_LONG_  long: dlog_put_i64, unsigned long: dlog_put_i64,
+#else
+#define DLOG_PUT_LONG_
+#endif
+
+#define DLOG_PUT_(f, x) _Generic((x),                          \
+        float: dlog_put_f32, double: dlog_put_f64,             \
+        char *: dlog_put_str, const char *: dlog_put_str,      \
+        void *: dlog_put_ptr, const void *: dlog_put_ptr,      \
+        DLOG_PUT_LONG_                                          \
+        long long: dlog_put_i64, unsigned long long: dlog_put_i64, \
+        default: dlog_put_i32)((f), (x));
+
+#define DLOG_N_(_0, _1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+#define DLOG_NARGS_(...) DLOG_N_(_0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define DLOG_CAT_(a, b)  a##b
+#define DLOG_XCAT_(a, b) DLOG_CAT_(a, b)
+
+#define DLOG_A0_(f)
+#define DLOG_A1_(f, a)      DLOG_PUT_(f, a)
+#define DLOG_A2_(f, a, ...) DLOG_PUT_(f, a) DLOG_A1_(f, __VA_ARGS__)
+#define DLOG_A3_(f, a, ...) DLOG_PUT_(f, a) DLOG_A2_(f, __VA_ARGS__)
+#define DLOG_A4_(f, a, ...) DLOG_PUT_(f, a) DLOG_A3_(f, __VA_ARGS__)
+#define DLOG_A5_(f, a, ...) DLOG_PUT_(f, a) DLOG_A4_(f, __VA_ARGS__)
+#define DLOG_A6_(f, a, ...) DLOG_PUT_(f, a) DLOG_A5_(f, __VA_ARGS__)
+#define DLOG_A7_(f, a, ...) DLOG_PUT_(f, a) DLOG_A6_(f, __VA_ARGS__)
+#define DLOG_A8_(f, a, ...) DLOG_PUT_(f, a) DLOG_A7_(f, __VA_ARGS__)
+
+/* Seção sem a flag "a" (alloc): o resto da diretiva que o GCC emite vira
+   comentário do assembler ('@' no ARM, '#' no x86). */
+#if defined(__arm__)
+#define DLOG_SECTION_ ".dlog,\"\",%progbits @"
+#else
+#define DLOG_SECTION_ ".dlog,\"\",@progbits #"
+#endif
+
+#define DLOG(fmt, ...) do {                                                   \
+        static const char dlog_fmt_[]                                         \
+            __attribute__((section(DLOG_SECTION_), used)) = fmt;             \
+        if (0) printf(fmt, ##__VA_ARGS__);          /* só o -Wformat */       \
+        dlog_frame_t dlog_f_;                                                 \
+        dlog_begin(&dlog_f_, (uint32_t)(uintptr_t)dlog_fmt_);                 \
+        DLOG_XCAT_(DLOG_A, DLOG_XCAT_(DLOG_NARGS_(__VA_ARGS__), _))(&dlog_f_, ##__VA_ARGS__) \
+        dlog_end(&dlog_f_);                                                   \
+    } while (0)
+
+#else
+
+#define DLOG(fmt, ...) log_printf(LOG_INFO, fmt, ##__VA_ARGS__)
+
+#endif
@@ -0,0 +1,202 @@
+#pragma once
+/* Configuração em tempo de compilação dos drivers compartilhados.
+   Cada projeto sobrescreve o que quiser no seu include/board.h;
+   o que não for definido lá cai nos padrões abaixo (Blackpill F411). */
+#if defined(__has_include)
+#  if __has_include("board.h")
+#    include "board.h"
+#  endif
+#endif
+
+/* ============================ ST7789 =============================== */
+#ifndef LCD_W
+#define LCD_W 240
+#endif
+#ifndef LCD_H
+#define LCD_H 240
+#endif
+
+#ifndef LCD_DC_PORT
+#define LCD_DC_PORT   GPIOB
+#define LCD_DC_PIN    0
+#endif
+#ifndef LCD_RST_PORT
+#define LCD_RST_PORT  GPIOB
+#define LCD_RST_PIN   1
+#endif
+#ifndef LCD_BLK_PORT
+#define LCD_BLK_PORT  GPIOB
+#define LCD_BLK_PIN   6
+#endif
+#ifndef LCD_CS_PORT
+#define LCD_CS_PORT   GPIOB
+#define LCD_CS_PIN    10
+#endif
+
+/* SPI do LCD (MODE3, só TX) */
+#ifndef LCD_SPI
+#define LCD_SPI           SPI1
+#define LCD_SPI_RCC_ENR   RCC->APB2ENR
+#define LCD_SPI_RCC_BIT   RCC_APB2ENR_SPI1EN
+#define LCD_SCK_PORT      GPIOA
+#define LCD_SCK_PIN       5
+#define LCD_MOSI_PORT     GPIOA
+#define LCD_MOSI_PIN      7
+#define LCD_SPI_AF        5
+#endif
+#ifndef LCD_SPI_PCLK_HZ
+#define LCD_SPI_PCLK_HZ   SystemCoreClock   /* APB2 prescaler = 1 */
+#endif
+
+/* DMA do LCD: SPI1_TX = DMA2 Stream3 canal 3 */
+#ifndef LCD_DMA
+#define LCD_DMA             DMA2
+#define LCD_DMA_RCC_BIT     RCC_AHB1ENR_DMA2EN
+#define LCD_DMA_STREAM      DMA2_Stream3
+#define LCD_DMA_STREAM_NUM  3u
+#define LCD_DMA_CHANNEL     3u
+#endif
+
+/* ============================= I2C ================================= */
+/* As funções mantêm o nome histórico i2c1_*; a instância vem daqui. */
+#ifndef DRV_I2C
+#define DRV_I2C           I2C1
+#define DRV_I2C_RCC_BIT   RCC_APB1ENR_I2C1EN
+#define DRV_I2C_RST_BIT   RCC_APB1RSTR_I2C1RST
+#define DRV_I2C_SCL_PORT  GPIOB
+#define DRV_I2C_SCL_PIN   8
+#define DRV_I2C_SDA_PORT  GPIOB
+#define DRV_I2C_SDA_PIN   9
+#define DRV_I2C_AF        4
+#endif
+
+/* Modo por interrupção (i2c1_async_init) */
+#ifndef DRV_I2C_EV_IRQn
+#define DRV_I2C_EV_IRQn        I2C1_EV_IRQn
+#define DRV_I2C_ER_IRQn        I2C1_ER_IRQn
+#define DRV_I2C_EV_IRQHandler  I2C1_EV_IRQHandler
+#define DRV_I2C_ER_IRQHandler  I2C1_ER_IRQHandler
+#endif
+#ifndef DRV_I2C_IRQ_PRIO
+#define DRV_I2C_IRQ_PRIO       6      /* >= configMAX_SYSCALL (5): pode usar FromISR */
+#endif
+#ifndef DRV_I2C_TIMEOUT_US
+#define DRV_I2C_TIMEOUT_US     5000u  /* por transação (14 B a 100 kHz ~ 1.5 ms) */
+#endif
+/* RX por DMA nas leituras de 2+ bytes (LAST=1: NACK automático no último).
+   I2C1_RX = DMA1 Stream0 canal 1. DRV_I2C_USE_DMA=0 fica só com interrupções. */
+#ifndef DRV_I2C_USE_DMA
+#define DRV_I2C_USE_DMA        1
+#endif
+#ifndef DRV_I2C_DMA
+#define DRV_I2C_DMA                DMA1
+#define DRV_I2C_DMA_RCC_BIT        RCC_AHB1ENR_DMA1EN
+#define DRV_I2C_DMA_RX_STREAM      DMA1_Stream0
+#define DRV_I2C_DMA_RX_NUM         0u
+#define DRV_I2C_DMA_RX_CHANNEL     1u
+#define DRV_I2C_DMA_RX_IRQn        DMA1_Stream0_IRQn
+#define DRV_I2C_DMA_RX_IRQHandler  DMA1_Stream0_IRQHandler
+#endif
+/* Índice de notificação FreeRTOS usado pelas esperas de I2C (-DDRIVERS_FREERTOS);
+   exige configTASK_NOTIFICATION_ARRAY_ENTRIES > índice. */
+#ifndef DRV_I2C_NOTIFY_INDEX
+#define DRV_I2C_NOTIFY_INDEX   1
+#endif
+
+#ifndef MPU6050_ADDR
+#define MPU6050_ADDR      0x68u   // AD0=GND
+#endif
+
+/* Pino INT do MPU6050 (DATA_RDY, mpu6050_drdy_init): PB5 -> EXTI5.
+   O vetor EXTI9_5 é compartilhado pelos pinos 5..9; se a aplicação já usa
+   um deles, trocar o pino aqui (e IRQn/handler junto). */
+#ifndef MPU6050_INT_PORT
+#define MPU6050_INT_PORT        GPIOB
+#define MPU6050_INT_PIN         5
+#define MPU6050_INT_IRQn        EXTI9_5_IRQn
+#define MPU6050_INT_IRQHandler  EXTI9_5_IRQHandler
+#endif
+#ifndef MPU6050_INT_IRQ_PRIO
+#define MPU6050_INT_IRQ_PRIO    6     /* >= configMAX_SYSCALL (5): pode usar FromISR */
+#endif
+/* Índice de notificação da task acordada pelo DATA_RDY (0 = o padrão do
+   xTaskNotifyGive); não pode colidir com DRV_I2C_NOTIFY_INDEX. */
+#ifndef MPU6050_DRDY_NOTIFY_INDEX
+#define MPU6050_DRDY_NOTIFY_INDEX 0
+#endif
+
+/* ======================== USART (stdio) ============================ */
+#ifndef STDIO_USART
+#define STDIO_USART          USART1
+#define STDIO_USART_RCC_ENR  RCC->APB2ENR
+#define STDIO_USART_RCC_BIT  RCC_APB2ENR_USART1EN
+#define STDIO_USART_PCLK_HZ  SystemCoreClock   /* APB2 prescaler = 1 */
+#define STDIO_TX_PORT        GPIOA
+#define STDIO_TX_PIN         9
+#define STDIO_RX_PORT        GPIOA
+#define STDIO_RX_PIN         10
+#define STDIO_USART_AF       7
+#endif
+
+/* TX do stdio por DMA (serial_tx_async_init): USART1_TX = DMA2 Stream7
+   canal 4. O anel guarda o que o printf escreveu até o DMA mandar. */
+#ifndef STDIO_TX_RING_SIZE
+#define STDIO_TX_RING_SIZE   1024u   /* potência de 2 */
+#endif
+#ifndef STDIO_TX_DMA
+#define STDIO_TX_DMA             DMA2
+#define STDIO_TX_DMA_RCC_BIT     RCC_AHB1ENR_DMA2EN
+#define STDIO_TX_DMA_STREAM      DMA2_Stream7
+#define STDIO_TX_DMA_NUM         7u
+#define STDIO_TX_DMA_CHANNEL     4u
+#define STDIO_TX_DMA_IRQn        DMA2_Stream7_IRQn
+#define STDIO_TX_DMA_IRQHandler  DMA2_Stream7_IRQHandler
+#endif
+#ifndef STDIO_TX_IRQ_PRIO
+#define STDIO_TX_IRQ_PRIO        7   /* abaixo do I2C/INT: log não atrasa sensor */
+#endif
+
+/* RX do stdio por DMA circular (serial_rx_async_init): USART1_RX = DMA2
+   Stream2 canal 4 (Stream5 canal 4 também serve). O IRQ da USART só
+   atende IDLE (fim de rajada) e erros; os bytes o DMA copia sozinho. */
+#ifndef STDIO_RX_RING_SIZE
+#define STDIO_RX_RING_SIZE   512u    /* potência de 2; ~5,5 ms a 921600 */
+#endif
+#ifndef STDIO_RX_DMA
+#define STDIO_RX_DMA             DMA2
+#define STDIO_RX_DMA_RCC_BIT     RCC_AHB1ENR_DMA2EN
+#define STDIO_RX_DMA_STREAM      DMA2_Stream2
+#define STDIO_RX_DMA_NUM         2u
+#define STDIO_RX_DMA_CHANNEL     4u
+#define STDIO_RX_DMA_IRQn        DMA2_Stream2_IRQn
+#define STDIO_RX_DMA_IRQHandler  DMA2_Stream2_IRQHandler
+#endif
+#ifndef STDIO_USART_IRQn
+#define STDIO_USART_IRQn         USART1_IRQn
+#define STDIO_USART_IRQHandler   USART1_IRQHandler
+#endif
+#ifndef STDIO_RX_IRQ_PRIO
+#define STDIO_RX_IRQ_PRIO        7
+#endif
+
+/* Log diferido (dlog.h, -DDLOG_BINARY): maior payload de um quadro */
+#ifndef DLOG_FRAME_MAX
+#define DLOG_FRAME_MAX           48u     /* <= 250 */
+#endif
+
+/* Log multi-task (log_task.h) */
+#ifndef LOG_RING_SIZE
+#define LOG_RING_SIZE            2048u   /* potência de 2, bytes */
+#endif
+#ifndef LOG_REC_MAX
+#define LOG_REC_MAX              128u    /* formato + argumentos de um registro */
+#endif
+#ifndef LOG_LINE_MAX
+#define LOG_LINE_MAX             160u
+#endif
+#ifndef LOG_TASK_PERIOD_MS
+#define LOG_TASK_PERIOD_MS       10u
+#endif
+#ifndef LOG_TASK_STACK
+#define LOG_TASK_STACK           384u    /* palavras: snprintf com %f é fundo */
+#endif
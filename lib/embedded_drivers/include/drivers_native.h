@@ -0,0 +1,109 @@
+#pragma once
+/* Backend de host (Linux): compilar com -DDRIVERS_NATIVE.
+   Mesmo código de desenho/sensor do alvo, com periféricos emulados:
+   - LCD: interpreta CASET/RASET/RAMWR num framebuffer RGB565;
+   - I2C: transações vão para dispositivos registrados com i2c_native_attach();
+   - USART: stdout. */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Clock nominal usado para converter tempo de host em "ciclos" (100 MHz). */
+extern uint32_t SystemCoreClock;
+
+/* Contador livre de 32 bits na taxa de SystemCoreClock (tempo monotônico). */
+uint32_t native_cycles(void);
+
+/* ---------------------------- LCD --------------------------------- */
+/* Framebuffer LCD_W x LCD_H, row-major, RGB565. */
+const uint16_t *st7789_native_framebuffer(void);
+/* Salva o framebuffer como PPM (P6). Retorna 0 em sucesso. */
+int st7789_native_save_ppm(const char *path);
+
+/* ---------------------------- I2C --------------------------------- */
+/* Dispositivo escravo emulado: registrador auto-incrementado. */
+typedef struct i2c_native_dev {
+    void *ctx;
+    /* escreve n bytes a partir de 'reg'; retorna 0 (ACK) ou <0 (NACK) */
+    int (*write)(void *ctx, uint8_t reg, const uint8_t *data, uint32_t n);
+    /* lê n bytes a partir de 'reg' */
+    int (*read)(void *ctx, uint8_t reg, uint8_t *data, uint32_t n);
+} i2c_native_dev_t;
+
+/* Liga (ou desliga, com dev=NULL) um dispositivo no endereço 7 bits. */
+void i2c_native_attach(uint8_t addr7, const i2c_native_dev_t *dev);
+
+/* Simula a borda do pino INT do MPU6050 (o que o ISR da EXTI faz no alvo). */
+void mpu6050_native_int(void);
+
+/* ------------------------- MPU6050 emulado ------------------------- */
+/* Modelo do banco de registros: WHO_AM_I, PWR_MGMT_1/2 (reset, sleep,
+   ciclo, standby), CONFIG/SMPLRT (taxa), escalas, registros de dados,
+   FIFO de 1024 B (FIFO_EN, reset, OFLOW sobrescrevendo o mais antigo),
+   INT_STATUS (limpa na leitura), DATA_RDY/FIFO_OFLOW/movimento no INT
+   (chama mpu6050_native_int). O tempo é virtual: amostras só nascem em
+   mpu6050_sim_run_ms()/mpu6050_sim_advance(), na taxa programada.
+   DMP: a memória (BANK_SEL/MEM_START/MEM_R_W) guarda o que for gravado e,
+   com PRGM_START gravado e DMP_EN, cada amostra vira um pacote de
+   dmp_packet_len bytes na FIFO com o quatérnio da atitude parada (roll e
+   pitch da gravidade, yaw 0) em vez dos grupos de FIFO_EN. O conteúdo da
+   imagem não é interpretado. */
+
+/* Estado físico no instante t (s): accel em g, giro em °/s, temp em °C.
+   Chega preenchido com o valor estático; só sobrescrever o que mudar. */
+typedef void (*mpu6050_sim_motion_fn)(void *ctx, double t_s, float acc_g[3],
+                                      float gyr_dps[3], float *temp_c);
+
+typedef struct {
+    uint32_t samples;
+    uint32_t fifo_overflows;     /* bytes sobrescritos na FIFO */
+    uint32_t int_edges;
+    uint32_t reads, writes;      /* transações I2C atendidas   */
+    uint32_t bytes_read;
+    uint32_t dmp_packets;
+} mpu6050_sim_stats_t;
+
+typedef struct {
+    uint8_t  regs[128];
+    uint8_t  fifo[1024];
+    uint8_t  dmp_mem[4096];
+    uint8_t  dmp_packet_len;     /* 16 ou 28 (padrão), ver mpu6050_dmp.h */
+    uint16_t fifo_head, fifo_count;
+    float    acc_g[3], gyr_dps[3], temp_c;
+    mpu6050_sim_motion_fn motion;
+    void    *motion_ctx;
+    const int32_t (*track)[6];
+    uint32_t track_len;
+    uint16_t track_hz;
+    uint16_t noise_lsb;
+    uint32_t rng;
+    double   t_s, next_s;        /* tempo virtual / próxima amostra */
+    int16_t  hpf_ref[3];
+    uint32_t mot_count;
+    uint8_t  int_pin;            /* 0 = INT desligado da "EXTI"  */
+    i2c_native_dev_t dev;
+    mpu6050_sim_stats_t stats;
+} mpu6050_sim_t;
+
+/* Estado de power-on (dormindo, WHO_AM_I 0x68, parado com 1 g em Z, 25 °C)
+   e liga no barramento emulado em addr7. */
+void  mpu6050_sim_init(mpu6050_sim_t *s, uint8_t addr7);
+void  mpu6050_sim_set_static(mpu6050_sim_t *s, float ax, float ay, float az,
+                             float gx, float gy, float gz);
+void  mpu6050_sim_set_motion(mpu6050_sim_t *s, mpu6050_sim_motion_fn fn, void *ctx);
+/* Trilha gravada em contagens de ±2 g / ±250 dps (o formato da telemetria
+   do HC-12: ax ay az gx gy gz), rate_hz linhas/s, repetida em laço. */
+void  mpu6050_sim_play(mpu6050_sim_t *s, const int32_t (*rows)[6], uint32_t n, uint16_t rate_hz);
+/* Ruído uniforme ±lsb por eixo, sequência determinística pela semente. */
+void  mpu6050_sim_set_noise(mpu6050_sim_t *s, uint16_t lsb, uint32_t seed);
+/* Avança o tempo virtual; retorna quantas amostras nasceram. */
+uint32_t mpu6050_sim_run_ms(mpu6050_sim_t *s, uint32_t ms);
+/* Gera n amostras já (um período cada). */
+uint32_t mpu6050_sim_advance(mpu6050_sim_t *s, uint32_t n);
+float mpu6050_sim_rate_hz(const mpu6050_sim_t *s);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+/* Ponto único de acesso ao hardware: registradores no alvo,
+   backend de host quando compilado com -DDRIVERS_NATIVE. */
+#include <stdint.h>
+#include "drivers_config.h"
+
+#ifdef DRIVERS_NATIVE
+#include "drivers_native.h"
+static inline uint32_t drv_cycles(void){ return native_cycles(); }
+static inline void drv_cycles_init(void){}
+/* Troca os bytes de cada meia-palavra (REV16) */
+static inline uint32_t drv_rev16(uint32_t w){ return ((w & 0xFF00FF00u) >> 8) | ((w & 0x00FF00FFu) << 8); }
+/* Host sem interrupções: seção crítica vazia */
+static inline uint32_t drv_irq_save(void){ return 0; }
+static inline void drv_irq_restore(uint32_t pm){ (void)pm; }
+#else
+#include "stm32f4xx.h"
+#include "stm32_gpio.h"
+#include "stm32_dma.h"
+/* DWT CYCCNT (ligado por delay_init() ou drv_cycles_init()) */
+static inline uint32_t drv_cycles(void){ return DWT->CYCCNT; }
+/* Liga o CYCCNT sem zerar (idempotente; labs sem delay_rtos também usam).
+   DBG_SLEEP mantém o clock do core no WFI: sem ele o CYCCNT para no idle
+   e timeouts/carimbos deixam de acompanhar o tempo real (custa um pouco
+   de corrente no sleep). */
+static inline void drv_cycles_init(void){
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    DBGMCU->CR |= DBGMCU_CR_DBG_SLEEP;
+}
+/* Troca os bytes de cada meia-palavra: 1 instrução */
+static inline uint32_t drv_rev16(uint32_t w){ return __REV16(w); }
+/* Seção crítica curta (aninhável): salva e restaura o PRIMASK */
+static inline uint32_t drv_irq_save(void){ uint32_t pm = __get_PRIMASK(); __disable_irq(); return pm; }
+static inline void drv_irq_restore(uint32_t pm){ __set_PRIMASK(pm); }
+#endif
+
+/* Microssegundos -> ciclos de drv_cycles() */
+static inline uint32_t drv_us_to_cycles(uint32_t us){ return us * (SystemCoreClock / 1000000u); }
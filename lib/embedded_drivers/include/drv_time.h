@@ -0,0 +1,18 @@
+#pragma once
+/* Base de tempo de 64 bits: o CYCCNT (32 bits, dá a volta em ~42 s a
+   100 MHz) estendido em software. drv_cycles64() percebe a volta
+   comparando com a leitura anterior, então basta ser chamada ao menos uma
+   vez por volta (qualquer laço de aquisição já garante). Vale em task e ISR.
+   Carimbos são ciclos desde o boot; as conversões usam SystemCoreClock. */
+#include <stdint.h>
+#include "drv_hal.h"
+
+uint64_t drv_cycles64(void);
+
+static inline uint64_t drv_cyc_to_us(uint64_t cyc){ return cyc / (SystemCoreClock / 1000000u); }
+static inline uint32_t drv_cyc_to_ms(uint64_t cyc){ return (uint32_t)(cyc / (SystemCoreClock / 1000u)); }
+/* Intervalo (diferença de dois carimbos) em segundos, para integração */
+static inline float drv_cyc_to_s(uint64_t dcyc){ return (float)dcyc / (float)SystemCoreClock; }
+static inline uint64_t drv_us_to_cycles64(uint64_t us){ return us * (SystemCoreClock / 1000000u); }
+
+static inline uint64_t drv_time_us(void){ return drv_cyc_to_us(drv_cycles64()); }
@@ -0,0 +1,76 @@
+#pragma once
+/* Filtros para blocos de amostras int16 (q15) do IMU: biquad IIR, FIR
+   (com decimação opcional), média móvel e mediana.
+
+   No alvo os laços internos usam as instruções SIMD do M4 (SMLALD: dois
+   MACs 16x16 com acumulador de 64 bits por instrução, as mesmas dos
+   kernels q15 do CMSIS-DSP) pelas intrínsecas do CMSIS-Core; no host as
+   mesmas funções compilam com equivalentes em C. filt_*_ref() são as
+   versões escalares de referência (bit-exatas) para validar e medir.
+
+   Nada aloca: estados e buffers são do chamador. in == out é permitido
+   em todos os estágios. */
+#include <stdint.h>
+
+/* ============================== Biquad =============================== */
+/* y = b0 x + b1 x1 + b2 x2 - a1 y1 - a2 y2 (DF1). Coeficientes em q15
+   divididos por 2^shift (shift 1 cobre |coef| < 2). a1/a2 guardados já
+   com o sinal trocado, como no arm_biquad_cascade_df1_q15. */
+typedef struct {
+    int16_t b0, b1, b2, na1, na2;
+    uint8_t shift;
+    int16_t x1, x2, y1, y2;
+} filt_biquad_t;
+
+/* Passa-baixa/passa-alta de 2a ordem (RBJ): fc e fs em Hz, q ~0.707. */
+void filt_biquad_lowpass(filt_biquad_t *f, float fs, float fc, float q);
+void filt_biquad_highpass(filt_biquad_t *f, float fs, float fc, float q);
+void filt_biquad_reset(filt_biquad_t *f);
+void filt_biquad(filt_biquad_t *f, const int16_t *in, int16_t *out, uint32_t n);
+void filt_biquad_ref(filt_biquad_t *f, const int16_t *in, int16_t *out, uint32_t n);
+
+/* ================================ FIR ================================ */
+/* taps q15 (ntaps par = SIMD sem sobra). state: ntaps-1 + max_block
+   amostras. decim >= 1: só calcula 1 saída a cada 'decim' entradas
+   (filtro anti-alias + decimação no mesmo passo, fase mantida entre
+   blocos). */
+typedef struct {
+    const int16_t *taps;
+    int16_t  *state;
+    uint16_t  ntaps;
+    uint16_t  max_block;
+    uint8_t   decim;
+    uint8_t   phase;
+} filt_fir_t;
+
+void filt_fir_init(filt_fir_t *f, const int16_t *taps, uint16_t ntaps,
+                   int16_t *state, uint16_t max_block, uint8_t decim);
+/* n <= max_block. Retorna quantas saídas escreveu (n/decim, +-1 pela fase). */
+uint32_t filt_fir(filt_fir_t *f, const int16_t *in, int16_t *out, uint32_t n);
+uint32_t filt_fir_ref(filt_fir_t *f, const int16_t *in, int16_t *out, uint32_t n);
+
+/* ===================== Média móvel / mediana ========================= */
+/* buf: 'len' amostras (janela). A soma corre em 32 bits: O(1) por amostra. */
+typedef struct {
+    int16_t *buf;
+    uint16_t len, pos;
+    int32_t  sum;
+} filt_movavg_t;
+
+void filt_movavg_init(filt_movavg_t *f, int16_t *buf, uint16_t len);
+void filt_movavg(filt_movavg_t *f, const int16_t *in, int16_t *out, uint32_t n);
+
+/* Mediana de janela ímpar (3..FILT_MEDIAN_MAX): tira picos isolados sem
+   arredondar degraus. buf: 'len' amostras; 'len' par usa len-1. */
+#define FILT_MEDIAN_MAX 9u
+typedef struct {
+    int16_t *buf;
+    uint16_t len, pos;
+} filt_median_t;
+
+void filt_median_init(filt_median_t *f, int16_t *buf, uint16_t len);
+void filt_median(filt_median_t *f, const int16_t *in, int16_t *out, uint32_t n);
+
+/* Ciclos/amostra de cada estágio (e da referência) no printf. No alvo
+   requer CYCCNT ligado. */
+void filt_bench(void);
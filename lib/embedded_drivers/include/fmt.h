@@ -0,0 +1,133 @@
+#pragma once
+/* Formatação de inteiros e ponto fixo sem printf, sem heap.
+
+   O snprintf do newlib-nano passa pelo _svfprintf_r a cada chamada:
+   interpreta o formato em tempo de execução, monta um FILE falso e divide
+   dígito a dígito, centenas a milhares de ciclos por linha. Aqui cada pedaço já vem com o tipo certo e escreve
+   direto no buffer de quem chama:
+
+       char buf[80];
+       fmt_t w;
+       fmt_init(&w, buf, sizeof(buf));
+       FMT(&w, "T:", FMT_U(sec, 2, '0'), ".", FMT_U(ms, 3, '0'));   // "T:%02lu.%03lu"
+
+   FMT() escolhe a função pelo tipo de cada argumento (_Generic), então o
+   "formato" é resolvido na compilação: string vira cópia, inteiro vira
+   decimal, e float não compila (use FMT_FIX com o valor já escalado).
+   Inteiros de 64 bits passam pelo caminho de 32 quando cabem. 'x' em C é
+   int (sai o número): para um caractere use "x" ou fmt_char().
+
+   Como o snprintf: o buffer sempre termina em '\0'; o que não couber é
+   cortado e marcado em 'truncated'. FMT() avalia 'w' várias vezes (passe
+   &variável) e retorna o comprimento. */
+#include <stdint.h>
+#include <limits.h>
+
+typedef struct {
+    char     *buf;
+    uint32_t  cap;         /* bytes do buffer, incluindo o '\0' */
+    uint32_t  len;
+    uint8_t   truncated;
+} fmt_t;
+
+void fmt_init(fmt_t *w, char *buf, uint32_t cap);
+static inline void fmt_reset(fmt_t *w){ w->len = 0; w->truncated = 0; if (w->cap) w->buf[0] = '\0'; }
+static inline uint32_t fmt_len(const fmt_t *w){ return w->len; }
+
+/* ============================ Básico =============================== */
+void fmt_str(fmt_t *w, const char *s);
+void fmt_mem(fmt_t *w, const char *s, uint32_t n);
+void fmt_char(fmt_t *w, char c);
+void fmt_u32(fmt_t *w, uint32_t v);                                  /* %lu */
+void fmt_i32(fmt_t *w, int32_t v);                                   /* %ld */
+void fmt_u64(fmt_t *w, uint64_t v);
+void fmt_i64(fmt_t *w, int64_t v);
+/* Largura mínima: pad '0' -> %0*lu (sinal antes dos zeros), ' ' -> %*lu */
+void fmt_u32w(fmt_t *w, uint32_t v, uint8_t width, char pad);
+void fmt_i32w(fmt_t *w, int32_t v, uint8_t width, char pad);
+/* Hexa maiúsculo com pelo menos 'digits' dígitos (%0*lX) */
+void fmt_hex(fmt_t *w, uint32_t v, uint8_t digits);
+/* Ponto fixo decimal: v em unidades de 10^-dec (dec 0..9).
+   fmt_ufix(w, 12345, 3) -> "12.345"; fmt_fix(w, -5, 2) -> "-0.05" */
+void fmt_ufix(fmt_t *w, uint32_t v, uint8_t dec);
+void fmt_fix(fmt_t *w, int32_t v, uint8_t dec);
+
+/* itoa: escreve o número e o '\0' em dst (>= 11/12 bytes), retorna os dígitos */
+uint32_t fmt_utoa(char *dst, uint32_t v);
+uint32_t fmt_itoa(char *dst, int32_t v);
+
+/* ====================== Caminho com tipo (FMT) ===================== */
+enum { FMT_K_DEC, FMT_K_FIX, FMT_K_HEX };
+
+typedef struct {
+    uint32_t mag;          /* módulo */
+    uint8_t  neg;
+    uint8_t  kind;         /* FMT_K_* */
+    uint8_t  arg;          /* largura / casas / dígitos */
+    char     pad;
+} fmt_spec_t;
+
+void fmt_spec(fmt_t *w, fmt_spec_t s);
+
+static inline fmt_spec_t fmt_spec_u(uint32_t v, uint8_t kind, uint8_t arg, char pad){
+    fmt_spec_t s = { v, 0, kind, arg, pad };
+    return s;
+}
+static inline fmt_spec_t fmt_spec_i(int32_t v, uint8_t kind, uint8_t arg, char pad){
+    fmt_spec_t s = { v < 0 ? 0u - (uint32_t)v : (uint32_t)v, v < 0, kind, arg, pad };
+    return s;
+}
+
+#define FMT_U(v, width, pad)  fmt_spec_u((v), FMT_K_DEC, (width), (pad))   /* %0Nlu / %Nlu */
+#define FMT_I(v, width, pad)  fmt_spec_i((v), FMT_K_DEC, (width), (pad))   /* %0Nld / %Nld */
+#define FMT_UFIX(v, dec)      fmt_spec_u((v), FMT_K_FIX, (dec), 0)
+#define FMT_FIX(v, dec)       fmt_spec_i((v), FMT_K_FIX, (dec), 0)
+#define FMT_HEX(v, digits)    fmt_spec_u((v), FMT_K_HEX, (digits), '0')
+
+/* long tem 32 bits no ARM e 64 no host */
+#if LONG_MAX == INT32_MAX
+#define FMT_LONG_   fmt_i32
+#define FMT_ULONG_  fmt_u32
+#else
+#define FMT_LONG_   fmt_i64
+#define FMT_ULONG_  fmt_u64
+#endif
+
+#define FMT_ONE_(w, x) _Generic((x),                                        \
+        char *: fmt_str, const char *: fmt_str, char: fmt_char,             \
+        _Bool: fmt_u32, unsigned char: fmt_u32, unsigned short: fmt_u32,    \
+        unsigned int: fmt_u32, unsigned long: FMT_ULONG_,                   \
+        unsigned long long: fmt_u64,                                        \
+        signed char: fmt_i32, short: fmt_i32, int: fmt_i32,                 \
+        long: FMT_LONG_, long long: fmt_i64,                                \
+        fmt_spec_t: fmt_spec)((w), (x))
+
+#define FMT_N_(...)  FMT_N__(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define FMT_N__(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, n, ...) n
+#define FMT_CAT_(a, b)  FMT_CAT__(a, b)
+#define FMT_CAT__(a, b) a##b
+
+#define FMT_E1_(w, x)       FMT_ONE_(w, x)
+#define FMT_E2_(w, x, ...)  FMT_ONE_(w, x), FMT_E1_(w, __VA_ARGS__)
+#define FMT_E3_(w, x, ...)  FMT_ONE_(w, x), FMT_E2_(w, __VA_ARGS__)
+#define FMT_E4_(w, x, ...)  FMT_ONE_(w, x), FMT_E3_(w, __VA_ARGS__)
+#define FMT_E5_(w, x, ...)  FMT_ONE_(w, x), FMT_E4_(w, __VA_ARGS__)
+#define FMT_E6_(w, x, ...)  FMT_ONE_(w, x), FMT_E5_(w, __VA_ARGS__)
+#define FMT_E7_(w, x, ...)  FMT_ONE_(w, x), FMT_E6_(w, __VA_ARGS__)
+#define FMT_E8_(w, x, ...)  FMT_ONE_(w, x), FMT_E7_(w, __VA_ARGS__)
+#define FMT_E9_(w, x, ...)  FMT_ONE_(w, x), FMT_E8_(w, __VA_ARGS__)
+#define FMT_E10_(w, x, ...) FMT_ONE_(w, x), FMT_E9_(w, __VA_ARGS__)
+#define FMT_E11_(w, x, ...) FMT_ONE_(w, x), FMT_E10_(w, __VA_ARGS__)
+#define FMT_E12_(w, x, ...) FMT_ONE_(w, x), FMT_E11_(w, __VA_ARGS__)
+#define FMT_E13_(w, x, ...) FMT_ONE_(w, x), FMT_E12_(w, __VA_ARGS__)
+#define FMT_E14_(w, x, ...) FMT_ONE_(w, x), FMT_E13_(w, __VA_ARGS__)
+#define FMT_E15_(w, x, ...) FMT_ONE_(w, x), FMT_E14_(w, __VA_ARGS__)
+#define FMT_E16_(w, x, ...) FMT_ONE_(w, x), FMT_E15_(w, __VA_ARGS__)
+
+/* Acrescenta até 16 pedaços; retorna fmt_len(w). */
+#define FMT(w, ...) (FMT_CAT_(FMT_CAT_(FMT_E, FMT_N_(__VA_ARGS__)), _)(w, __VA_ARGS__), fmt_len(w))
+
+/* Mede ciclos por linha do snprintf vs. FMT nas linhas que o firmware
+   imprime (telemetria, HUD, display) e confere que saem iguais. No alvo
+   requer delay_init(); puxa o snprintf só para comparar. */
+void fmt_bench(void);
@@ -0,0 +1,146 @@
+#ifndef I2C1_H
+#define I2C1_H
+
+#include <stdint.h>
+#include "drivers_config.h"   // DRV_I2C_TIMEOUT_US
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Barramento I2C dos sensores. Instância e pinos em drivers_config.h
+   (padrão I2C1 em PB8/PB9); o prefixo i2c1_ é histórico.
+   Retornos: 0 = ok, -1 = erro/timeout. Timeout por tempo decorrido
+   (DRV_I2C_TIMEOUT_US), não por contagem de voltas.
+   Barramento travado (SDA preso em 0 depois de brown-out, BUSY eterno,
+   timeout/ARLO/BERR) é recuperado sozinho na próxima transação. */
+
+/* bus_hz: até 100 kHz = standard; acima = fast mode (até 400 kHz), com o
+   DUTY (2:1 ou 16:9) que chegar mais perto do pedido sem passar dele. */
+void i2c1_init(uint32_t apb1_hz, uint32_t bus_hz);
+void i2c1_init_100k(uint32_t apb1_hz);   /* = i2c1_init(apb1_hz, 100000) */
+uint32_t i2c1_get_bus_hz(void);          /* do último i2c1_init (100 kHz antes) */
+/* Tempo no fio (us) de uma leitura de registro de len bytes: addr+W, reg,
+   addr+R e os dados, 9 bits cada. Para dimensionar timeout_us de bursts. */
+static inline uint32_t i2c1_read_us(uint32_t len){
+    uint32_t khz = i2c1_get_bus_hz() / 1000u;
+    return (len + 3u) * 9000u / (khz ? khz : 1u);
+}
+/* 9 pulsos de SCL por GPIO + STOP e reinit do periférico. 0 se SDA soltou. */
+int  i2c1_bus_recover(void);
+
+typedef struct {
+    uint32_t nack;      /* endereço/dado sem ACK   */
+    uint32_t arlo;      /* perda de arbitragem     */
+    uint32_t berr;      /* BERR/OVR                */
+    uint32_t timeout;
+    uint32_t recover;   /* recuperações do barramento */
+} i2c1_stats_t;
+
+const i2c1_stats_t *i2c1_get_stats(void);
+void i2c1_reset_stats(void);
+
+int  i2c1_write_reg(uint8_t addr7, uint8_t reg, uint8_t data);
+/* Um START só: reg e os len bytes seguidos. Quem incrementa o endereço é o
+   dispositivo (registros de porta, como MEM_R_W do MPU6050, não). */
+int  i2c1_write_multi(uint8_t addr7, uint8_t reg, const uint8_t *buf, uint32_t len);
+int  i2c1_read_reg(uint8_t addr7, uint8_t reg, uint8_t *data);
+int  i2c1_read_multi(uint8_t addr7, uint8_t reg, uint8_t *buf, uint32_t len);
+
+/* ===================== Transações por interrupção ===================== */
+/* Depois de i2c1_async_init() o barramento é tocado só pelos ISRs EV/ER:
+   as transações entram numa fila e rodam uma após a outra. As funções
+   bloqueantes acima passam a usar a fila (com -DDRIVERS_FREERTOS a task
+   dorme numa notificação em vez de girar no SR1).
+   A fila é ordenada por prioridade (FIFO dentro do mesmo nível); a
+   transação em andamento nunca é interrompida. */
+
+#define I2C1_OP_WRITE  0u   /* START, addr+W, reg, buf[0..len-1], STOP       */
+#define I2C1_OP_READ   1u   /* START, addr+W, reg, RESTART, addr+R, len bytes */
+
+#define I2C1_PENDING       1
+#define I2C1_OK            0
+#define I2C1_ERR_NACK     -1
+#define I2C1_ERR_BUS      -2   /* BERR / ARLO / OVR */
+#define I2C1_ERR_TIMEOUT  -3
+
+#define I2C1_PRIO_NORMAL   0u  /* configuração, leituras esporádicas        */
+#define I2C1_PRIO_HIGH     1u  /* bursts periódicos de amostras             */
+
+struct i2c1_xfer;
+/* Chamado no contexto do ISR (ou da task em i2c1_async_poll(), no timeout,
+   com IRQs ligados). */
+typedef void (*i2c1_done_fn)(struct i2c1_xfer *x, void *arg);
+
+typedef struct i2c1_xfer {
+    uint8_t  addr7;
+    uint8_t  reg;
+    uint8_t  op;            /* I2C1_OP_*                                  */
+    uint8_t  prio;          /* I2C1_PRIO_* (maior passa na frente)         */
+    uint8_t *buf;
+    uint16_t len;           /* READ: len >= 1                              */
+    uint32_t timeout_us;    /* 0 = i2c1_xfer_timeout_us()                  */
+    i2c1_done_fn done;      /* opcional                                    */
+    void    *arg;
+    void    *notify;        /* TaskHandle_t a notificar (DRIVERS_FREERTOS) */
+    volatile int8_t status; /* I2C1_PENDING até terminar                   */
+    /* uso interno */
+    uint32_t t0;
+    struct i2c1_xfer *next;
+} i2c1_xfer_t;
+
+/* Timeout efetivo: timeout_us, ou DRV_I2C_TIMEOUT_US esticado para o dobro
+   do tempo no fio em bursts longos (33 quadros da FIFO a 400 kHz levam
+   ~10 ms). */
+static inline uint32_t i2c1_xfer_timeout_us(const i2c1_xfer_t *x){
+    if (x->timeout_us) return x->timeout_us;
+    uint32_t us = 2u * i2c1_read_us(x->len);
+    return (us > DRV_I2C_TIMEOUT_US) ? us : DRV_I2C_TIMEOUT_US;
+}
+
+/* Liga NVIC/IRQs do barramento (chamar depois de i2c1_init_100k). */
+void i2c1_async_init(void);
+int  i2c1_async_enabled(void);
+/* Enfileira (não bloqueia). A estrutura e o buffer devem viver até o fim.
+   Retorna 0, ou -1 se inválida. */
+int  i2c1_xfer_submit(i2c1_xfer_t *x);
+/* Espera o fim (notificação FreeRTOS ou polling) e devolve o status. */
+int  i2c1_xfer_wait(i2c1_xfer_t *x);
+/* submit + wait; com o escalonador rodando, a task chamadora é a notificada. */
+int  i2c1_xfer_run(i2c1_xfer_t *x);
+/* Aborta a transação corrente se passou do timeout e faz a recuperação do
+   barramento pendente (depois de BERR/ARLO/timeout a fila fica parada até
+   isso). Só em task; chamar periodicamente quando só se usam callbacks
+   (ex.: no laço da task). */
+void i2c1_async_poll(void);
+
+/* ======================== Handles de dispositivo ====================== */
+/* Endereço + prioridade + timeout de cada dispositivo do barramento. Com a
+   fila ligada, tasks diferentes podem usar dispositivos diferentes sem
+   mutex: tudo passa pela fila. Antes de i2c1_async_init() caem no caminho
+   bloqueante. */
+typedef struct {
+    uint8_t  addr7;
+    uint8_t  prio;          /* I2C1_PRIO_*                                 */
+    uint32_t timeout_us;    /* 0 = i2c1_xfer_timeout_us()                  */
+} i2c1_dev_t;
+
+/* Segmento de leitura: len bytes a partir de reg, em buf. */
+typedef struct {
+    uint8_t  reg;
+    uint8_t *buf;
+    uint16_t len;
+} i2c1_sg_t;
+
+#define I2C1_SG_MAX 4u
+
+int  i2c1_dev_write(const i2c1_dev_t *d, uint8_t reg, const uint8_t *buf, uint16_t len);
+int  i2c1_dev_read(const i2c1_dev_t *d, uint8_t reg, uint8_t *buf, uint16_t len);
+/* Até I2C1_SG_MAX leituras de blocos não contíguos, enfileiradas juntas e
+   executadas em ordem; a task dorme uma vez só. 0 se todas deram certo. */
+int  i2c1_dev_read_sg(const i2c1_dev_t *d, const i2c1_sg_t *sg, uint32_t n);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
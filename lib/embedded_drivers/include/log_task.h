@@ -0,0 +1,76 @@
+#pragma once
+/* Log para várias tasks (e ISRs) sem printf concorrente.
+
+   Com configUSE_NEWLIB_REENTRANT 0 o newlib tem um estado só: dois printf
+   ao mesmo tempo embaralham a linha e, com %f, podem corromper o heap do
+   dtoa. Aqui quem chama não formata nem espera a UART:
+
+   - log_printf() confere o nível, copia o ponteiro do formato e os
+     argumentos crus (strings por valor) para um registro e reserva espaço
+     num anel de bytes com CAS no head: vários produtores, sem trava nem
+     kernel, vale em ISR. Sem espaço, o registro é descartado e contado.
+   - Um só consumidor (log_poll(), chamado pela task de log de prioridade
+     baixa ou pelo laço principal) formata com o snprintf do newlib e
+     escreve a linha inteira na serial. O newlib só roda nessa task.
+
+   Antes de log_init() (boot, sem escalonador) log_printf é um vprintf.
+   Registro maior que LOG_REC_MAX: as strings são cortadas e o que não
+   couber sai como "<?>" (contado em truncated). */
+#include <stdint.h>
+#include <stdarg.h>
+#include "drivers_config.h"
+
+#define LOG_ERROR   0u
+#define LOG_WARN    1u
+#define LOG_INFO    2u
+#define LOG_DEBUG   3u
+#define LOG_LEVELS  4u
+
+/* Níveis acima deste somem em tempo de compilação (LOG_D etc.). */
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_DEBUG
+#endif
+
+typedef struct {
+    uint32_t queued;       /* registros aceitos no anel               */
+    uint32_t written;      /* linhas entregues                        */
+    uint32_t dropped;      /* anel cheio: descartados sem bloquear    */
+    uint32_t filtered;     /* nível desligado em tempo de execução    */
+    uint32_t truncated;    /* registro ou linha cortados              */
+    uint32_t high_water;   /* pico de bytes no anel                   */
+} log_stats_t;
+
+/* Liga o modo enfileirado: daqui em diante alguém tem que chamar log_poll(). */
+void log_init(void);
+/* Formata e escreve o que houver no anel (um consumidor só). Retorna linhas. */
+uint32_t log_poll(void);
+#ifdef DRIVERS_FREERTOS
+/* log_init() + task "LOG" que chama log_poll() a cada LOG_TASK_PERIOD_MS.
+   0 ok, -1 sem memória para a task. */
+int  log_task_start(uint32_t prio);
+#endif
+
+/* Filtros em tempo de execução (valem para todos os produtores na hora). */
+void log_set_level(uint8_t max_level);          /* ERROR..max ligados */
+void log_enable(uint8_t level, int on);
+int  log_enabled(uint8_t level);
+
+/* Destino das linhas (padrão: serial_write). */
+void log_set_sink(void (*sink)(const char *line));
+
+void log_printf(uint8_t level, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+void log_vprintf(uint8_t level, const char *fmt, va_list ap);
+const log_stats_t *log_get_stats(void);
+
+#define LOG_E(...) log_printf(LOG_ERROR, __VA_ARGS__)
+#define LOG_W(...) log_printf(LOG_WARN, __VA_ARGS__)
+#if LOG_COMPILE_LEVEL >= LOG_INFO
+#define LOG_I(...) log_printf(LOG_INFO, __VA_ARGS__)
+#else
+#define LOG_I(...) ((void)0)
+#endif
+#if LOG_COMPILE_LEVEL >= LOG_DEBUG
+#define LOG_D(...) log_printf(LOG_DEBUG, __VA_ARGS__)
+#else
+#define LOG_D(...) ((void)0)
+#endif
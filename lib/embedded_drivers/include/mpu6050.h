@@ -0,0 +1,217 @@
+#ifndef MPU6050_H
+#define MPU6050_H
+
+#include <stdint.h>
+#include "drivers_config.h"   // MPU6050_ADDR
+#include "i2c1.h"
+
+#define MPU6050_REG_WHOAMI 0x75u
+#define MPU6050_REG_PWR1   0x6Bu
+#define MPU6050_REG_ACCEL  0x3Bu
+#define MPU6050_REG_GYRO   0x43u
+#define MPU6050_REG_SMPLRT 0x19u
+#define MPU6050_REG_CONFIG 0x1Au
+#define MPU6050_REG_GYROCFG  0x1Bu
+#define MPU6050_REG_ACCELCFG 0x1Cu
+#define MPU6050_REG_MOT_THR  0x1Fu
+#define MPU6050_REG_MOT_DUR  0x20u
+#define MPU6050_REG_FIFO_EN  0x23u
+#define MPU6050_REG_INT_PIN_CFG 0x37u
+#define MPU6050_REG_INT_ENABLE  0x38u
+#define MPU6050_REG_INT_STATUS 0x3Au
+#define MPU6050_REG_USER_CTRL  0x6Au
+#define MPU6050_REG_PWR2       0x6Cu
+#define MPU6050_REG_BANK_SEL   0x6Du   /* memória do DMP: banco de 256 B   */
+#define MPU6050_REG_MEM_START  0x6Eu   /*   endereço dentro do banco       */
+#define MPU6050_REG_MEM_RW     0x6Fu   /*   porta (incrementa o endereço)  */
+#define MPU6050_REG_PRGM_START 0x70u   /*   início do programa (16 bits)   */
+#define MPU6050_REG_FIFO_COUNT 0x72u
+#define MPU6050_REG_FIFO_RW    0x74u
+
+typedef struct {
+    int16_t ax, ay, az;
+    int16_t gx, gy, gz;
+    int16_t temp_raw;
+} mpu6050_raw_t;
+
+/* Amostra com o instante de aquisição (drv_cycles64(), ver drv_time.h).
+   É o que deve andar por filas/telemetria: dt = drv_cyc_to_s(b.t - a.t). */
+typedef struct {
+    mpu6050_raw_t raw;
+    uint64_t      t_cyc;
+} mpu6050_sample_t;
+
+/* Funções sem handle: instância mpu6050_main (MPU6050_ADDR por padrão, ou
+   o endereço passado a mpu6050_dev_init). Outras instâncias: ver
+   "Instâncias" abaixo. FIFO, DATA_RDY e wake-on-motion são só da main
+   (um pino de INT). */
+int  mpu6050_init(void);
+int  mpu6050_read_all(mpu6050_raw_t *out);
+/* read_all carimbada no início da leitura */
+int  mpu6050_read_sample(mpu6050_sample_t *out);
+
+/* Leitura não bloqueante do bloco ACCEL..GYRO (14 bytes) pela fila do I2C
+   (requer i2c1_async_init). 'done' roda no ISR com a.buf cheio; depois
+   é só chamar mpu6050_decode(). A struct deve viver até o fim. */
+typedef struct {
+    i2c1_xfer_t xfer;
+    uint8_t     buf[14];
+} mpu6050_async_t;
+
+int  mpu6050_read_start(mpu6050_async_t *a, i2c1_done_fn done, void *arg);
+/* buf pode ser o próprio 'out' (decodificação in-place) */
+void mpu6050_decode(const uint8_t *buf, mpu6050_raw_t *out);
+
+/* ============================ Taxa / DLPF ============================ */
+/* rate_hz: 4..1000 (SMPLRT_DIV = taxa do giro / rate - 1).
+   dlpf_cfg 0..6 (CONFIG): 0=260 Hz 1=184 2=94 3=44 4=21 5=10 6=5 Hz.
+   Com dlpf 0 o giro amostra a 8 kHz; nos demais a 1 kHz.
+   O divisor é inteiro: get_rate() trunca (30 pedidos = 30.30 Hz reais, lê
+   30); para dt use get_rate_mhz() (30303). */
+int      mpu6050_set_rate(uint16_t rate_hz, uint8_t dlpf_cfg);
+uint16_t mpu6050_get_rate(void);
+uint32_t mpu6050_get_rate_mhz(void);
+uint8_t  mpu6050_get_dlpf(void);
+
+/* =============================== FIFO ================================ */
+/* Quadros de 14 bytes na mesma ordem do burst (ACCEL, TEMP, GYRO), então
+   cabem direto num mpu6050_raw_t. 1024 bytes = 73 quadros: a 1 kHz dá
+   para drenar a cada ~70 ms sem estourar. */
+#define MPU6050_FIFO_FRAME  14u
+#define MPU6050_FIFO_SIZE   1024u
+
+typedef struct {
+    uint32_t samples;     /* quadros entregues                    */
+    uint32_t overflows;   /* FIFO_OFLOW visto (amostras perdidas) */
+    uint32_t resyncs;     /* resets da FIFO (overflow/desalinho)  */
+} mpu6050_fifo_stats_t;
+
+/* Zera e liga a FIFO para accel+temp+gyro. */
+int  mpu6050_fifo_start(void);
+int  mpu6050_fifo_stop(void);
+/* Drena até 'max' amostras igualmente espaçadas (1/rate) em out[], mais
+   antiga primeiro. Retorna quantas (0 = vazia ou ressincronizou), -1 erro. */
+int  mpu6050_fifo_read(mpu6050_raw_t *out, uint32_t max);
+/* Instante estimado de out[i] do último mpu6050_fifo_read: a mais nova
+   na FIFO é datada na leitura do FIFO_COUNT e as anteriores recuam um
+   período (1/rate) cada. */
+uint64_t mpu6050_fifo_sample_time(uint32_t i);
+const mpu6050_fifo_stats_t *mpu6050_fifo_get_stats(void);
+
+/* ====================== Interrupção DATA_RDY ========================= */
+/* INT (ativo alto, push-pull, pulso de 50 us) a cada amostra nova, ligado
+   na EXTI de MPU6050_INT_PORT/PIN (borda de subida). O ISR só guarda o
+   drv_cycles64() do instante e acorda a task; a leitura I2C fica com ela.
+   A taxa é a de mpu6050_set_rate(). */
+typedef struct {
+    volatile uint32_t edges;   /* bordas vistas no ISR                    */
+    uint32_t missed;           /* amostras que chegaram sem serem esperadas */
+} mpu6050_drdy_stats_t;
+
+/* task: TaskHandle_t notificada no índice MPU6050_DRDY_NOTIFY_INDEX
+   (-DDRIVERS_FREERTOS); NULL = espera por polling. */
+int  mpu6050_drdy_init(void *task);
+int  mpu6050_drdy_stop(void);
+/* Espera a próxima amostra. 1 = chegou (*t_cyc = instante da borda, pode
+   ser NULL), 0 = timeout. Com várias pendentes, conta as extras em missed
+   e devolve a mais recente. */
+int  mpu6050_drdy_wait(uint32_t timeout_ms, uint64_t *t_cyc);
+const mpu6050_drdy_stats_t *mpu6050_drdy_get_stats(void);
+
+/* ========================= Wake-on-motion ============================ */
+/* Sensor em modo ciclo: giros e temperatura desligados, o accel acorda a
+   lp_wake Hz, compara com a atitude parada (HPF congelado) e pulsa o INT
+   se passar de thr_mg por dur_ms. Usa o mesmo pino/EXTI/notificação do
+   DATA_RDY (que fica desligado: religar com mpu6050_drdy_init depois). */
+#define MPU6050_LP_WAKE_1HZ25  0u
+#define MPU6050_LP_WAKE_5HZ    1u
+#define MPU6050_LP_WAKE_20HZ   2u
+#define MPU6050_LP_WAKE_40HZ   3u
+
+int  mpu6050_wom_enter(void *task, uint16_t thr_mg, uint8_t dur_ms, uint8_t lp_wake);
+/* 1 = movimento, 0 = timeout (o sensor continua em modo ciclo). */
+int  mpu6050_wom_wait(uint32_t timeout_ms);
+/* Volta ao modo normal (giros levam ~30 ms para assentar). */
+int  mpu6050_wom_exit(void);
+
+/* ============================== Escalas ============================== */
+/* Fundo de escala escolhido em tempo de execução; o driver guarda a escala
+   ativa e os fatores de conversão já calculados. Padrão após init: ±2 g e
+   ±250 dps. Cada passo dobra o fundo de escala (e o valor de 1 LSB). */
+#define MPU6050_ACCEL_2G      0u
+#define MPU6050_ACCEL_4G      1u
+#define MPU6050_ACCEL_8G      2u
+#define MPU6050_ACCEL_16G     3u
+#define MPU6050_GYRO_250DPS   0u
+#define MPU6050_GYRO_500DPS   1u
+#define MPU6050_GYRO_1000DPS  2u
+#define MPU6050_GYRO_2000DPS  3u
+
+typedef struct {
+    uint8_t  afs, fs;          /* AFS_SEL / FS_SEL ativos                  */
+    int32_t  accel_mg_q16;     /* mg por LSB, Q16 (4000 << afs, exato)     */
+    int32_t  gyro_mdps_q16;    /* mdps por LSB, Q16 (1000/131 << fs)       */
+    float    accel_g_lsb;      /* g por LSB                                */
+    float    gyro_dps_lsb;     /* °/s por LSB                              */
+} mpu6050_scale_t;
+
+/* ============================= Instâncias ============================ */
+/* Um MPU6050 no barramento: endereço (0x68 com AD0=GND, 0x69 com AD0=VCC),
+   prioridade dos bursts e escala ativa. */
+typedef struct {
+    i2c1_dev_t      bus;
+    mpu6050_scale_t scale;     /* só leitura fora do driver */
+} mpu6050_t;
+
+extern mpu6050_t mpu6050_main;
+#define mpu6050_scale (mpu6050_main.scale)
+
+/* Acorda e configura como mpu6050_init (-1 se ninguém responde em addr7). */
+int  mpu6050_dev_init(mpu6050_t *m, uint8_t addr7);
+int  mpu6050_dev_read(mpu6050_t *m, mpu6050_raw_t *out);
+int  mpu6050_dev_read_start(mpu6050_t *m, mpu6050_async_t *a, i2c1_done_fn done, void *arg);
+int  mpu6050_dev_set_accel_range(mpu6050_t *m, uint8_t afs);
+int  mpu6050_dev_set_gyro_range(mpu6050_t *m, uint8_t fs);
+
+int  mpu6050_set_accel_range(uint8_t afs);
+int  mpu6050_set_gyro_range(uint8_t fs);
+
+/* Auto-escala: alarga na hora se algum eixo encosta no fundo
+   (|raw| >= MPU6050_AUTORANGE_SAT) e estreita depois de 'hold' amostras
+   seguidas abaixo de MPU6050_AUTORANGE_LOW (já dobradas, ficam longe da
+   saturação). Accel e giro independentes, entre min e max. */
+#define MPU6050_AUTORANGE_SAT  32000
+#define MPU6050_AUTORANGE_LOW  12000
+
+typedef struct {
+    uint8_t  min_afs, max_afs;
+    uint8_t  min_fs,  max_fs;
+    uint16_t hold;
+    uint16_t acc_small, gyr_small;   /* contagem de amostras pequenas */
+    uint32_t changes;
+} mpu6050_autorange_t;
+
+void mpu6050_autorange_init(mpu6050_autorange_t *a, uint16_t hold);
+/* Chamar com cada amostra lida (já convertida, se for o caso: a escala
+   muda para as próximas). 1 = escala mudou, 0 = igual, -1 = erro I2C.
+   Não misturar com a FIFO: quadros já enfileirados ficam na escala velha. */
+int  mpu6050_autorange(mpu6050_autorange_t *a, const mpu6050_raw_t *r);
+
+/* Conversões na escala ativa */
+static inline float mpu6050_accel_g(int16_t raw) { return raw * mpu6050_scale.accel_g_lsb; }
+static inline float mpu6050_gyro_dps(int16_t raw) { return raw * mpu6050_scale.gyro_dps_lsb; }
+static inline float mpu6050_temp_c(int16_t raw) { return (raw/340.0f) + 36.53f; }
+static inline int32_t mpu6050_accel_mg(int16_t raw) {
+    return (int32_t)(((int64_t)raw * mpu6050_scale.accel_mg_q16) >> 16);
+}
+static inline int32_t mpu6050_gyro_mdps(int16_t raw) {
+    return (int32_t)(((int64_t)raw * mpu6050_scale.gyro_mdps_q16) >> 16);
+}
+/* Em contagens de ±2 g / ±250 dps (1 g = 16384), qualquer que seja a escala
+   ativa: limiares e telemetria em LSB continuam valendo, sem saturar. */
+static inline int32_t mpu6050_dev_accel_base(const mpu6050_t *m, int32_t raw) { return raw * (int32_t)(1u << m->scale.afs); }
+static inline int32_t mpu6050_dev_gyro_base(const mpu6050_t *m, int32_t raw)  { return raw * (int32_t)(1u << m->scale.fs); }
+static inline int32_t mpu6050_accel_base(int32_t raw) { return mpu6050_dev_accel_base(&mpu6050_main, raw); }
+static inline int32_t mpu6050_gyro_base(int32_t raw)  { return mpu6050_dev_gyro_base(&mpu6050_main, raw); }
+
+#endif
@@ -0,0 +1,140 @@
+#pragma once
+/* Calibração de 6 eixos do MPU6050 com compensação linear de temperatura.
+
+   Modelo por eixo (LSB brutos, t = temp_raw):
+       off(t)  = off + tc * (t - t_ref)
+       accel   = (raw - off(t)) * escala       giro = raw - off(t)
+
+   Estimação (fora do caminho quente, pode usar float):
+   - giro: média com a placa parada (mpu6050_cal_set_still);
+   - accel: 6 posições, cada face para cima uma vez (mpu6050_cal6_*):
+     off = (+1g + -1g)/2, escala = 2g / (+1g - -1g);
+   - tc: regressão de cada eixo contra temp_raw com a placa parada
+     enquanto esquenta (mpu6050_cal_tc_*).
+
+   Aplicação: mpu6050_cal_apply(), só inteiros (Q16 no tc, Q14 na escala),
+   inline: poucas dezenas de ciclos por amostra. */
+#include <stdint.h>
+#include "mpu6050.h"
+
+#define MPU6050_CAL_ONE_G   16384   /* ±2 g; offsets valem na escala em que foram medidos */
+
+typedef struct {
+    int16_t off[6];        /* ax ay az gx gy gz em t_ref             */
+    int16_t scale_q14[3];  /* ganho do accel, 16384 = 1.0            */
+    int32_t tc_q16[6];     /* LSB do eixo por LSB de temp_raw, Q16,
+                              limitado a ±0.25 (tc*dt cabe em 32 bits) */
+    int16_t t_ref;         /* temp_raw da calibração                 */
+} mpu6050_cal_t;
+
+/* Sem correção (off 0, escala 1, tc 0). */
+void mpu6050_cal_identity(mpu6050_cal_t *c);
+
+/* ------------------------------ Média ------------------------------- */
+typedef struct {
+    int32_t  sum[7];       /* ax ay az gx gy gz temp */
+    uint16_t n;
+} mpu6050_cal_avg_t;
+
+static inline void mpu6050_cal_avg_add(mpu6050_cal_avg_t *a, const mpu6050_raw_t *s) {
+    a->sum[0] += s->ax; a->sum[1] += s->ay; a->sum[2] += s->az;
+    a->sum[3] += s->gx; a->sum[4] += s->gy; a->sum[5] += s->gz;
+    a->sum[6] += s->temp_raw;
+    a->n++;
+}
+/* -1 se vazia */
+int  mpu6050_cal_avg_get(const mpu6050_cal_avg_t *a, mpu6050_raw_t *mean);
+
+/* Placa parada: viés do giro e t_ref passam a ser os da média. Os offsets
+   do accel são levados para o novo t_ref pelo tc (não perde a 6 posições). */
+void mpu6050_cal_set_still(mpu6050_cal_t *c, const mpu6050_raw_t *mean);
+
+/* ---------------------------- 6 posições ---------------------------- */
+typedef struct {
+    int16_t up[3];         /* média do eixo apontando para cima (+1 g)   */
+    int16_t down[3];       /* média do eixo apontando para baixo (-1 g)  */
+    int16_t temp[6];
+    uint8_t have;          /* bit f = face f já medida (f = 2*eixo + baixo) */
+} mpu6050_cal6_t;
+
+/* Identifica a face pela componente dominante (> 0.8 g, demais < 0.3 g) e
+   guarda. Retorna a face 0..5 (+X -X +Y -Y +Z -Z) ou -1 se a placa não
+   está alinhada a um eixo. */
+int  mpu6050_cal6_add(mpu6050_cal6_t *p, const mpu6050_raw_t *mean);
+static inline int mpu6050_cal6_done(const mpu6050_cal6_t *p) { return p->have == 0x3Fu; }
+/* Offsets e escalas do accel em c, levados ao c->t_ref (chamar depois de
+   set_still). -1 se faltam faces ou a escala sai de 0.5..1.5. */
+int  mpu6050_cal6_solve(const mpu6050_cal6_t *p, mpu6050_cal_t *c);
+
+/* ---------------------- Coeficiente de temperatura ------------------- */
+typedef struct {
+    uint32_t n;
+    int16_t  t0;           /* primeira temperatura (somas relativas a ela) */
+    int64_t  st, stt;
+    int64_t  sx[6], stx[6];
+} mpu6050_cal_tc_t;
+
+void mpu6050_cal_tc_add(mpu6050_cal_tc_t *a, const mpu6050_raw_t *s);
+/* Inclinação de cada eixo em c->tc_q16. -1 se a faixa de temperatura é
+   pequena demais (< min_span LSB de temp_raw; 340 LSB = 1 °C). */
+int  mpu6050_cal_tc_solve(const mpu6050_cal_tc_t *a, mpu6050_cal_t *c, uint16_t min_span);
+
+/* ---------------------------- Viés online ---------------------------- */
+/* Acompanha a deriva do viés (temperatura, envelhecimento) sem parar o
+   sistema: as amostras cruas entram em janelas de 'win'; uma janela é
+   "parada" se nenhuma amostra teve |giro corrigido| > gyro_max e a soma
+   das variâncias do accel ficou abaixo de acc_var_max. Janela parada puxa
+   os offsets do giro 1/2^shift em direção à média dela (levada a c->t_ref
+   pelo tc, então a compensação de temperatura continua valendo).
+   Com track_acc, o accel também: só se a média corrigida estiver a
+   acc_tol de acc_ref em cada eixo (ex.: carro no chão, Z para cima), o
+   que deixa de fora rampas e a placa inclinada.
+   Custo constante por amostra (somas e uma comparação); a divisão é uma
+   por janela. Contagens na escala ativa: reiniciar se ela mudar. */
+typedef struct {
+    uint16_t win;
+    uint8_t  shift;
+    uint8_t  track_acc;
+    int16_t  gyro_max;       /* LSB                                      */
+    int32_t  acc_var_max;    /* LSB², soma dos 3 eixos                   */
+    int16_t  acc_ref[3];     /* accel corrigido esperado parado          */
+    int16_t  acc_tol;        /* LSB                                      */
+    /* janela corrente */
+    int32_t  sum[7];         /* ax ay az gx gy gz temp                   */
+    int64_t  sq[3];
+    uint16_t n;
+    uint8_t  moving;
+    /* offsets em Q8 (acumulam frações de LSB entre janelas) */
+    int32_t  off_q8[6];
+    uint32_t windows, still, acc_updates;
+} mpu6050_bias_t;
+
+/* Padrões para a escala ativa (mpu6050_scale): janela de win amostras,
+   passo 1/8, giro < 2 °/s, desvio do accel ~10 mg por eixo, accel
+   desligado (acc_ref = +1 g em Z, tol 0.1 g, se ligar). */
+void mpu6050_bias_init(mpu6050_bias_t *b, const mpu6050_cal_t *c, uint16_t win);
+/* Amostra crua (antes de mpu6050_cal_apply). Retorna 1 quando fechou uma
+   janela parada e atualizou c, 0 nos demais casos. */
+int  mpu6050_bias_add(mpu6050_bias_t *b, mpu6050_cal_t *c, const mpu6050_raw_t *raw);
+
+/* --------------------------- Caminho quente -------------------------- */
+static inline int16_t mpu6050_cal_sat16(int32_t v) {
+    return (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+}
+
+static inline int16_t mpu6050_cal_axis(const mpu6050_cal_t *c, int i, int16_t raw, int32_t dt) {
+    int32_t x = (int32_t)raw - (c->off[i] + ((c->tc_q16[i] * dt) >> 16));
+    if (i < 3) x = (x * c->scale_q14[i]) >> 14;
+    return mpu6050_cal_sat16(x);
+}
+
+/* Corrige no lugar. temp_raw fica como está. */
+static inline void mpu6050_cal_apply(const mpu6050_cal_t *c, mpu6050_raw_t *s) {
+    int32_t dt = (int32_t)s->temp_raw - c->t_ref;
+    s->ax = mpu6050_cal_axis(c, 0, s->ax, dt);
+    s->ay = mpu6050_cal_axis(c, 1, s->ay, dt);
+    s->az = mpu6050_cal_axis(c, 2, s->az, dt);
+    s->gx = mpu6050_cal_axis(c, 3, s->gx, dt);
+    s->gy = mpu6050_cal_axis(c, 4, s->gy, dt);
+    s->gz = mpu6050_cal_axis(c, 5, s->gz, dt);
+}
@@ -0,0 +1,71 @@
+#pragma once
+/* DMP (Digital Motion Processor) do MPU6050: o próprio sensor funde giro e
+   accel e põe na FIFO um quatérnio por amostra (200 Hz típico). O MCU só
+   lê o pacote: nada de ahrs_update por amostra. No barramento não se
+   ganha: 16 B por atualização (só quatérnio) contra 14 B do quadro cru,
+   ou 28 B com accel e giro juntos.
+
+   A imagem do DMP não vem aqui: é o binário da InvenSense (Motion Driver
+   6.12, dmp_memory[] em inv_mpu_dmp_motion_driver.c: 3062 B, início
+   0x0400), distribuído sob a licença deles. A aplicação aponta
+   mpu6050_dmp_image_t para ela e, se a imagem pedir, inclui os patches de
+   configuração (taxa, recursos) na lista 'patch'.
+
+   Modos: mpu6050_dmp_start() liga o DMP (200 Hz, ±2000 dps, ±2 g, que é o
+   que a imagem espera); mpu6050_dmp_stop() volta ao modo cru com as
+   escalas de antes. A FIFO é do DMP enquanto ele estiver ligado:
+   mpu6050_fifo_* e wake-on-motion ficam para o modo cru. */
+#include <stdint.h>
+#include "mpu6050.h"
+#include "ahrs.h"
+
+/* Layout do pacote na FIFO (big-endian): quatérnio w x y z em Q30 e,
+   no formato longo, accel e giro crus logo depois. */
+#define MPU6050_DMP_QUAT      16u    /* só quatérnio                       */
+#define MPU6050_DMP_QUAT_RAW  28u    /* quatérnio + accel + giro (MD 6.12) */
+
+#define MPU6050_DMP_RATE_HZ   200u
+
+typedef struct {
+    uint16_t addr;               /* endereço na memória do DMP             */
+    uint8_t  len;
+    const uint8_t *data;
+} mpu6050_dmp_patch_t;
+
+typedef struct {
+    const uint8_t *code;
+    uint16_t size;
+    uint16_t start_addr;         /* PRGM_START                              */
+    uint8_t  packet_len;         /* MPU6050_DMP_QUAT ou _QUAT_RAW           */
+    uint8_t  n_patch;
+    const mpu6050_dmp_patch_t *patch;
+} mpu6050_dmp_image_t;
+
+typedef struct {
+    int32_t q[4];                /* w x y z, Q30 (1.0 = 1 << 30)            */
+    int16_t accel[3];            /* só no pacote longo (senão 0)            */
+    int16_t gyro[3];
+} mpu6050_dmp_packet_t;
+
+typedef struct {
+    uint32_t packets;
+    uint32_t overflows;
+    uint32_t resyncs;            /* FIFO zerada (estouro/desalinho)         */
+    uint32_t bytes;              /* lidos do barramento, cabeçalhos inclusos */
+} mpu6050_dmp_stats_t;
+
+/* Memória do DMP em blocos de até 16 B sem cruzar banco. */
+int  mpu6050_dmp_mem_write(uint16_t addr, const uint8_t *d, uint16_t n);
+int  mpu6050_dmp_mem_read(uint16_t addr, uint8_t *d, uint16_t n);
+/* Sobe a imagem, confere lendo de volta, aplica os patches e grava
+   PRGM_START. -1 se algo não bater (o DMP não é ligado). */
+int  mpu6050_dmp_load(const mpu6050_dmp_image_t *img);
+int  mpu6050_dmp_start(void);
+int  mpu6050_dmp_stop(void);
+int  mpu6050_dmp_active(void);
+/* Como mpu6050_fifo_read, em pacotes: até 'max', mais antigo primeiro.
+   0 = nada ou ressincronizou, -1 erro. */
+int  mpu6050_dmp_read(mpu6050_dmp_packet_t *out, uint32_t max);
+/* Quatérnio do pacote direto no ahrs_t (ahrs_tilt/ahrs_gravity valem). */
+void mpu6050_dmp_to_ahrs(const mpu6050_dmp_packet_t *p, ahrs_t *a);
+const mpu6050_dmp_stats_t *mpu6050_dmp_get_stats(void);
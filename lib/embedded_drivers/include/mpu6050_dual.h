@@ -0,0 +1,42 @@
+#pragma once
+/* Dois MPU6050 no mesmo barramento (0x68 e 0x69, ex.: chassi e direção)
+   lidos numa passada só: os dois bursts de 14 bytes entram juntos na fila
+   do I2C, saem em sequência no fio e a task acorda uma vez.
+
+   Cada amostra é datada no START da própria transação (o sensor congela
+   os registros para o burst ali), então o skew entre as duas é o
+   intervalo real de aquisição: ~1 transação (14 B a 400 kHz ~ 0.4 ms),
+   mais o que a fila tiver atrasado a segunda. */
+#include <stdint.h>
+#include "mpu6050.h"
+
+/* Registro combinado: o que vai para a fila do detector de eventos. */
+typedef struct {
+    mpu6050_raw_t raw[2];
+    uint64_t      t_cyc[2];      /* drv_cycles64() de cada leitura        */
+    uint8_t       ok;            /* bit i = raw[i] válido                 */
+} mpu6050_dual_sample_t;
+
+typedef struct {
+    uint32_t n;                  /* pares completos                       */
+    uint32_t fail[2];            /* leituras perdidas por sensor          */
+    uint32_t skew_last_cyc;
+    uint32_t skew_min_cyc, skew_max_cyc;
+    uint64_t skew_sum_cyc;
+} mpu6050_dual_stats_t;
+
+typedef struct {
+    mpu6050_t   *imu[2];         /* imu[1] = NULL: só um sensor           */
+    i2c1_xfer_t  xfer[2];
+    uint8_t      buf[2][14];
+    uint64_t     t[2];
+    mpu6050_dual_stats_t stats;
+} mpu6050_dual_t;
+
+/* a e b já inicializados (mpu6050_dev_init); b pode ser NULL. */
+void mpu6050_dual_init(mpu6050_dual_t *d, mpu6050_t *a, mpu6050_t *b);
+/* 0 = todos os sensores presentes leram, -1 = algum falhou (ver out->ok). */
+int  mpu6050_dual_read(mpu6050_dual_t *d, mpu6050_dual_sample_t *out);
+void mpu6050_dual_reset_stats(mpu6050_dual_t *d);
+/* skew último/mín/médio/máx em us + falhas, no printf */
+void mpu6050_dual_print(const mpu6050_dual_t *d);
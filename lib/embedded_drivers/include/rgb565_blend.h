@@ -0,0 +1,43 @@
+#pragma once
+#include <stdint.h>
+
+/* Alpha em 5 bits: 0 = só fundo, 32 = só cor de frente. */
+#define BLEND_A_MAX 32u
+
+/* Converte alpha 0..255 para a escala de 5 bits usada nos kernels rápidos. */
+static inline uint32_t blend_a5(uint8_t a8){ return ((uint32_t)a8 + 4u) >> 3; }
+
+/* Mistura de 1 pixel no layout expandido 0x07E0F81F:
+   G vai para os bits 21..26 e R/B ficam na metade baixa com folga,
+   então um único MUL mistura os três canais. a5: 0..32 */
+static inline uint16_t rgb565_blend(uint16_t fg, uint16_t bg, uint32_t a5){
+    uint32_t f = (fg | ((uint32_t)fg << 16)) & 0x07E0F81Fu;
+    uint32_t b = (bg | ((uint32_t)bg << 16)) & 0x07E0F81Fu;
+    b += ((f - b) * a5) >> 5;
+    b &= 0x07E0F81Fu;
+    return (uint16_t)(b | (b >> 16));
+}
+
+/* Referência escalar canal a canal (alpha 0..255, com divisão). Só p/ validar e medir. */
+uint16_t rgb565_blend_ref(uint16_t fg, uint16_t bg, uint8_t alpha);
+
+/* ======================= Kernels sobre buffers ===================== */
+/* Os buffers guardam pixels RGB565 nativos (mesma ordem que o DMA manda ao LCD).
+   Os kernels processam 2 pixels por palavra de 32 bits (buffer alinhado em 4). */
+
+/* Cor sólida 'fg' com alpha constante sobre n pixels. */
+void rgb565_blend_span(uint16_t *dst, uint32_t n, uint16_t fg, uint32_t a5);
+/* Cor sólida 'fg' com cobertura por pixel (cov[i] 0..32). */
+void rgb565_blend_span_cov(uint16_t *dst, uint32_t n, uint16_t fg, const uint8_t *cov);
+/* Média exata 50% com 'fg' (sem multiplicação). */
+void rgb565_blend_span_half(uint16_t *dst, uint32_t n, uint16_t fg);
+
+/* ==================== Primitivas anti-aliased ====================== */
+/* Desenham em um buffer w x h (stride = w). Coordenadas relativas ao buffer,
+   podem cair fora dele (recorte feito aqui). */
+void rgb565_fill_circle_aa(uint16_t *buf, int w, int h, int cx, int cy, int r, uint16_t color);
+void rgb565_draw_line_aa(uint16_t *buf, int w, int h, int x0, int y0, int x1, int y1, uint16_t color);
+
+/* Mede ciclos/pixel (DWT CYCCNT no alvo, relógio do host no nativo) da
+   referência escalar vs. kernels e imprime no printf. No alvo requer delay_init(). */
+void rgb565_blend_bench(void);
@@ -0,0 +1,91 @@
+#ifndef SERIAL_STDIO_H
+#define SERIAL_STDIO_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Inicializa a USART de stdio (padrão USART1 PA9/PA10, AF7) e redireciona printf/puts/printf… via _write()
+// Ex.: serial_stdio_init(115200);
+void serial_stdio_init(uint32_t baud);
+
+// Só a USART (sem mexer no stdout)
+void serial_init(uint32_t baud);
+
+// Escreve string terminada em '\0' ('\n' -> CRLF; polling ou anel, ver abaixo)
+void serial_write(const char *s);
+
+// Opcional: acesso bruto a TX/RX
+void serial_putc(uint8_t c);
+int  serial_tx_done(void);        // 1 = transmissão finalizada (anel vazio e TC=1)
+
+/* ===================== TX por DMA (anel) ===================== */
+/* Depois de serial_tx_async_init(), printf/serial_write/serial_putc só
+   copiam para um anel de STDIO_TX_RING_SIZE bytes e voltam; o DMA
+   (STDIO_TX_DMA_*) manda trechos contíguos do anel e o ISR libera a
+   primeira metade do trecho no HT e o resto no TC, já emendando o
+   próximo. Um printf de uma linha deixa de custar ~5 ms a 115200.
+   Política quando o anel não tem espaço: */
+#define SERIAL_TX_DROP       0u  // descarta o que não couber do texto novo
+#define SERIAL_TX_BLOCK      1u  // espera o DMA liberar (em ISR/IRQ desligada: descarta)
+#define SERIAL_TX_OVERWRITE  2u  // descarta a fila ainda não entregue ao DMA e põe o novo
+
+typedef struct {
+    uint32_t bytes;        // aceitos no anel (com os '\r' do CRLF)
+    uint32_t dropped;      // do texto novo, descartados
+    uint32_t discarded;    // da fila antiga, descartados (OVERWRITE)
+    uint32_t waits;        // vezes que BLOCK teve de esperar
+    uint32_t chunks;       // trechos de DMA
+    uint32_t high_water;   // pico de ocupação do anel
+} serial_tx_stats_t;
+
+void serial_tx_async_init(uint8_t policy);
+void serial_tx_set_policy(uint8_t policy);
+int  serial_tx_async_enabled(void);
+// Bytes crus, sem CRLF, entram no anel inteiros ou não entram (quadros
+// binários, ver dlog.h). Retorna n, ou 0 se descartou. Sem o anel, polling.
+int  serial_write_raw(const void *buf, size_t n);
+// Espera o anel esvaziar e o último byte sair (antes de dormir/resetar).
+void serial_flush(void);
+const serial_tx_stats_t *serial_tx_get_stats(void);
+int  serial_readable(void);       // 1 = há byte disponível (RXNE=1 ou anel não vazio)
+int  serial_getc_blocking(void);  // lê 1 byte (bloqueante)
+
+/* ================= RX por DMA circular + IDLE (anel) ================= */
+/* Depois de serial_rx_async_init(), o DMA (STDIO_RX_DMA_*) copia cada byte
+   para um anel de STDIO_RX_RING_SIZE bytes sem passar pela CPU: sem ISR
+   por byte, rajadas a 921600 não dão overrun (ORE) nem com o laço
+   principal ocupado. O IRQ de IDLE (linha parada 1 caractere) marca o fim
+   de cada rajada (quadro). O anel só perde dados se a aplicação ficar mais
+   de uma volta sem ler (contado em overflows).
+   Leituras não bloqueantes; o _read() do scanf/fgets bloqueia até chegar
+   algo. */
+typedef struct {
+    uint32_t bytes;        // recebidos pelo DMA
+    uint32_t frames;       // rajadas fechadas por IDLE
+    uint32_t lines;        // linhas entregues por serial_read_line
+    uint32_t overflows;    // bytes perdidos: o DMA deu a volta no leitor
+    uint32_t ore;          // overrun na USART (DMA não atendeu a tempo)
+    uint32_t errors;       // ruído / erro de quadro
+    uint32_t high_water;   // pico de ocupação do anel
+} serial_rx_stats_t;
+
+void serial_rx_async_init(void);
+int  serial_rx_async_enabled(void);
+int  serial_available(void);                        // bytes esperando leitura
+// Até max bytes do que já chegou; 0 = nada.
+int  serial_read(void *buf, size_t max);
+// Uma rajada completa (até o IDLE); maior que max sai em pedaços. 0 = nenhuma.
+int  serial_read_frame(void *buf, size_t max);
+// Uma linha completa ('\n', '\r' ou "\r\n"), sem o terminador e com '\0'.
+// Linhas vazias são puladas; linha maior que max-1 sai cortada. 0 = nenhuma.
+int  serial_read_line(char *buf, size_t max);
+const serial_rx_stats_t *serial_rx_get_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,95 @@
+#pragma once
+/* Fila circular sem trava para 1 produtor e 1 consumidor (ISR -> task,
+   task -> task). Nenhuma chamada ao kernel nem seção crítica: cada índice
+   tem um único escritor, publicado com release e lido com acquire.
+
+   - Capacidade potência de 2 (índices livres, "& mask" em vez de %).
+   - head/tail em linhas separadas (SPSC_ALIGN): no host evita que
+     produtor e consumidor disputem a mesma linha de cache; no F411 (sem
+     cache de dados) só custa alguns bytes.
+   - Cheia: o item novo é descartado e contado em 'overflows' (nada some
+     em silêncio).
+   - Cópia zero: spsc_write_ptr()/spsc_commit() escrevem direto no slot;
+     spsc_read_span()/spsc_release() entregam um trecho contíguo inteiro
+     para leitura em lote. */
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#ifndef SPSC_ALIGN
+#define SPSC_ALIGN 32
+#endif
+
+typedef struct {
+    _Alignas(SPSC_ALIGN) atomic_uint head;   /* só o produtor escreve   */
+    uint32_t overflows;                      /* itens descartados       */
+    uint32_t high_water;                     /* maior ocupação vista    */
+    _Alignas(SPSC_ALIGN) atomic_uint tail;   /* só o consumidor escreve */
+    _Alignas(SPSC_ALIGN) uint8_t *buf;       /* só leitura após init    */
+    uint32_t esz;
+    uint32_t mask;
+} spsc_t;
+
+/* buf com n * esz bytes; n potência de 2 (>= 2). 0 ok, -1 inválido. */
+int spsc_init(spsc_t *q, void *buf, uint32_t esz, uint32_t n);
+
+static inline uint32_t spsc_capacity(const spsc_t *q){ return q->mask + 1u; }
+
+/* Ocupação vista por qualquer lado (aproximada se o outro lado mexe). */
+static inline uint32_t spsc_count(spsc_t *q){
+    return atomic_load_explicit(&q->head, memory_order_acquire) -
+           atomic_load_explicit(&q->tail, memory_order_acquire);
+}
+
+/* ----------------------------- produtor ----------------------------- */
+/* Slot livre para escrever no lugar, ou NULL se cheia (conta overflow). */
+static inline void *spsc_write_ptr(spsc_t *q){
+    uint32_t h = atomic_load_explicit(&q->head, memory_order_relaxed);
+    uint32_t t = atomic_load_explicit(&q->tail, memory_order_acquire);
+    if (h - t > q->mask){ q->overflows++; return 0; }
+    return q->buf + (h & q->mask) * q->esz;
+}
+
+/* Publica o slot de spsc_write_ptr(). */
+static inline void spsc_commit(spsc_t *q){
+    uint32_t h = atomic_load_explicit(&q->head, memory_order_relaxed) + 1u;
+    uint32_t used = h - atomic_load_explicit(&q->tail, memory_order_relaxed);
+    if (used > q->high_water) q->high_water = used;
+    atomic_store_explicit(&q->head, h, memory_order_release);
+}
+
+/* Cópia + commit. 0 ok, -1 cheia. */
+static inline int spsc_push(spsc_t *q, const void *item){
+    uint8_t *d = (uint8_t *)spsc_write_ptr(q);
+    if (!d) return -1;
+    memcpy(d, item, q->esz);
+    spsc_commit(q);
+    return 0;
+}
+
+/* ---------------------------- consumidor ---------------------------- */
+/* Trecho contíguo legível a partir do mais antigo (para na volta do
+   buffer: chamar de novo depois do release pega o resto). */
+static inline uint32_t spsc_read_span(spsc_t *q, void **p){
+    uint32_t t = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    uint32_t n = atomic_load_explicit(&q->head, memory_order_acquire) - t;
+    uint32_t i = t & q->mask;
+    if (n > spsc_capacity(q) - i) n = spsc_capacity(q) - i;
+    *p = q->buf + i * q->esz;
+    return n;
+}
+
+/* Devolve n itens lidos ao produtor. */
+static inline void spsc_release(spsc_t *q, uint32_t n){
+    uint32_t t = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    atomic_store_explicit(&q->tail, t + n, memory_order_release);
+}
+
+/* Cópia de 1 item. 0 ok, -1 vazia. */
+static inline int spsc_pop(spsc_t *q, void *item){
+    void *p;
+    if (spsc_read_span(q, &p) == 0) return -1;
+    memcpy(item, p, q->esz);
+    spsc_release(q, 1);
+    return 0;
+}
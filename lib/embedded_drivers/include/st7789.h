@@ -1,9 +1,13 @@
 #pragma once
 #include <stdint.h>
-#include "board.h"
+#include "drivers_config.h"
 
 void st7789_init(void);
 
+/* Repouso: backlight off + DISPOFF/SLPIN (on=1); on=0 volta com o
+   conteúdo da RAM do painel intacto. */
+void st7789_sleep(uint8_t on);
+
 /* alterar o prescaler após init  br_div: 0:/2 1:/4 2:/8 3:/16 4:/32 5:/64 6:/128 7:/256 */
 void st7789_set_speed_div(uint8_t br_div);
 
@@ -14,6 +18,8 @@ void st7789_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t c
 /* Versões DMA */
 void st7789_fill_screen_dma(uint16_t color);
 void st7789_fill_rect_dma(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+/* Copia buffer RGB565 w x h (row-major) para a janela via DMA */
+void st7789_blit(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *buf);
 
 /* GFX adicionais */
 void st7789_draw_pixel(uint16_t x, uint16_t y, uint16_t color);
@@ -26,3 +32,9 @@ void st7789_fill_circle(int x0, int y0, int r, uint16_t color);
 
 /* Texto 5x7 com escala; fundo opcional quando bg_enable != 0 */
 void st7789_draw_text_5x7(int x, int y, const char* s, uint16_t fg, int scale, int bg_enable, uint16_t bg);
+
+/* Anti-aliased: o LCD não é lido de volta, então a borda é misturada com 'bg' */
+void st7789_fill_circle_aa(int x0, int y0, int r, uint16_t color, uint16_t bg);
+void st7789_draw_line_aa(int x0, int y0, int x1, int y1, uint16_t color, uint16_t bg);
+/* Texto 5x7 com degraus suavizados (scale <= 4; acima disso cai no normal) */
+void st7789_draw_text_5x7_aa(int x, int y, const char* s, uint16_t fg, int scale, uint16_t bg);
@@ -0,0 +1,91 @@
+#pragma once
+/* Profiler do display: bytes no SPI, janelas (CASET/RASET/RAMWR) e tempo de
+   DMA por quadro, medidos com DWT CYCCNT (drv_cycles()).
+
+   Ligar com -DST7789_PROFILE. Sem a flag, as macros somem e as funções
+   viram inline vazias: custo zero no driver.
+
+   Uso típico na task de display (mesma task/mutex que desenha):
+       st7789_prof_frame_begin();
+       ... desenha ...
+       st7789_prof_frame_end();
+       st7789_prof_draw_overlay(ST7789_PROF_TOP_RIGHT);   // opcional
+
+   Os contadores acumulam todo o tráfego entre dois frame_end() (inclusive
+   o de outras tasks e o do próprio overlay), então a utilização é a carga
+   real do barramento no período. */
+#include <stdint.h>
+#include "drv_hal.h"
+
+#define ST7789_PROF_TOP_LEFT      0
+#define ST7789_PROF_TOP_RIGHT     1
+#define ST7789_PROF_BOTTOM_LEFT   2
+#define ST7789_PROF_BOTTOM_RIGHT  3
+
+#define ST7789_PROF_BINS 8
+
+typedef struct {
+    uint32_t frames;
+    /* último quadro */
+    uint32_t frame_cyc;        /* begin -> end                        */
+    uint32_t period_cyc;       /* end -> end                          */
+    uint32_t bytes;            /* bytes enviados no período           */
+    uint32_t windows;          /* set_addr no período                 */
+    uint32_t dma_cyc;          /* CPU esperando DMA no período        */
+    uint32_t spi_pct;          /* ocupação do fio SPI (0..100)        */
+    /* acumulado desde o reset */
+    uint32_t frame_min_cyc, frame_max_cyc;
+    uint64_t frame_sum_cyc;
+    /* histogramas:
+       frame_ms: [0,1) [1,2) [2,4) [4,8) [8,16) [16,32) [32,64) >=64 ms
+       fps:      <5 5-10 10-15 15-20 20-25 25-30 30-60 >=60
+       spi:      0-12 12-25 ... 87-100 % (passos de 12.5%) */
+    uint16_t hist_frame[ST7789_PROF_BINS];
+    uint16_t hist_fps[ST7789_PROF_BINS];
+    uint16_t hist_spi[ST7789_PROF_BINS];
+} st7789_prof_t;
+
+#ifdef ST7789_PROFILE
+
+/* Contadores do período corrente (só a task que desenha mexe neles). */
+typedef struct {
+    uint32_t bytes;
+    uint32_t windows;
+    uint32_t dma_cyc;
+} st7789_prof_cnt_t;
+
+extern st7789_prof_cnt_t st7789_prof_cnt;
+
+#define ST7789_PROF_BYTES(n)    (st7789_prof_cnt.bytes += (uint32_t)(n))
+#define ST7789_PROF_WINDOW()    (st7789_prof_cnt.windows++)
+#define ST7789_PROF_T0(t)       uint32_t t = drv_cycles()
+#define ST7789_PROF_DMA(t)      (st7789_prof_cnt.dma_cyc += drv_cycles() - (t))
+
+/* Prescaler atual do SPI (para converter bytes em tempo de fio). */
+void st7789_prof_set_div(uint8_t br_div);
+
+void st7789_prof_reset(void);
+void st7789_prof_frame_begin(void);
+void st7789_prof_frame_end(void);
+const st7789_prof_t *st7789_prof_get(void);
+/* Caixa ~84x36 no canto: tempo do quadro, FPS, SPI% e histograma do tempo. */
+void st7789_prof_draw_overlay(int corner);
+/* Resumo + histogramas no printf (UART). */
+void st7789_prof_print(void);
+
+#else
+
+#define ST7789_PROF_BYTES(n)    ((void)0)
+#define ST7789_PROF_WINDOW()    ((void)0)
+#define ST7789_PROF_T0(t)       ((void)0)
+#define ST7789_PROF_DMA(t)      ((void)0)
+
+static inline void st7789_prof_set_div(uint8_t br_div){ (void)br_div; }
+static inline void st7789_prof_reset(void){}
+static inline void st7789_prof_frame_begin(void){}
+static inline void st7789_prof_frame_end(void){}
+static inline const st7789_prof_t *st7789_prof_get(void){ return 0; }
+static inline void st7789_prof_draw_overlay(int corner){ (void)corner; }
+static inline void st7789_prof_print(void){}
+
+#endif
@@ -0,0 +1,23 @@
+#pragma once
+#include "stm32f4xx.h"
+
+/* Flags de stream do DMA do F4: streams 0..3 em LISR/LIFCR, 4..7 em HISR/HIFCR,
+   cada uma com 6 bits em posições 0, 6, 16, 22. Com 'n' constante tudo dobra. */
+#define DMA_FLAG_POS(n)  ((((n) & 3u) == 0u) ? 0u : (((n) & 3u) == 1u) ? 6u : \
+                          (((n) & 3u) == 2u) ? 16u : 22u)
+#define DMA_FLAG_TC(n)   (0x20u << DMA_FLAG_POS(n))
+#define DMA_FLAG_HT(n)   (0x10u << DMA_FLAG_POS(n))
+#define DMA_FLAG_TE(n)   (0x08u << DMA_FLAG_POS(n))
+#define DMA_FLAGS_ALL(n) (0x3Du << DMA_FLAG_POS(n))   /* TC|HT|TE|DME|FE */
+
+static inline uint32_t dma_isr(DMA_TypeDef *d, uint32_t n){
+    return (n < 4u) ? d->LISR : d->HISR;
+}
+static inline void dma_clear(DMA_TypeDef *d, uint32_t n, uint32_t flags){
+    if (n < 4u) d->LIFCR = flags; else d->HIFCR = flags;
+}
+/* Desliga a stream e espera o EN cair (obrigatório antes de reconfigurar). */
+static inline void dma_stream_off(DMA_Stream_TypeDef *s){
+    s->CR &= ~DMA_SxCR_EN;
+    while (s->CR & DMA_SxCR_EN);
+}
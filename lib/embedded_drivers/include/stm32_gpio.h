@@ -0,0 +1,29 @@
+#pragma once
+#include "stm32f4xx.h"
+
+/* Helpers de GPIO. Com porta/pino constantes (board.h) o compilador
+   reduz tudo a escritas diretas nos registradores. */
+#define GPIO_MODE_IN   0u
+#define GPIO_MODE_OUT  1u
+#define GPIO_MODE_AF   2u
+#define GPIO_MODE_AN   3u
+
+static inline void gpio_clk_enable(GPIO_TypeDef *p){
+    RCC->AHB1ENR |= 1u << (((uint32_t)p - GPIOA_BASE) >> 10);
+}
+static inline void gpio_mode(GPIO_TypeDef *p, uint32_t pin, uint32_t mode){
+    p->MODER = (p->MODER & ~(3u << (pin*2))) | (mode << (pin*2));
+}
+static inline void gpio_af(GPIO_TypeDef *p, uint32_t pin, uint32_t af){
+    uint32_t i = pin >> 3, s = (pin & 7u) * 4u;
+    p->AFR[i] = (p->AFR[i] & ~(0xFu << s)) | (af << s);
+}
+static inline void gpio_pull(GPIO_TypeDef *p, uint32_t pin, uint32_t pupd){
+    p->PUPDR = (p->PUPDR & ~(3u << (pin*2))) | (pupd << (pin*2));
+}
+static inline void gpio_speed(GPIO_TypeDef *p, uint32_t pin, uint32_t spd){
+    p->OSPEEDR = (p->OSPEEDR & ~(3u << (pin*2))) | (spd << (pin*2));
+}
+static inline void gpio_open_drain(GPIO_TypeDef *p, uint32_t pin){ p->OTYPER |= (1u << pin); }
+static inline void pin_set(GPIO_TypeDef* p, uint32_t pin){ p->BSRR = (1u << pin); }
+static inline void pin_clr(GPIO_TypeDef* p, uint32_t pin){ p->BSRR = (1u << (pin + 16)); }
@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <math.h>
+#include "ahrs.h"
+#include "drv_hal.h"
+
+#define DEG2RAD        0.017453293f
+
+static inline float inv_sqrt(float x){ return 1.0f / sqrtf(x); }
+
+static void init_common(ahrs_t *a){
+    a->q0 = 1.0f; a->q1 = a->q2 = a->q3 = 0.0f;
+    a->ix = a->iy = a->iz = 0.0f;
+    a->acc_tol = 0.15f;
+    a->rejected = 0;
+}
+
+void ahrs_init_mahony(ahrs_t *a, float kp, float ki){
+    init_common(a);
+    a->algo = AHRS_MAHONY;
+    a->kp = kp; a->ki = ki; a->beta = 0.0f;
+}
+
+void ahrs_init_madgwick(ahrs_t *a, float beta){
+    init_common(a);
+    a->algo = AHRS_MADGWICK;
+    a->kp = a->ki = 0.0f; a->beta = beta;
+}
+
+void ahrs_reset_to_accel(ahrs_t *a, float ax, float ay, float az){
+    float roll  = atan2f(ay, az);
+    float pitch = atan2f(-ax, sqrtf(ay * ay + az * az));
+    float cr = cosf(roll * 0.5f),  sr = sinf(roll * 0.5f);
+    float cp = cosf(pitch * 0.5f), sp = sinf(pitch * 0.5f);
+    a->q0 = cr * cp; a->q1 = sr * cp; a->q2 = cr * sp; a->q3 = -sr * sp;
+    a->ix = a->iy = a->iz = 0.0f;
+}
+
+/* Accel utilizável? Normaliza no lugar; 0 = descartar (só giro). */
+static int accel_ok(ahrs_t *a, float *ax, float *ay, float *az){
+    float n2 = *ax * *ax + *ay * *ay + *az * *az;
+    float lo = 1.0f - a->acc_tol, hi = 1.0f + a->acc_tol;
+    if (n2 < lo * lo || n2 > hi * hi){ a->rejected++; return 0; }
+    float r = inv_sqrt(n2);
+    *ax *= r; *ay *= r; *az *= r;
+    return 1;
+}
+
+static void mahony(ahrs_t *a, float gx, float gy, float gz, float ax, float ay, float az, float dt){
+    float q0 = a->q0, q1 = a->q1, q2 = a->q2, q3 = a->q3;
+
+    if (accel_ok(a, &ax, &ay, &az)){
+        /* gravidade estimada (3a coluna de R^T) e erro = medida x estimada */
+        float vx = 2.0f * (q1 * q3 - q0 * q2);
+        float vy = 2.0f * (q0 * q1 + q2 * q3);
+        float vz = q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3;
+        float ex = ay * vz - az * vy;
+        float ey = az * vx - ax * vz;
+        float ez = ax * vy - ay * vx;
+        if (a->ki > 0.0f){
+            a->ix += a->ki * ex * dt;
+            a->iy += a->ki * ey * dt;
+            a->iz += a->ki * ez * dt;
+            gx += a->ix; gy += a->iy; gz += a->iz;
+        }
+        gx += a->kp * ex; gy += a->kp * ey; gz += a->kp * ez;
+    }
+
+    /* q += 0.5 q ⊗ (0, w) dt */
+    float h = 0.5f * dt;
+    gx *= h; gy *= h; gz *= h;
+    a->q0 = q0 + (-q1 * gx - q2 * gy - q3 * gz);
+    a->q1 = q1 + ( q0 * gx + q2 * gz - q3 * gy);
+    a->q2 = q2 + ( q0 * gy - q1 * gz + q3 * gx);
+    a->q3 = q3 + ( q0 * gz + q1 * gy - q2 * gx);
+}
+
+static void madgwick(ahrs_t *a, float gx, float gy, float gz, float ax, float ay, float az, float dt){
+    float q0 = a->q0, q1 = a->q1, q2 = a->q2, q3 = a->q3;
+
+    float d0 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+    float d1 = 0.5f * ( q0 * gx + q2 * gz - q3 * gy);
+    float d2 = 0.5f * ( q0 * gy - q1 * gz + q3 * gx);
+    float d3 = 0.5f * ( q0 * gz + q1 * gy - q2 * gx);
+
+    if (accel_ok(a, &ax, &ay, &az)){
+        /* gradiente de f(q) = R^T g - a (forma fechada de 6 eixos) */
+        float _2q0 = 2.0f * q0, _2q1 = 2.0f * q1, _2q2 = 2.0f * q2, _2q3 = 2.0f * q3;
+        float _4q0 = 4.0f * q0, _4q1 = 4.0f * q1, _4q2 = 4.0f * q2;
+        float _8q1 = 8.0f * q1, _8q2 = 8.0f * q2;
+        float q0q0 = q0 * q0, q1q1 = q1 * q1, q2q2 = q2 * q2, q3q3 = q3 * q3;
+        float s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+        float s1 = _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q1 - _2q0 * ay - _4q1 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+        float s2 = 4.0f * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+        float s3 = 4.0f * q1q1 * q3 - _2q1 * ax + 4.0f * q2q2 * q3 - _2q2 * ay;
+        float n2 = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+        if (n2 > 0.0f){
+            float r = a->beta * inv_sqrt(n2);
+            d0 -= r * s0; d1 -= r * s1; d2 -= r * s2; d3 -= r * s3;
+        }
+    }
+
+    a->q0 = q0 + d0 * dt;
+    a->q1 = q1 + d1 * dt;
+    a->q2 = q2 + d2 * dt;
+    a->q3 = q3 + d3 * dt;
+}
+
+void ahrs_update(ahrs_t *a, float gx, float gy, float gz,
+                 float ax, float ay, float az, float dt){
+    if (a->algo == AHRS_MADGWICK) madgwick(a, gx, gy, gz, ax, ay, az, dt);
+    else                          mahony(a, gx, gy, gz, ax, ay, az, dt);
+
+    float r = inv_sqrt(a->q0 * a->q0 + a->q1 * a->q1 + a->q2 * a->q2 + a->q3 * a->q3);
+    a->q0 *= r; a->q1 *= r; a->q2 *= r; a->q3 *= r;
+}
+
+void ahrs_update_raw(ahrs_t *a, const mpu6050_raw_t *s, float dt){
+    /* escala ativa do driver (mpu6050_set_*_range / auto-escala) */
+    const float gk = mpu6050_scale.gyro_dps_lsb * DEG2RAD;
+    const float ak = mpu6050_scale.accel_g_lsb;
+    ahrs_update(a, s->gx * gk, s->gy * gk, s->gz * gk,
+                s->ax * ak, s->ay * ak, s->az * ak, dt);
+}
+
+void ahrs_gravity(const ahrs_t *a, float *gx, float *gy, float *gz){
+    *gx = 2.0f * (a->q1 * a->q3 - a->q0 * a->q2);
+    *gy = 2.0f * (a->q0 * a->q1 + a->q2 * a->q3);
+    *gz = a->q0 * a->q0 - a->q1 * a->q1 - a->q2 * a->q2 + a->q3 * a->q3;
+}
+
+void ahrs_tilt(const ahrs_t *a, float *roll, float *pitch){
+    float gx, gy, gz;
+    ahrs_gravity(a, &gx, &gy, &gz);
+    *roll  = atan2f(gy, gz);
+    *pitch = atan2f(-gx, sqrtf(gy * gy + gz * gz));
+}
+
+/* ============================== Benchmark ============================= */
+#define BENCH_N 1000
+
+static void bench_one(const char *name, ahrs_t *a){
+    /* giro girando devagar e accel com um pouco de ruído: passa pelos dois ramos */
+    mpu6050_raw_t s = { 300, -200, 16200, 40, -25, 10, 0 };
+    volatile float sink;
+    uint32_t t0 = drv_cycles();
+    for (int i = 0; i < BENCH_N; i++){
+        s.ax = (int16_t)(300 + (i & 63));
+        ahrs_update_raw(a, &s, 0.001f);
+    }
+    uint32_t cu = (drv_cycles() - t0) / BENCH_N;
+    sink = a->q0;
+    (void)sink;
+    uint32_t pct100 = (uint32_t)((uint64_t)cu * 10000000u / SystemCoreClock);   /* % x100 a 1 kHz */
+    printf("[AHRS] %-8s %lu cyc/update (1 kHz: %lu.%02lu%% da CPU)\n", name, (unsigned long)cu,
+           (unsigned long)(pct100 / 100u), (unsigned long)(pct100 % 100u));
+}
+
+void ahrs_bench(void){
+    ahrs_t a;
+    ahrs_init_mahony(&a, 1.0f, 0.05f);
+    bench_one("mahony", &a);
+    ahrs_init_madgwick(&a, 0.1f);
+    bench_one("madgwick", &a);
+}
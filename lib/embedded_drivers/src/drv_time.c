@@ -0,0 +1,16 @@
+#include "drv_time.h"
+
+static uint32_t s_last;
+static uint32_t s_hi;
+
+/* Leitura + detecção de volta atômicas: uma ISR no meio poderia contar a
+   mesma volta duas vezes (ou nenhuma). */
+uint64_t drv_cycles64(void){
+    uint32_t pm = drv_irq_save();
+    uint32_t now = drv_cycles();
+    if (now < s_last) s_hi++;
+    s_last = now;
+    uint32_t hi = s_hi;
+    drv_irq_restore(pm);
+    return ((uint64_t)hi << 32) | now;
+}
@@ -0,0 +1,251 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "filt.h"
+#include "drv_hal.h"
+
+/* ===================== SIMD do M4 / equivalente em C ================= */
+/* PACK2: p0 na metade baixa. SMLALD: acc + lo*lo + hi*hi (16x16 com sinal). */
+#if defined(__ARM_FEATURE_DSP)
+#define PACK2(p0, p1)          __PKHBT((uint32_t)(p0), (uint32_t)(p1), 16)
+#define SMLALD(a, b, acc)      ((int64_t)__SMLALD((a), (b), (uint64_t)(acc)))
+#define SAT16(v)               ((int16_t)__SSAT((v), 16))
+#else
+#define PACK2(p0, p1)          (((uint32_t)(p0) & 0xFFFFu) | ((uint32_t)(p1) << 16))
+static inline int64_t SMLALD(uint32_t a, uint32_t b, int64_t acc){
+    return acc + (int32_t)(int16_t)a * (int16_t)b + (int32_t)(int16_t)(a >> 16) * (int16_t)(b >> 16);
+}
+static inline int16_t SAT16(int32_t v){ return (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v)); }
+#endif
+
+/* 2 amostras de uma vez (LDR desalinhado é ok no M4) */
+static inline uint32_t ld2(const int16_t *p){ uint32_t w; memcpy(&w, p, 4); return w; }
+
+static inline int16_t sat16_64(int64_t v){
+    return (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+}
+
+/* ============================== Biquad =============================== */
+static int16_t coef_q15(float c, uint8_t shift){
+    float v = c * (32768.0f / (float)(1u << shift));
+    if (v >  32767.0f) v =  32767.0f;
+    if (v < -32768.0f) v = -32768.0f;
+    return (int16_t)lrintf(v);
+}
+
+/* RBJ "cookbook": normaliza por a0 e guarda com shift 1 (|coef| < 2). */
+static void biquad_set(filt_biquad_t *f, float b0, float b1, float b2, float a0, float a1, float a2){
+    f->shift = 1;
+    f->b0  = coef_q15(b0 / a0, 1);
+    f->b1  = coef_q15(b1 / a0, 1);
+    f->b2  = coef_q15(b2 / a0, 1);
+    f->na1 = coef_q15(-a1 / a0, 1);
+    f->na2 = coef_q15(-a2 / a0, 1);
+    filt_biquad_reset(f);
+}
+
+void filt_biquad_lowpass(filt_biquad_t *f, float fs, float fc, float q){
+    float w = 2.0f * 3.14159265f * fc / fs, cw = cosf(w), al = sinf(w) / (2.0f * q);
+    biquad_set(f, (1.0f - cw) * 0.5f, 1.0f - cw, (1.0f - cw) * 0.5f, 1.0f + al, -2.0f * cw, 1.0f - al);
+}
+
+void filt_biquad_highpass(filt_biquad_t *f, float fs, float fc, float q){
+    float w = 2.0f * 3.14159265f * fc / fs, cw = cosf(w), al = sinf(w) / (2.0f * q);
+    biquad_set(f, (1.0f + cw) * 0.5f, -(1.0f + cw), (1.0f + cw) * 0.5f, 1.0f + al, -2.0f * cw, 1.0f - al);
+}
+
+void filt_biquad_reset(filt_biquad_t *f){ f->x1 = f->x2 = f->y1 = f->y2 = 0; }
+
+/* Estado empacotado em palavras (x1|x2, y1|y2): 2 SMLALD + 1 MUL por amostra. */
+void filt_biquad(filt_biquad_t *f, const int16_t *in, int16_t *out, uint32_t n){
+    const uint32_t b12 = PACK2(f->b1, f->b2), a12 = PACK2(f->na1, f->na2);
+    const int32_t  b0 = f->b0;
+    const int      sh = 15 - f->shift;
+    uint32_t x12 = PACK2(f->x1, f->x2), y12 = PACK2(f->y1, f->y2);
+
+    for (uint32_t i = 0; i < n; i++){
+        int16_t x = in[i];
+        int64_t acc = (int64_t)(b0 * x);
+        acc = SMLALD(b12, x12, acc);
+        acc = SMLALD(a12, y12, acc);
+        int16_t y = SAT16((int32_t)(acc >> sh));
+        x12 = PACK2(x, x12);      /* x2 <- x1, x1 <- x */
+        y12 = PACK2(y, y12);
+        out[i] = y;
+    }
+    f->x1 = (int16_t)x12; f->x2 = (int16_t)(x12 >> 16);
+    f->y1 = (int16_t)y12; f->y2 = (int16_t)(y12 >> 16);
+}
+
+void filt_biquad_ref(filt_biquad_t *f, const int16_t *in, int16_t *out, uint32_t n){
+    for (uint32_t i = 0; i < n; i++){
+        int16_t x = in[i];
+        int64_t acc = (int64_t)f->b0 * x + (int64_t)f->b1 * f->x1 + (int64_t)f->b2 * f->x2
+                    + (int64_t)f->na1 * f->y1 + (int64_t)f->na2 * f->y2;
+        int16_t y = sat16_64(acc >> (15 - f->shift));
+        f->x2 = f->x1; f->x1 = x;
+        f->y2 = f->y1; f->y1 = y;
+        out[i] = y;
+    }
+}
+
+/* ================================ FIR ================================ */
+/* state = [ntaps-1 amostras antigas | bloco novo]. Os taps vêm em ordem
+   de tempo invertida (taps[0] pesa a amostra mais antiga, como no
+   CMSIS-DSP): a saída i é o produto escalar contíguo taps . state[i..]. */
+void filt_fir_init(filt_fir_t *f, const int16_t *taps, uint16_t ntaps,
+                   int16_t *state, uint16_t max_block, uint8_t decim){
+    f->taps = taps;
+    f->state = state;
+    f->ntaps = ntaps;
+    f->max_block = max_block;
+    f->decim = decim ? decim : 1u;
+    f->phase = 0;
+    memset(state, 0, ((uint32_t)ntaps - 1u + max_block) * sizeof(int16_t));
+}
+
+static inline int fir_take(filt_fir_t *f){
+    if (++f->phase < f->decim) return 0;
+    f->phase = 0;
+    return 1;
+}
+
+static void fir_shift(filt_fir_t *f, uint32_t n){
+    memmove(f->state, f->state + n, ((uint32_t)f->ntaps - 1u) * sizeof(int16_t));
+}
+
+uint32_t filt_fir(filt_fir_t *f, const int16_t *in, int16_t *out, uint32_t n){
+    if (n > f->max_block) n = f->max_block;
+    const uint32_t nt = f->ntaps, pairs = nt >> 1;
+    const int16_t *t = f->taps;
+    int16_t *s = f->state;
+    uint32_t k = 0;
+
+    memcpy(s + nt - 1u, in, n * sizeof(int16_t));
+    for (uint32_t i = 0; i < n; i++){
+        if (!fir_take(f)) continue;
+        const int16_t *x = s + i;
+        int64_t acc = 0;
+        for (uint32_t j = 0; j < pairs; j++)
+            acc = SMLALD(ld2(t + 2u * j), ld2(x + 2u * j), acc);
+        if (nt & 1u) acc += (int32_t)t[nt - 1u] * x[nt - 1u];
+        out[k++] = sat16_64(acc >> 15);
+    }
+    fir_shift(f, n);
+    return k;
+}
+
+uint32_t filt_fir_ref(filt_fir_t *f, const int16_t *in, int16_t *out, uint32_t n){
+    if (n > f->max_block) n = f->max_block;
+    const uint32_t nt = f->ntaps;
+    int16_t *s = f->state;
+    uint32_t k = 0;
+
+    memcpy(s + nt - 1u, in, n * sizeof(int16_t));
+    for (uint32_t i = 0; i < n; i++){
+        if (!fir_take(f)) continue;
+        int64_t acc = 0;
+        for (uint32_t j = 0; j < nt; j++) acc += (int32_t)f->taps[j] * s[i + j];
+        out[k++] = sat16_64(acc >> 15);
+    }
+    fir_shift(f, n);
+    return k;
+}
+
+/* ===================== Média móvel / mediana ========================= */
+void filt_movavg_init(filt_movavg_t *f, int16_t *buf, uint16_t len){
+    f->buf = buf; f->len = len ? len : 1u; f->pos = 0; f->sum = 0;
+    memset(buf, 0, f->len * sizeof(int16_t));
+}
+
+void filt_movavg(filt_movavg_t *f, const int16_t *in, int16_t *out, uint32_t n){
+    for (uint32_t i = 0; i < n; i++){
+        int16_t x = in[i];
+        f->sum += x - f->buf[f->pos];
+        f->buf[f->pos] = x;
+        if (++f->pos == f->len) f->pos = 0;
+        out[i] = (int16_t)(f->sum / (int32_t)f->len);
+    }
+}
+
+void filt_median_init(filt_median_t *f, int16_t *buf, uint16_t len){
+    if (len > FILT_MEDIAN_MAX) len = FILT_MEDIAN_MAX;
+    if (!(len & 1u)) len = len ? len - 1u : 1u;     /* par desce: nunca passa de buf */
+    f->buf = buf; f->len = len; f->pos = 0;
+    memset(buf, 0, f->len * sizeof(int16_t));
+}
+
+void filt_median(filt_median_t *f, const int16_t *in, int16_t *out, uint32_t n){
+    int16_t w[FILT_MEDIAN_MAX];
+    const uint32_t len = f->len;
+    for (uint32_t i = 0; i < n; i++){
+        f->buf[f->pos] = in[i];
+        if (++f->pos == len) f->pos = 0;
+        /* ordena uma cópia da janela por inserção (até 9 elementos) */
+        for (uint32_t a = 0; a < len; a++){
+            int16_t v = f->buf[a];
+            uint32_t b = a;
+            while (b > 0 && w[b - 1u] > v){ w[b] = w[b - 1u]; b--; }
+            w[b] = v;
+        }
+        out[i] = w[len >> 1];
+    }
+}
+
+/* ============================== Benchmark ============================= */
+#define BENCH_N 256
+
+static void bench_print(const char *name, uint32_t cycles, int same){
+    uint32_t cps100 = (cycles * 100u) / BENCH_N;                         /* ciclos/amostra x100 */
+    printf("[FILT] %-10s %lu.%02lu cyc/amostra%s\n", name,
+           (unsigned long)(cps100 / 100u), (unsigned long)(cps100 % 100u),
+           same < 0 ? "" : (same ? "  (= ref)" : "  (DIFERE da ref!)"));
+}
+
+void filt_bench(void){
+    static int16_t in[BENCH_N], a[BENCH_N], b[BENCH_N];
+    static int16_t st1[15 + BENCH_N], st2[15 + BENCH_N];
+    static int16_t win[FILT_MEDIAN_MAX];
+    /* passa-baixa de 16 taps (janela de Hann, ganho ~1), simétrico */
+    static int16_t taps[16];
+    uint32_t t0, c;
+
+    for (int i = 0; i < 16; i++){
+        float h = 0.5f - 0.5f * cosf(2.0f * 3.14159265f * (i + 0.5f) / 16.0f);
+        taps[i] = (int16_t)lrintf(h * 32768.0f / 8.0f);
+    }
+    for (int i = 0; i < BENCH_N; i++)
+        in[i] = (int16_t)(8000.0f * sinf(i * 0.1f) + ((i * 7919) % 2001) - 1000);
+
+    filt_biquad_t q1, q2;
+    filt_biquad_lowpass(&q1, 1000.0f, 20.0f, 0.707f);
+    q2 = q1;
+    t0 = drv_cycles(); filt_biquad_ref(&q1, in, a, BENCH_N); c = drv_cycles() - t0;
+    bench_print("biquad ref", c, -1);
+    t0 = drv_cycles(); filt_biquad(&q2, in, b, BENCH_N);     c = drv_cycles() - t0;
+    bench_print("biquad", c, memcmp(a, b, sizeof(a)) == 0);
+
+    filt_fir_t f1, f2;
+    filt_fir_init(&f1, taps, 16, st1, BENCH_N, 1);
+    filt_fir_init(&f2, taps, 16, st2, BENCH_N, 1);
+    t0 = drv_cycles(); filt_fir_ref(&f1, in, a, BENCH_N); c = drv_cycles() - t0;
+    bench_print("fir16 ref", c, -1);
+    t0 = drv_cycles(); filt_fir(&f2, in, b, BENCH_N);     c = drv_cycles() - t0;
+    bench_print("fir16", c, memcmp(a, b, sizeof(a)) == 0);
+
+    filt_fir_init(&f1, taps, 16, st1, BENCH_N, 4);
+    filt_fir_init(&f2, taps, 16, st2, BENCH_N, 4);
+    uint32_t na = filt_fir_ref(&f1, in, a, BENCH_N);
+    t0 = drv_cycles(); uint32_t nb = filt_fir(&f2, in, b, BENCH_N); c = drv_cycles() - t0;
+    bench_print("fir16 /4", c, na == nb && memcmp(a, b, nb * sizeof(int16_t)) == 0);
+
+    filt_movavg_t m;
+    filt_movavg_init(&m, win, 8);
+    t0 = drv_cycles(); filt_movavg(&m, in, a, BENCH_N); c = drv_cycles() - t0;
+    bench_print("media 8", c, -1);
+
+    filt_median_t md;
+    filt_median_init(&md, win, 5);
+    t0 = drv_cycles(); filt_median(&md, in, a, BENCH_N); c = drv_cycles() - t0;
+    bench_print("mediana 5", c, -1);
+}
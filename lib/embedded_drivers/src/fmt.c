@@ -0,0 +1,236 @@
+#include <stdio.h>
+#include <string.h>
+#include "fmt.h"
+#include "drv_hal.h"
+
+/* Pares "00".."99": metade das divisões de um laço dígito a dígito.
+   Divisão por constante vira UMULL + shift no M4. */
+static const char dig2[200] =
+    "00010203040506070809" "10111213141516171819" "20212223242526272829"
+    "30313233343536373839" "40414243444546474849" "50515253545556575859"
+    "60616263646566676869" "70717273747576777879" "80818283848586878889"
+    "90919293949596979899";
+
+static const uint32_t pow10_u32[10] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+};
+
+/* Escreve os dígitos de v terminando em 'end' (para trás); retorna quantos. */
+static uint32_t u32_rev(char *end, uint32_t v){
+    char *p = end;
+    while (v >= 100u){
+        uint32_t q = v / 100u;
+        uint32_t r = (v - q * 100u) * 2u;
+        p -= 2;
+        p[0] = dig2[r];
+        p[1] = dig2[r + 1u];
+        v = q;
+    }
+    if (v >= 10u){
+        p -= 2;
+        p[0] = dig2[v * 2u];
+        p[1] = dig2[v * 2u + 1u];
+    } else {
+        *--p = (char)('0' + v);
+    }
+    return (uint32_t)(end - p);
+}
+
+void fmt_init(fmt_t *w, char *buf, uint32_t cap){
+    w->buf = buf;
+    w->cap = cap;
+    fmt_reset(w);
+}
+
+void fmt_mem(fmt_t *w, const char *s, uint32_t n){
+    if (!w->cap) { w->truncated = 1; return; }
+    uint32_t room = w->cap - 1u - w->len;
+    if (n > room) { n = room; w->truncated = 1; }
+    memcpy(w->buf + w->len, s, n);
+    w->len += n;
+    w->buf[w->len] = '\0';
+}
+
+void fmt_str(fmt_t *w, const char *s){ fmt_mem(w, s, (uint32_t)strlen(s)); }
+void fmt_char(fmt_t *w, char c){ fmt_mem(w, &c, 1u); }
+
+/* Sinal, preenchimento e dígitos como o printf: '0' entra depois do sinal,
+   ' ' antes dele. */
+static void put_num(fmt_t *w, int neg, const char *dig, uint32_t n, uint8_t width, char pad){
+    char tmp[32];
+    uint32_t k = 0, body = n + (neg ? 1u : 0u);
+    uint32_t fill = width > body ? width - body : 0u;
+    if (fill > sizeof(tmp) - 12u) fill = sizeof(tmp) - 12u;
+    if (pad != '0') while (fill) { tmp[k++] = ' '; fill--; }
+    if (neg) tmp[k++] = '-';
+    while (fill) { tmp[k++] = '0'; fill--; }
+    memcpy(tmp + k, dig, n);
+    fmt_mem(w, tmp, k + n);
+}
+
+void fmt_u32w(fmt_t *w, uint32_t v, uint8_t width, char pad){
+    char d[10];
+    uint32_t n = u32_rev(d + sizeof(d), v);
+    put_num(w, 0, d + sizeof(d) - n, n, width, pad);
+}
+
+void fmt_i32w(fmt_t *w, int32_t v, uint8_t width, char pad){
+    char d[10];
+    uint32_t n = u32_rev(d + sizeof(d), v < 0 ? 0u - (uint32_t)v : (uint32_t)v);
+    put_num(w, v < 0, d + sizeof(d) - n, n, width, pad);
+}
+
+void fmt_u32(fmt_t *w, uint32_t v){
+    char d[10];
+    uint32_t n = u32_rev(d + sizeof(d), v);
+    fmt_mem(w, d + sizeof(d) - n, n);
+}
+
+void fmt_i32(fmt_t *w, int32_t v){
+    char d[11];
+    uint32_t n = u32_rev(d + sizeof(d), v < 0 ? 0u - (uint32_t)v : (uint32_t)v);
+    if (v < 0) d[sizeof(d) - ++n] = '-';
+    fmt_mem(w, d + sizeof(d) - n, n);
+}
+
+/* 64 bits: só divide em 64 (__aeabi_uldivmod) o que passar de 32 */
+void fmt_u64(fmt_t *w, uint64_t v){
+    if (v <= UINT32_MAX) { fmt_u32(w, (uint32_t)v); return; }
+    char d[20];
+    uint32_t n = 0;
+    while (v > UINT32_MAX){
+        uint64_t q = v / 1000000000u;
+        uint32_t r = (uint32_t)(v - q * 1000000000u);
+        uint32_t k = u32_rev(d + sizeof(d) - n, r);
+        n += k;
+        while (k++ < 9u) d[sizeof(d) - ++n] = '0';   /* bloco interno tem 9 dígitos */
+        v = q;
+    }
+    n += u32_rev(d + sizeof(d) - n, (uint32_t)v);
+    fmt_mem(w, d + sizeof(d) - n, n);
+}
+
+void fmt_i64(fmt_t *w, int64_t v){
+    if (v >= INT32_MIN && v <= INT32_MAX) { fmt_i32(w, (int32_t)v); return; }
+    if (v < 0) fmt_char(w, '-');
+    fmt_u64(w, v < 0 ? 0u - (uint64_t)v : (uint64_t)v);
+}
+
+void fmt_hex(fmt_t *w, uint32_t v, uint8_t digits){
+    static const char hx[16] = "0123456789ABCDEF";
+    char d[8];
+    uint32_t n = 0;
+    do { d[sizeof(d) - ++n] = hx[v & 0xFu]; v >>= 4; } while (v);
+    put_num(w, 0, d + sizeof(d) - n, n, digits, '0');
+}
+
+static void put_fix(fmt_t *w, int neg, uint32_t v, uint8_t dec){
+    if (dec > 9u) dec = 9u;
+    char d[21];
+    uint32_t ip = v / pow10_u32[dec], fp = v - ip * pow10_u32[dec];
+    uint32_t n = 0;
+    if (dec){
+        uint32_t k = u32_rev(d + sizeof(d), fp);
+        while (k < dec) d[sizeof(d) - ++k] = '0';
+        n = k;
+        d[sizeof(d) - ++n] = '.';
+    }
+    n += u32_rev(d + sizeof(d) - n, ip);
+    if (neg) d[sizeof(d) - ++n] = '-';
+    fmt_mem(w, d + sizeof(d) - n, n);
+}
+
+void fmt_ufix(fmt_t *w, uint32_t v, uint8_t dec){ put_fix(w, 0, v, dec); }
+void fmt_fix(fmt_t *w, int32_t v, uint8_t dec){
+    put_fix(w, v < 0, v < 0 ? 0u - (uint32_t)v : (uint32_t)v, dec);
+}
+
+void fmt_spec(fmt_t *w, fmt_spec_t s){
+    switch (s.kind){
+    case FMT_K_FIX:
+        put_fix(w, s.neg, s.mag, s.arg);
+        break;
+    case FMT_K_HEX:
+        fmt_hex(w, s.mag, s.arg);
+        break;
+    default: {
+        char d[10];
+        uint32_t n = u32_rev(d + sizeof(d), s.mag);
+        put_num(w, s.neg, d + sizeof(d) - n, n, s.arg, s.pad);
+        break;
+    }
+    }
+}
+
+uint32_t fmt_utoa(char *dst, uint32_t v){
+    char d[10];
+    uint32_t n = u32_rev(d + sizeof(d), v);
+    memcpy(dst, d + sizeof(d) - n, n);
+    dst[n] = '\0';
+    return n;
+}
+
+uint32_t fmt_itoa(char *dst, int32_t v){
+    if (v >= 0) return fmt_utoa(dst, (uint32_t)v);
+    *dst = '-';
+    return fmt_utoa(dst + 1, 0u - (uint32_t)v) + 1u;
+}
+
+/* ============================== Benchmark ============================= */
+#define BENCH_N 200
+
+/* Valores típicos de cada linha; variam a cada volta para o compilador não
+   tirar nada do laço. */
+static volatile int32_t bv[6] = { -1962, 48, 16380, -131, 7, 250 };
+
+static uint32_t bench_snprintf(int line, char *buf, uint32_t cap, uint32_t i){
+    int32_t a = bv[0] + (int32_t)i, b = bv[1], c = bv[2], d = bv[3], e = bv[4], f = bv[5];
+    uint32_t ms = 83071u + i;
+    switch (line){
+    case 0: return (uint32_t)snprintf(buf, cap, "[CAMARADAS DO EDU]: %ld, %ld, %ld, %ld, %ld, %ld\n",
+                                      (long)a, (long)b, (long)c, (long)d, (long)e, (long)f);
+    case 1: return (uint32_t)snprintf(buf, cap, "%02lu", (unsigned long)(i % 100u));
+    case 2: return (uint32_t)snprintf(buf, cap, "%02d:%02d:%02d", (int)(i % 24u), (int)e, (int)(i % 60u));
+    case 3: return (uint32_t)snprintf(buf, cap, "LIVES:%d", (int)(i % 4u));
+    case 4: return (uint32_t)snprintf(buf, cap, "T:%02lu.%03lu", (unsigned long)(ms / 1000u), (unsigned long)(ms % 1000u));
+    default: return (uint32_t)snprintf(buf, cap, "TIME: %lu.%03lu s", (unsigned long)(ms / 1000u), (unsigned long)(ms % 1000u));
+    }
+}
+
+static uint32_t bench_fmt(int line, char *buf, uint32_t cap, uint32_t i){
+    int32_t a = bv[0] + (int32_t)i, b = bv[1], c = bv[2], d = bv[3], e = bv[4], f = bv[5];
+    uint32_t ms = 83071u + i;
+    fmt_t w;
+    fmt_init(&w, buf, cap);
+    switch (line){
+    case 0: return FMT(&w, "[CAMARADAS DO EDU]: ", a, ", ", b, ", ", c, ", ", d, ", ", e, ", ", f, "\n");
+    case 1: return FMT(&w, FMT_U(i % 100u, 2, '0'));
+    case 2: return FMT(&w, FMT_I((int)(i % 24u), 2, '0'), ":", FMT_I(e, 2, '0'), ":", FMT_I((int)(i % 60u), 2, '0'));
+    case 3: return FMT(&w, "LIVES:", (int)(i % 4u));
+    case 4: return FMT(&w, "T:", FMT_U(ms / 1000u, 2, '0'), ".", FMT_U(ms % 1000u, 3, '0'));
+    default: return FMT(&w, "TIME: ", FMT_UFIX(ms, 3), " s");
+    }
+}
+
+void fmt_bench(void){
+    static const char *const name[6] = { "telemetria", "eventos", "relogio", "vidas", "hud T:", "TIME:" };
+    char a[96], b[96];
+    for (int line = 0; line < 6; line++){
+        int same = 1;
+        for (uint32_t i = 0; i < 8u; i++){
+            uint32_t na = bench_snprintf(line, a, sizeof(a), i * 37u);
+            uint32_t nb = bench_fmt(line, b, sizeof(b), i * 37u);
+            if (na != nb || strcmp(a, b) != 0) same = 0;
+        }
+        uint32_t t0 = drv_cycles();
+        for (uint32_t i = 0; i < BENCH_N; i++) bench_snprintf(line, a, sizeof(a), i);
+        uint32_t cs = (drv_cycles() - t0) / BENCH_N;
+        t0 = drv_cycles();
+        for (uint32_t i = 0; i < BENCH_N; i++) bench_fmt(line, b, sizeof(b), i);
+        uint32_t cf = (drv_cycles() - t0) / BENCH_N;
+        uint32_t x10 = cf ? (cs * 10u) / cf : 0u;
+        printf("[FMT] %-10s snprintf %5lu cyc  FMT %4lu cyc  (%lu.%lux)%s\n", name[line],
+               (unsigned long)cs, (unsigned long)cf, (unsigned long)(x10 / 10u), (unsigned long)(x10 % 10u),
+               same ? "" : "  DIFERE do snprintf!");
+    }
+}
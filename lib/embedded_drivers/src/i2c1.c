@@ -0,0 +1,325 @@
+#ifndef DRIVERS_NATIVE
+#include "i2c1.h"
+#include "i2c1_priv.h"
+#include "drv_hal.h"
+
+i2c1_stats_t i2c1_stats;
+
+static uint32_t s_apb1_hz = 50000000u;
+static uint32_t s_bus_hz  = 100000u;
+static uint8_t  bus_fault;          /* recuperar antes da próxima transação */
+
+const i2c1_stats_t *i2c1_get_stats(void) { return &i2c1_stats; }
+void i2c1_reset_stats(void) { i2c1_stats = (i2c1_stats_t){0}; }
+
+/* *t = drv_cycles() no início da transação. Falha rápido em NACK/ARLO/BERR;
+   erro depois de DRV_I2C_TIMEOUT_US. */
+static int i2c_timeout(uint32_t *t) {
+    uint32_t sr1 = DRV_I2C->SR1;
+    if (sr1 & I2C_SR1_AF) {
+        DRV_I2C->SR1 = (uint16_t)~I2C_SR1_AF;
+        i2c1_stats.nack++;
+        return -1;
+    }
+    if (sr1 & (I2C_SR1_ARLO | I2C_SR1_BERR | I2C_SR1_OVR)) {
+        DRV_I2C->SR1 = (uint16_t)~(I2C_SR1_ARLO | I2C_SR1_BERR | I2C_SR1_OVR);
+        if (sr1 & I2C_SR1_ARLO) i2c1_stats.arlo++; else i2c1_stats.berr++;
+        bus_fault = 1;
+        return -1;
+    }
+    if ((drv_cycles() - *t) > drv_us_to_cycles(DRV_I2C_TIMEOUT_US)) {
+        i2c1_stats.timeout++;
+        bus_fault = 1;
+        return -1;
+    }
+    return 0;
+}
+
+/* Antes de cada transação bloqueante: barramento livre ou recuperado. */
+static int i2c_bus_ready(void) {
+    uint32_t t = drv_cycles();
+    while (!bus_fault && (DRV_I2C->SR2 & I2C_SR2_BUSY)) {   // STOP anterior ainda saindo
+        if ((drv_cycles() - t) > drv_us_to_cycles(DRV_I2C_TIMEOUT_US)) { bus_fault = 1; break; }
+    }
+    if (bus_fault) {
+        bus_fault = 0;
+        if (i2c1_bus_recover() < 0) { bus_fault = 1; return -1; }
+    }
+    return 0;
+}
+
+/* Caminho por interrupção: monta a transação e espera na fila. */
+static int i2c1_xfer_sync(uint8_t addr7, uint8_t reg, uint8_t op, uint8_t *buf, uint32_t len) {
+    i2c1_xfer_t x = { .addr7 = addr7, .reg = reg, .op = op, .buf = buf, .len = (uint16_t)len };
+    return (i2c1_xfer_run(&x) == I2C1_OK) ? 0 : -1;
+}
+
+static void bit_delay(void) {
+    uint32_t t = drv_cycles();
+    while ((drv_cycles() - t) < drv_us_to_cycles(5u)) {}     // ~100 kHz
+}
+
+static inline int sda_high(void) { return (DRV_I2C_SDA_PORT->IDR & (1u << DRV_I2C_SDA_PIN)) != 0; }
+
+/* Escravo preso no meio de um byte segura SDA em 0: até 9 pulsos de SCL
+   completam o byte, depois um STOP (SDA sobe com SCL alto) libera o bus.
+   Pinos como saída open-drain (já configurados assim). */
+static int bus_unstick(void) {
+    pin_set(DRV_I2C_SCL_PORT, DRV_I2C_SCL_PIN);
+    pin_set(DRV_I2C_SDA_PORT, DRV_I2C_SDA_PIN);
+    gpio_mode(DRV_I2C_SCL_PORT, DRV_I2C_SCL_PIN, GPIO_MODE_OUT);
+    gpio_mode(DRV_I2C_SDA_PORT, DRV_I2C_SDA_PIN, GPIO_MODE_OUT);
+    bit_delay();
+
+    for (int i = 0; i < 9 && !sda_high(); i++) {
+        pin_clr(DRV_I2C_SCL_PORT, DRV_I2C_SCL_PIN); bit_delay();
+        pin_set(DRV_I2C_SCL_PORT, DRV_I2C_SCL_PIN); bit_delay();
+    }
+    // STOP
+    pin_clr(DRV_I2C_SCL_PORT, DRV_I2C_SCL_PIN); bit_delay();
+    pin_clr(DRV_I2C_SDA_PORT, DRV_I2C_SDA_PIN); bit_delay();
+    pin_set(DRV_I2C_SCL_PORT, DRV_I2C_SCL_PIN); bit_delay();
+    pin_set(DRV_I2C_SDA_PORT, DRV_I2C_SDA_PIN); bit_delay();
+
+    int ok = sda_high();
+    gpio_mode(DRV_I2C_SCL_PORT, DRV_I2C_SCL_PIN, GPIO_MODE_AF);
+    gpio_mode(DRV_I2C_SDA_PORT, DRV_I2C_SDA_PIN, GPIO_MODE_AF);
+    return ok ? 0 : -1;
+}
+
+/* Reset do periférico e temporização para s_apb1_hz / s_bus_hz. */
+static void i2c_hw_init(void) {
+    uint32_t apb1_hz = s_apb1_hz, bus_hz = s_bus_hz;
+
+    // Reset do I2C
+    RCC->APB1RSTR |= DRV_I2C_RST_BIT;
+    RCC->APB1RSTR &= ~DRV_I2C_RST_BIT;
+
+    DRV_I2C->CR1 = 0;
+    DRV_I2C->CR2 = 0;
+
+    // CR2 = freq em MHz do APB1
+    uint32_t freq_mhz = apb1_hz / 1000000u;
+    if (freq_mhz < 2) freq_mhz = 2;
+    if (freq_mhz > 50) freq_mhz = 50; // limite do F411
+    DRV_I2C->CR2 = (uint16_t)freq_mhz;
+
+    if (bus_hz <= 100000u) {
+        // Standard: Thigh = Tlow = CCR * Tpclk  ->  CCR = Fpclk1 / (2*f)
+        uint32_t ccr = (apb1_hz + 2u * bus_hz - 1u) / (2u * bus_hz);
+        if (ccr < 4) ccr = 4;
+        DRV_I2C->CCR = ccr & 0x0FFF;
+        // TRISE = 1000 ns * freq_MHz + 1
+        DRV_I2C->TRISE = (uint16_t)(freq_mhz + 1u);
+    } else {
+        // Fast: DUTY=0 -> período 3*CCR; DUTY=1 -> 25*CCR (16:9).
+        // Arredonda CCR para cima (nunca passa de bus_hz) e fica com o
+        // DUTY que chega mais perto.
+        if (bus_hz > 400000u) bus_hz = 400000u;
+        uint32_t c2  = (apb1_hz + 3u  * bus_hz - 1u) / (3u  * bus_hz);
+        uint32_t c16 = (apb1_hz + 25u * bus_hz - 1u) / (25u * bus_hz);
+        if (c2 < 1) c2 = 1;
+        if (c16 < 1) c16 = 1;
+        uint32_t f2  = apb1_hz / (3u  * c2);
+        uint32_t f16 = apb1_hz / (25u * c16);
+        if (f16 > f2) DRV_I2C->CCR = I2C_CCR_FS | I2C_CCR_DUTY | (c16 & 0x0FFF);
+        else          DRV_I2C->CCR = I2C_CCR_FS | (c2 & 0x0FFF);
+        // TRISE = 300 ns * freq_MHz + 1
+        DRV_I2C->TRISE = (uint16_t)((freq_mhz * 300u) / 1000u + 1u);
+    }
+
+    // Habilita
+    DRV_I2C->CR1 |= I2C_CR1_PE;
+}
+
+uint32_t i2c1_get_bus_hz(void) { return (s_bus_hz > 400000u) ? 400000u : s_bus_hz; }
+
+void i2c1_init(uint32_t apb1_hz, uint32_t bus_hz) {
+    s_apb1_hz = apb1_hz;
+    s_bus_hz  = bus_hz ? bus_hz : 100000u;
+
+    // Timeouts e atrasos de bit usam o CYCCNT
+    drv_cycles_init();
+
+    // GPIO SCL/SDA em AF open-drain, pull-up (padrão PB8/PB9 AF4)
+    gpio_clk_enable(DRV_I2C_SCL_PORT);
+    gpio_clk_enable(DRV_I2C_SDA_PORT);
+    gpio_af(DRV_I2C_SCL_PORT, DRV_I2C_SCL_PIN, DRV_I2C_AF);
+    gpio_af(DRV_I2C_SDA_PORT, DRV_I2C_SDA_PIN, DRV_I2C_AF);
+    gpio_open_drain(DRV_I2C_SCL_PORT, DRV_I2C_SCL_PIN);
+    gpio_open_drain(DRV_I2C_SDA_PORT, DRV_I2C_SDA_PIN);
+    gpio_pull(DRV_I2C_SCL_PORT, DRV_I2C_SCL_PIN, 1u);   // pull-up
+    gpio_pull(DRV_I2C_SDA_PORT, DRV_I2C_SDA_PIN, 1u);
+    gpio_speed(DRV_I2C_SCL_PORT, DRV_I2C_SCL_PIN, 3u);  // alta velocidade
+    gpio_speed(DRV_I2C_SDA_PORT, DRV_I2C_SDA_PIN, 3u);
+
+    // Clock do I2C
+    RCC->APB1ENR |= DRV_I2C_RCC_BIT;
+
+    // Escravo segurando SDA desde antes do reset (brown-out no meio de uma leitura)
+    gpio_mode(DRV_I2C_SDA_PORT, DRV_I2C_SDA_PIN, GPIO_MODE_IN);
+    if (!sda_high()) {
+        i2c1_stats.recover++;
+        (void)bus_unstick();
+    }
+    gpio_mode(DRV_I2C_SCL_PORT, DRV_I2C_SCL_PIN, GPIO_MODE_AF);
+    gpio_mode(DRV_I2C_SDA_PORT, DRV_I2C_SDA_PIN, GPIO_MODE_AF);
+
+    i2c_hw_init();
+    bus_fault = 0;
+}
+
+void i2c1_init_100k(uint32_t apb1_hz) {
+    i2c1_init(apb1_hz, 100000u);
+}
+
+int i2c1_bus_recover(void) {
+    i2c1_stats.recover++;
+    DRV_I2C->CR1 &= ~I2C_CR1_PE;
+    int r = bus_unstick();
+    i2c_hw_init();
+    return r;
+}
+
+static int i2c1_start_addr(uint8_t addr7, int read) {
+    uint32_t to = drv_cycles();
+
+    // START
+    DRV_I2C->CR1 |= I2C_CR1_START;
+    while (!(DRV_I2C->SR1 & I2C_SR1_SB)) if (i2c_timeout(&to)) return -1;
+    (void)DRV_I2C->SR1;
+
+    // Endereço
+    DRV_I2C->DR = (addr7<<1) | (read?1:0);
+    if (!read) {
+        while (!(DRV_I2C->SR1 & I2C_SR1_ADDR)) if (i2c_timeout(&to)) return -1;
+        (void)DRV_I2C->SR1; (void)DRV_I2C->SR2;
+    } else {
+        while (!(DRV_I2C->SR1 & I2C_SR1_ADDR)) if (i2c_timeout(&to)) return -1;
+        (void)DRV_I2C->SR1; (void)DRV_I2C->SR2;
+    }
+    return 0;
+}
+
+static void i2c1_stop(void) {
+    DRV_I2C->CR1 |= I2C_CR1_STOP;
+}
+
+int i2c1_write_reg(uint8_t addr7, uint8_t reg, uint8_t data) {
+    if (i2c1_async_enabled()) return i2c1_xfer_sync(addr7, reg, I2C1_OP_WRITE, &data, 1);
+    if (i2c_bus_ready() < 0) return -1;
+    uint32_t to = drv_cycles();
+
+    if (i2c1_start_addr(addr7, 0) < 0) { i2c1_stop(); return -1; }
+
+    while (!(DRV_I2C->SR1 & I2C_SR1_TXE)) if (i2c_timeout(&to)) { i2c1_stop(); return -1; }
+    DRV_I2C->DR = reg;
+
+    while (!(DRV_I2C->SR1 & I2C_SR1_TXE)) if (i2c_timeout(&to)) { i2c1_stop(); return -1; }
+    DRV_I2C->DR = data;
+
+    while (!(DRV_I2C->SR1 & I2C_SR1_BTF)) if (i2c_timeout(&to)) { i2c1_stop(); return -1; }
+    i2c1_stop();
+    return 0;
+}
+
+int i2c1_write_multi(uint8_t addr7, uint8_t reg, const uint8_t *buf, uint32_t len) {
+    if (len == 0) return 0;
+    if (i2c1_async_enabled()) return i2c1_xfer_sync(addr7, reg, I2C1_OP_WRITE, (uint8_t *)buf, len);
+    if (i2c_bus_ready() < 0) return -1;
+    uint32_t to = drv_cycles();
+
+    if (i2c1_start_addr(addr7, 0) < 0) { i2c1_stop(); return -1; }
+
+    while (!(DRV_I2C->SR1 & I2C_SR1_TXE)) if (i2c_timeout(&to)) { i2c1_stop(); return -1; }
+    DRV_I2C->DR = reg;
+
+    for (uint32_t i = 0; i < len; i++) {
+        while (!(DRV_I2C->SR1 & I2C_SR1_TXE)) if (i2c_timeout(&to)) { i2c1_stop(); return -1; }
+        DRV_I2C->DR = buf[i];
+    }
+
+    while (!(DRV_I2C->SR1 & I2C_SR1_BTF)) if (i2c_timeout(&to)) { i2c1_stop(); return -1; }
+    i2c1_stop();
+    return 0;
+}
+
+int i2c1_read_reg(uint8_t addr7, uint8_t reg, uint8_t *data) {
+    if (i2c1_async_enabled()) return i2c1_xfer_sync(addr7, reg, I2C1_OP_READ, data, 1);
+    if (i2c_bus_ready() < 0) return -1;
+    uint32_t to = drv_cycles();
+
+    if (i2c1_start_addr(addr7, 0) < 0) { i2c1_stop(); return -1; }
+    while (!(DRV_I2C->SR1 & I2C_SR1_TXE)) if (i2c_timeout(&to)) { i2c1_stop(); return -1; }
+    DRV_I2C->DR = reg;
+    while (!(DRV_I2C->SR1 & I2C_SR1_BTF)) if (i2c_timeout(&to)) { i2c1_stop(); return -1; }
+
+    // Repeated START para leitura
+    DRV_I2C->CR1 |= I2C_CR1_START;
+    while (!(DRV_I2C->SR1 & I2C_SR1_SB)) if (i2c_timeout(&to)) { i2c1_stop(); return -1; }
+    (void)DRV_I2C->SR1;
+    DRV_I2C->DR = (addr7<<1) | 1;  // read
+    while (!(DRV_I2C->SR1 & I2C_SR1_ADDR)) if (i2c_timeout(&to)) { i2c1_stop(); return -1; }
+
+    // NACK para 1 byte
+    DRV_I2C->CR1 &= ~I2C_CR1_ACK;
+    (void)DRV_I2C->SR1; (void)DRV_I2C->SR2;
+
+    DRV_I2C->CR1 |= I2C_CR1_STOP;
+    while (!(DRV_I2C->SR1 & I2C_SR1_RXNE)) if (i2c_timeout(&to)) return -1;
+    *data = (uint8_t)DRV_I2C->DR;
+
+    return 0;
+}
+
+int i2c1_read_multi(uint8_t addr7, uint8_t reg, uint8_t *buf, uint32_t len) {
+    if (len == 0) return 0;
+    if (i2c1_async_enabled()) return i2c1_xfer_sync(addr7, reg, I2C1_OP_READ, buf, len);
+    if (i2c_bus_ready() < 0) return -1;
+    uint32_t to = drv_cycles();
+
+    // Write reg
+    if (i2c1_start_addr(addr7, 0) < 0) { i2c1_stop(); return -1; }
+    while (!(DRV_I2C->SR1 & I2C_SR1_TXE)) if (i2c_timeout(&to)) { i2c1_stop(); return -1; }
+    DRV_I2C->DR = reg;
+    while (!(DRV_I2C->SR1 & I2C_SR1_BTF)) if (i2c_timeout(&to)) { i2c1_stop(); return -1; }
+
+    // Restart leitura
+    DRV_I2C->CR1 |= I2C_CR1_START;
+    while (!(DRV_I2C->SR1 & I2C_SR1_SB)) if (i2c_timeout(&to)) { i2c1_stop(); return -1; }
+    (void)DRV_I2C->SR1;
+    DRV_I2C->DR = (addr7<<1) | 1;
+    while (!(DRV_I2C->SR1 & I2C_SR1_ADDR)) if (i2c_timeout(&to)) { i2c1_stop(); return -1; }
+
+    if (len == 1) {
+        // NACK single
+        DRV_I2C->CR1 &= ~I2C_CR1_ACK;
+        (void)DRV_I2C->SR1; (void)DRV_I2C->SR2;
+        DRV_I2C->CR1 |= I2C_CR1_STOP;
+        while (!(DRV_I2C->SR1 & I2C_SR1_RXNE)) if (i2c_timeout(&to)) return -1;
+        buf[0] = (uint8_t)DRV_I2C->DR;
+        return 0;
+    }
+
+    // ACK para múltiplos
+    DRV_I2C->CR1 |= I2C_CR1_ACK;
+    (void)DRV_I2C->SR1; (void)DRV_I2C->SR2;
+
+    for (uint32_t i=0; i<len; i++) {
+        if (i == (len-2)) {
+            // preparar NACK para o último byte
+            while (!(DRV_I2C->SR1 & I2C_SR1_BTF)) if (i2c_timeout(&to)) return -1;
+            DRV_I2C->CR1 &= ~I2C_CR1_ACK;
+            buf[i] = (uint8_t)DRV_I2C->DR;
+            DRV_I2C->CR1 |= I2C_CR1_STOP;
+            while (!(DRV_I2C->SR1 & I2C_SR1_RXNE)) if (i2c_timeout(&to)) return -1;
+            buf[i+1] = (uint8_t)DRV_I2C->DR;
+            break;
+        } else {
+            while (!(DRV_I2C->SR1 & I2C_SR1_RXNE)) if (i2c_timeout(&to)) return -1;
+            buf[i] = (uint8_t)DRV_I2C->DR;
+        }
+    }
+    return 0;
+}
+#endif /* !DRIVERS_NATIVE */
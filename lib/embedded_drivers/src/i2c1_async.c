@@ -0,0 +1,395 @@
+#ifndef DRIVERS_NATIVE
+#include <stddef.h>
+#include "i2c1.h"
+#include "i2c1_priv.h"
+#include "drv_hal.h"
+
+#ifdef DRIVERS_FREERTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+/* Máquina de estados do mestre I2C (F4, periférico v1) movida pelos
+   eventos EV: SB, ADDR, TXE, BTF, RXNE. Leitura de N bytes segue o
+   roteiro do RM0383 (N=1: NACK antes de limpar ADDR; N=2: POS; N>2:
+   para de usar RXNE nos 3 últimos e fecha com BTF).
+   Com DRV_I2C_USE_DMA, leituras de 2+ bytes vão por DMA com LAST=1: o
+   periférico manda NACK no último byte sozinho e o único evento da fase
+   de dados é o TC do DMA (14 bytes: 7 IRQs no total em vez de ~20). */
+enum {
+    ST_IDLE,
+    ST_START,       /* espera SB  -> addr+W              */
+    ST_ADDR_W,      /* espera ADDR                       */
+    ST_REG,         /* TXE -> reg                        */
+    ST_TX,          /* TXE -> dados                      */
+    ST_TX_LAST,     /* BTF -> STOP                       */
+    ST_REG_SENT,    /* BTF -> RESTART                    */
+    ST_RESTART,     /* espera SB  -> addr+R              */
+    ST_ADDR_R,      /* espera ADDR                       */
+    ST_RX,          /* RXNE/BTF                          */
+    ST_RX_DMA       /* TC do DMA -> STOP                 */
+};
+
+static i2c1_xfer_t *volatile q_head;     /* ordenada por prio decrescente */
+static i2c1_xfer_t *volatile cur;
+static volatile uint8_t st;
+static uint16_t idx;
+static uint8_t  async_on;
+/* Recuperação do barramento pedida pelo ER ISR ou pelo timeout: 1 pedida,
+   2 em curso. Enquanto != 0 a fila não começa transações. */
+static volatile uint8_t recover_pending;
+/* START adiado esperando o STOP anterior sair do fio */
+static uint8_t  stop_wait;
+static uint32_t stop_t0;
+
+#define CR2_IT_ALL (I2C_CR2_ITEVTEN | I2C_CR2_ITBUFEN | I2C_CR2_ITERREN)
+
+int i2c1_async_enabled(void){ return async_on; }
+
+static inline uint32_t xfer_timeout_cyc(const i2c1_xfer_t *x){
+    return drv_us_to_cycles(i2c1_xfer_timeout_us(x));
+}
+
+/* Tira da fila e dispara o START (IRQs do I2C mascarados ou no ISR).
+   Com recuperação pendente a fila espera. */
+static void start_next(void){
+    i2c1_xfer_t *x = recover_pending ? NULL : q_head;
+    cur = NULL;
+    st = ST_IDLE;
+    if (x == NULL){ stop_wait = 0; return; }
+
+    /* STOP anterior ainda sendo gerado (poucos us): em vez de esperar aqui,
+       no ISR ou com IRQs mascarados, pendura o EV IRQ e tenta na volta.
+       Passados 50 us segue assim mesmo e o timeout da transação cuida. */
+    if (DRV_I2C->CR1 & I2C_CR1_STOP){
+        if (!stop_wait){ stop_wait = 1; stop_t0 = drv_cycles(); }
+        if ((drv_cycles() - stop_t0) < drv_us_to_cycles(50u)){
+            NVIC_SetPendingIRQ(DRV_I2C_EV_IRQn);
+            return;
+        }
+    }
+    stop_wait = 0;
+    q_head = x->next;
+    cur = x;
+
+    idx = 0;
+    st = ST_START;
+    x->t0 = drv_cycles();
+    DRV_I2C->CR1 &= ~I2C_CR1_POS;
+    DRV_I2C->CR1 |= I2C_CR1_ACK;
+    DRV_I2C->CR2 |= CR2_IT_ALL;
+    DRV_I2C->CR1 |= I2C_CR1_START;
+}
+
+#if DRV_I2C_USE_DMA
+/* Stream de RX: periférico -> memória, bytes, TC/TE habilitados. */
+static void rx_dma_start(uint8_t *dst, uint16_t n){
+    DMA_Stream_TypeDef *s = DRV_I2C_DMA_RX_STREAM;
+    dma_stream_off(s);
+    dma_clear(DRV_I2C_DMA, DRV_I2C_DMA_RX_NUM, DMA_FLAGS_ALL(DRV_I2C_DMA_RX_NUM));
+    s->PAR  = (uint32_t)&DRV_I2C->DR;
+    s->M0AR = (uint32_t)dst;
+    s->NDTR = n;
+    s->CR   = (DRV_I2C_DMA_RX_CHANNEL << DMA_SxCR_CHSEL_Pos) |
+              DMA_SxCR_MINC | DMA_SxCR_PL_1 | DMA_SxCR_TCIE | DMA_SxCR_TEIE;   /* DIR=00 P->M, 8 bits */
+    s->CR  |= DMA_SxCR_EN;
+}
+
+static inline void rx_dma_stop(void){
+    DRV_I2C->CR2 &= ~(I2C_CR2_DMAEN | I2C_CR2_LAST);
+    dma_stream_off(DRV_I2C_DMA_RX_STREAM);
+    dma_clear(DRV_I2C_DMA, DRV_I2C_DMA_RX_NUM, DMA_FLAGS_ALL(DRV_I2C_DMA_RX_NUM));
+}
+#endif
+
+/* Solta a transação corrente do periférico (IRQs do I2C mascarados ou no
+   ISR). */
+static i2c1_xfer_t *detach(void){
+    i2c1_xfer_t *x = cur;
+    DRV_I2C->CR2 &= ~CR2_IT_ALL;
+#if DRV_I2C_USE_DMA
+    if (st == ST_RX_DMA) rx_dma_stop();
+#endif
+    DRV_I2C->CR1 &= ~I2C_CR1_POS;
+    cur = NULL;
+    st = ST_IDLE;
+    return x;
+}
+
+/* Entrega o status: callback e notificação de quem espera. */
+static void complete(i2c1_xfer_t *x, int8_t status, int from_isr){
+    if (x == NULL) return;
+    x->status = status;
+    if (x->done) x->done(x, x->arg);
+#ifdef DRIVERS_FREERTOS
+    if (x->notify){
+        if (from_isr){
+            BaseType_t woken = pdFALSE;
+            vTaskNotifyGiveIndexedFromISR((TaskHandle_t)x->notify, DRV_I2C_NOTIFY_INDEX, &woken);
+            portYIELD_FROM_ISR(woken);
+        } else {
+            xTaskNotifyGiveIndexed((TaskHandle_t)x->notify, DRV_I2C_NOTIFY_INDEX);
+        }
+    }
+#else
+    (void)from_isr;
+#endif
+}
+
+/* Fecha a transação corrente, avisa quem espera e começa a próxima (ISR). */
+static void finish(int8_t status, int from_isr){
+    complete(detach(), status, from_isr);
+    start_next();
+}
+
+void i2c1_async_init(void){
+    DRV_I2C->CR2 &= ~CR2_IT_ALL;
+    NVIC_SetPriority(DRV_I2C_EV_IRQn, DRV_I2C_IRQ_PRIO);
+    NVIC_SetPriority(DRV_I2C_ER_IRQn, DRV_I2C_IRQ_PRIO);
+    NVIC_EnableIRQ(DRV_I2C_EV_IRQn);
+    NVIC_EnableIRQ(DRV_I2C_ER_IRQn);
+#if DRV_I2C_USE_DMA
+    RCC->AHB1ENR |= DRV_I2C_DMA_RCC_BIT;
+    NVIC_SetPriority(DRV_I2C_DMA_RX_IRQn, DRV_I2C_IRQ_PRIO);
+    NVIC_EnableIRQ(DRV_I2C_DMA_RX_IRQn);
+#endif
+    drv_cycles_init();
+    async_on = 1;
+}
+
+int i2c1_xfer_submit(i2c1_xfer_t *x){
+    if (x == NULL || x->op > I2C1_OP_READ) return -1;
+    if (x->op == I2C1_OP_READ && (x->len == 0 || x->buf == NULL)) return -1;
+    if (x->len && x->buf == NULL) return -1;
+
+    x->status = I2C1_PENDING;
+    x->next = NULL;
+
+    uint32_t pm = drv_irq_save();
+    /* depois de todas as de prioridade >= (FIFO no mesmo nível) */
+    i2c1_xfer_t *p = q_head;
+    if (p == NULL || p->prio < x->prio){
+        x->next = p;
+        q_head = x;
+    } else {
+        while (p->next && p->next->prio >= x->prio) p = p->next;
+        x->next = p->next;
+        p->next = x;
+    }
+    if (cur == NULL) start_next();
+    drv_irq_restore(pm);
+    return 0;
+}
+
+/* 9 pulsos + STOP + reinit (~100 us) em contexto de task, com IRQs
+   ligados: quem detecta o erro (ISR, seção crítica) só marca. Uma task
+   só faz; as outras seguem esperando a fila. */
+static void recover_run(void){
+    uint32_t pm = drv_irq_save();
+    int mine = (recover_pending == 1u && cur == NULL);
+    if (mine) recover_pending = 2u;
+    drv_irq_restore(pm);
+    if (!mine) return;
+
+    (void)i2c1_bus_recover();
+
+    pm = drv_irq_save();
+    recover_pending = 0;
+    if (cur == NULL) start_next();
+    drv_irq_restore(pm);
+}
+
+void i2c1_async_poll(void){
+    i2c1_xfer_t *x = NULL;
+    uint32_t pm = drv_irq_save();
+    if (cur && (drv_cycles() - cur->t0) > xfer_timeout_cyc(cur)){
+        x = detach();
+        i2c1_stats.timeout++;
+        recover_pending = 1u;                      /* fila parada até recover_run */
+    }
+    drv_irq_restore(pm);
+    /* callback e notify (API de task) fora da seção crítica */
+    complete(x, I2C1_ERR_TIMEOUT, 0);
+    if (recover_pending == 1u) recover_run();
+}
+
+int i2c1_xfer_wait(i2c1_xfer_t *x){
+#ifdef DRIVERS_FREERTOS
+    /* Com escalonador rodando: dorme até o ISR notificar (ou 1 timeout) */
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING && x->notify == xTaskGetCurrentTaskHandle()){
+        TickType_t ticks = pdMS_TO_TICKS(i2c1_xfer_timeout_us(x) / 1000u) + 1;
+        while (x->status == I2C1_PENDING){
+            ulTaskNotifyTakeIndexed(DRV_I2C_NOTIFY_INDEX, pdTRUE, ticks);
+            i2c1_async_poll();
+        }
+        if (recover_pending == 1u) recover_run();   /* erro veio do ER ISR */
+        return x->status;
+    }
+#endif
+    while (x->status == I2C1_PENDING) i2c1_async_poll();
+    if (recover_pending == 1u) recover_run();
+    return x->status;
+}
+
+int i2c1_xfer_run(i2c1_xfer_t *x){
+#ifdef DRIVERS_FREERTOS
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) x->notify = xTaskGetCurrentTaskHandle();
+#endif
+    if (i2c1_xfer_submit(x) < 0) return I2C1_ERR_BUS;
+    return i2c1_xfer_wait(x);
+}
+
+/* ================================ ISRs ============================== */
+void DRV_I2C_EV_IRQHandler(void){
+    i2c1_xfer_t *x = cur;
+    uint32_t sr1 = DRV_I2C->SR1;
+    if (x == NULL){
+        DRV_I2C->CR2 &= ~CR2_IT_ALL;
+        if (stop_wait) start_next();               /* START adiado pelo STOP */
+        return;
+    }
+
+    if (sr1 & I2C_SR1_SB){
+        if (st == ST_START){ DRV_I2C->DR = (uint8_t)(x->addr7 << 1);       st = ST_ADDR_W; }
+        else               { DRV_I2C->DR = (uint8_t)((x->addr7 << 1) | 1u); st = ST_ADDR_R; }
+        return;
+    }
+
+    if (sr1 & I2C_SR1_ADDR){
+        if (st == ST_ADDR_W){
+            (void)DRV_I2C->SR2;
+            st = ST_REG;
+            return;
+        }
+        /* addr+R: configura ACK/POS (ou DMA) antes de limpar ADDR */
+#if DRV_I2C_USE_DMA
+        if (x->len >= 2){
+            rx_dma_start(x->buf, x->len);
+            DRV_I2C->CR2 &= ~I2C_CR2_ITBUFEN;
+            DRV_I2C->CR2 |= I2C_CR2_DMAEN | I2C_CR2_LAST;
+            DRV_I2C->CR1 |= I2C_CR1_ACK;
+            (void)DRV_I2C->SR2;
+            st = ST_RX_DMA;
+            return;
+        }
+#endif
+        if (x->len == 1){
+            DRV_I2C->CR1 &= ~I2C_CR1_ACK;
+            (void)DRV_I2C->SR2;
+            DRV_I2C->CR1 |= I2C_CR1_STOP;
+            DRV_I2C->CR2 |= I2C_CR2_ITBUFEN;
+        } else if (x->len == 2){
+            DRV_I2C->CR1 |= I2C_CR1_POS;
+            DRV_I2C->CR1 &= ~I2C_CR1_ACK;
+            (void)DRV_I2C->SR2;
+            DRV_I2C->CR2 &= ~I2C_CR2_ITBUFEN;          /* fecha com BTF */
+        } else {
+            DRV_I2C->CR1 |= I2C_CR1_ACK;
+            (void)DRV_I2C->SR2;
+            if (x->len == 3) DRV_I2C->CR2 &= ~I2C_CR2_ITBUFEN;
+            else             DRV_I2C->CR2 |=  I2C_CR2_ITBUFEN;
+        }
+        st = ST_RX;
+        return;
+    }
+
+    switch (st){
+        case ST_REG:
+            if (sr1 & I2C_SR1_TXE){
+                DRV_I2C->DR = x->reg;
+                if (x->op == I2C1_OP_WRITE && x->len){
+                    st = ST_TX;
+                } else {
+                    /* só reg (ou leitura): próximo evento é BTF */
+                    DRV_I2C->CR2 &= ~I2C_CR2_ITBUFEN;
+                    st = (x->op == I2C1_OP_READ) ? ST_REG_SENT : ST_TX_LAST;
+                }
+            }
+            break;
+
+        case ST_TX:
+            if (sr1 & I2C_SR1_TXE){
+                DRV_I2C->DR = x->buf[idx++];
+                if (idx == x->len){
+                    DRV_I2C->CR2 &= ~I2C_CR2_ITBUFEN;
+                    st = ST_TX_LAST;
+                }
+            }
+            break;
+
+        case ST_TX_LAST:
+            if (sr1 & I2C_SR1_BTF){
+                DRV_I2C->CR1 |= I2C_CR1_STOP;
+                finish(I2C1_OK, 1);
+            }
+            break;
+
+        case ST_REG_SENT:
+            if (sr1 & I2C_SR1_BTF){
+                DRV_I2C->CR1 |= I2C_CR1_START;
+                st = ST_RESTART;
+            }
+            break;
+
+        case ST_RX: {
+            uint32_t rem = (uint32_t)x->len - idx;
+            if ((sr1 & I2C_SR1_BTF) && rem == 3u){
+                /* N-2 em DR, N-1 no shift: NACK para o último */
+                DRV_I2C->CR1 &= ~I2C_CR1_ACK;
+                x->buf[idx++] = (uint8_t)DRV_I2C->DR;
+            } else if ((sr1 & I2C_SR1_BTF) && rem == 2u){
+                DRV_I2C->CR1 |= I2C_CR1_STOP;
+                x->buf[idx++] = (uint8_t)DRV_I2C->DR;
+                x->buf[idx++] = (uint8_t)DRV_I2C->DR;
+                finish(I2C1_OK, 1);
+            } else if (sr1 & I2C_SR1_RXNE){
+                if (rem == 1u){
+                    x->buf[idx++] = (uint8_t)DRV_I2C->DR;
+                    finish(I2C1_OK, 1);
+                } else if (rem > 3u){
+                    x->buf[idx++] = (uint8_t)DRV_I2C->DR;
+                    if (rem - 1u == 3u) DRV_I2C->CR2 &= ~I2C_CR2_ITBUFEN;
+                }
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+#if DRV_I2C_USE_DMA
+void DRV_I2C_DMA_RX_IRQHandler(void){
+    uint32_t isr = dma_isr(DRV_I2C_DMA, DRV_I2C_DMA_RX_NUM);
+    dma_clear(DRV_I2C_DMA, DRV_I2C_DMA_RX_NUM, DMA_FLAGS_ALL(DRV_I2C_DMA_RX_NUM));
+    if (st != ST_RX_DMA) return;
+
+    /* último byte já veio com NACK (LAST): só falta o STOP */
+    DRV_I2C->CR1 |= I2C_CR1_STOP;
+    finish((isr & DMA_FLAG_TE(DRV_I2C_DMA_RX_NUM)) ? I2C1_ERR_BUS : I2C1_OK, 1);
+}
+#endif
+
+void DRV_I2C_ER_IRQHandler(void){
+    uint32_t sr1 = DRV_I2C->SR1;
+    uint32_t err = sr1 & (I2C_SR1_AF | I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_OVR | I2C_SR1_TIMEOUT);
+    DRV_I2C->SR1 = (uint16_t)~err;                 /* rc_w0 */
+
+    if (err & I2C_SR1_AF)   i2c1_stats.nack++;
+    if (err & I2C_SR1_ARLO) i2c1_stats.arlo++;
+    if (err & (I2C_SR1_BERR | I2C_SR1_OVR)) i2c1_stats.berr++;
+
+    if (cur == NULL) return;
+    if (err & I2C_SR1_AF){
+        DRV_I2C->CR1 |= I2C_CR1_STOP;              /* NACK: libera o barramento */
+        finish(I2C1_ERR_NACK, 1);
+    } else if (err){
+        /* ARLO/BERR: estado do bus incerto; a recuperação fica para a task
+           (i2c1_xfer_wait/poll) e a fila só anda depois dela */
+        DRV_I2C->CR2 &= ~CR2_IT_ALL;
+        recover_pending = 1u;
+        finish(I2C1_ERR_BUS, 1);
+    }
+}
+#endif /* !DRIVERS_NATIVE */
@@ -0,0 +1,64 @@
+#include <stddef.h>
+#include "i2c1.h"
+
+#ifdef DRIVERS_FREERTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+/* Handles de dispositivo sobre a fila de transações (i2c1_async.c no alvo,
+   i2c1_native.c no host). */
+
+static void *waiter(void){
+#ifdef DRIVERS_FREERTOS
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) return xTaskGetCurrentTaskHandle();
+#endif
+    return NULL;
+}
+
+static void xfer_fill(i2c1_xfer_t *x, const i2c1_dev_t *d, uint8_t op,
+                      uint8_t reg, uint8_t *buf, uint16_t len, void *task){
+    *x = (i2c1_xfer_t){
+        .addr7 = d->addr7, .reg = reg, .op = op, .prio = d->prio,
+        .buf = buf, .len = len, .timeout_us = d->timeout_us, .notify = task
+    };
+}
+
+int i2c1_dev_write(const i2c1_dev_t *d, uint8_t reg, const uint8_t *buf, uint16_t len){
+    if (!i2c1_async_enabled()) return i2c1_write_multi(d->addr7, reg, buf, len);
+    i2c1_xfer_t x;
+    xfer_fill(&x, d, I2C1_OP_WRITE, reg, (uint8_t *)buf, len, waiter());
+    if (i2c1_xfer_submit(&x) < 0) return -1;
+    return (i2c1_xfer_wait(&x) == I2C1_OK) ? 0 : -1;
+}
+
+int i2c1_dev_read(const i2c1_dev_t *d, uint8_t reg, uint8_t *buf, uint16_t len){
+    const i2c1_sg_t sg = { reg, buf, len };
+    return i2c1_dev_read_sg(d, &sg, 1);
+}
+
+int i2c1_dev_read_sg(const i2c1_dev_t *d, const i2c1_sg_t *sg, uint32_t n){
+    if (n == 0 || n > I2C1_SG_MAX) return -1;
+    for (uint32_t i = 0; i < n; i++)
+        if (sg[i].len == 0 || sg[i].buf == NULL) return -1;
+    if (!i2c1_async_enabled()){
+        for (uint32_t i = 0; i < n; i++)
+            if (i2c1_read_multi(d->addr7, sg[i].reg, sg[i].buf, sg[i].len) < 0) return -1;
+        return 0;
+    }
+
+    /* Tudo na fila de uma vez. Mesmo nível = FIFO, então quando o último
+       termina os anteriores já terminaram: só ele notifica a task. Um erro
+       no meio não cancela os seguintes (já estão na fila), só o resultado. */
+    i2c1_xfer_t x[I2C1_SG_MAX];
+    for (uint32_t i = 0; i < n; i++){
+        xfer_fill(&x[i], d, I2C1_OP_READ, sg[i].reg, sg[i].buf, sg[i].len,
+                  (i == n - 1u) ? waiter() : NULL);
+        (void)i2c1_xfer_submit(&x[i]);
+    }
+
+    int ok = (i2c1_xfer_wait(&x[n - 1u]) == I2C1_OK);
+    for (uint32_t i = 0; i + 1u < n; i++)
+        if (x[i].status != I2C1_OK) ok = 0;
+    return ok ? 0 : -1;
+}
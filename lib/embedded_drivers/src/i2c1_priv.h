@@ -0,0 +1,6 @@
+#pragma once
+/* Estado compartilhado entre o caminho bloqueante (i2c1.c) e o por
+   interrupção (i2c1_async.c). */
+#include "i2c1.h"
+
+extern i2c1_stats_t i2c1_stats;
@@ -0,0 +1,323 @@
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include "log_task.h"
+#include "serial_stdio.h"
+
+#ifdef DRIVERS_FREERTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+#define RING_MASK   (LOG_RING_SIZE - 1u)
+#define HDR         4u
+#define F_COMMIT    (1u << 24)
+#define F_PAD       (1u << 25)
+_Static_assert((LOG_RING_SIZE & RING_MASK) == 0u, "LOG_RING_SIZE: potência de 2");
+_Static_assert(LOG_REC_MAX + HDR <= LOG_RING_SIZE / 4u, "LOG_REC_MAX grande demais para o anel");
+
+/* Registros alinhados em 4 B, nunca atravessam o fim (sobra vira PAD):
+     cabeçalho (len 16 b | nível 8 b | COMMIT | PAD) + ponteiro do formato
+     + argumentos. head é reservado por CAS; o consumidor só passa de um
+     cabeçalho com COMMIT e zera o que leu antes de devolver (espaço recém
+     reservado sempre lê 0 = não pronto). */
+static _Alignas(4) uint8_t ring[LOG_RING_SIZE];
+static uint32_t head, tail;                      /* corridos, __atomic */
+static volatile uint8_t s_mask = (1u << LOG_LEVELS) - 1u;
+static uint8_t s_queued;
+static uint32_t s_reported;
+static log_stats_t s_stats;
+static void (*s_sink)(const char *line) = serial_write;
+
+static inline void stat_inc(uint32_t *c){ __atomic_fetch_add(c, 1u, __ATOMIC_RELAXED); }
+
+void log_init(void){ s_queued = 1; }
+void log_set_sink(void (*sink)(const char *line)){ s_sink = sink ? sink : serial_write; }
+const log_stats_t *log_get_stats(void){ return &s_stats; }
+
+void log_set_level(uint8_t max_level){
+    s_mask = (uint8_t)((2u << (max_level < LOG_LEVELS ? max_level : LOG_LEVELS - 1u)) - 1u);
+}
+void log_enable(uint8_t level, int on){
+    if (level >= LOG_LEVELS) return;
+    if (on) s_mask |= (uint8_t)(1u << level);
+    else    s_mask &= (uint8_t)~(1u << level);
+}
+int log_enabled(uint8_t level){ return level < LOG_LEVELS && (s_mask & (1u << level)) != 0u; }
+
+/* ============================ Conversões ============================ */
+/* O produtor e o consumidor leem o formato do mesmo jeito: o tipo de cada
+   argumento sai da conversão, como no va_arg do printf. */
+typedef struct {
+    char spec[16];      /* "%", flags, largura, precisão (sem tamanho/conversão) */
+    uint8_t n;
+    char len;           /* 0, 'h', 'H' (hh), 'l', 'q' (ll/j), 'z', 't', 'L' */
+    char conv;
+    uint8_t star_w, star_p;
+} spec_t;
+
+static void spec_add(spec_t *s, char c){ if (s->n < sizeof(s->spec) - 1u) s->spec[s->n++] = c; }
+
+/* c aponta para depois do '%'. Retorna o ponteiro depois da conversão. */
+static const char *spec_parse(const char *c, spec_t *s){
+    memset(s, 0, sizeof(*s));
+    spec_add(s, '%');
+    while (*c && strchr("-+ #0", *c)) spec_add(s, *c++);
+    if (*c == '*'){ s->star_w = 1; c++; } else while (*c >= '0' && *c <= '9') spec_add(s, *c++);
+    if (*c == '.'){
+        spec_add(s, *c++);
+        if (*c == '*'){ s->star_p = 1; c++; } else while (*c >= '0' && *c <= '9') spec_add(s, *c++);
+    }
+    if (*c == 'h'){ s->len = 'h'; if (*++c == 'h'){ s->len = 'H'; c++; } }
+    else if (*c == 'l'){ s->len = 'l'; if (*++c == 'l'){ s->len = 'q'; c++; } }
+    else if (*c == 'j'){ s->len = 'q'; c++; }
+    else if (*c == 'z' || *c == 't' || *c == 'L'){ s->len = *c++; }
+    s->conv = *c;
+    return *c ? c + 1 : c;
+}
+
+/* Tamanho guardado de um inteiro (0 = não é inteiro). */
+static uint32_t int_size(const spec_t *s){
+    if (!strchr("diuxXoc", s->conv)) return 0u;
+    if (s->conv == 'c') return sizeof(int);
+    switch (s->len){
+    case 'l': return sizeof(long);
+    case 'q': return sizeof(long long);
+    case 'z': return sizeof(size_t);
+    case 't': return sizeof(ptrdiff_t);
+    default:  return sizeof(int);
+    }
+}
+
+/* ============================== Produtor ============================ */
+#define PUT(v) do { if (n + sizeof(v) > room){ full = 1; break; } \
+                    memcpy(d + n, &(v), sizeof(v)); n += (uint32_t)sizeof(v); } while (0)
+
+static uint32_t capture(uint8_t *d, uint32_t room, const char *fmt, va_list ap, int *cut){
+    uint32_t n = 0;
+    int full = 0;
+    for (const char *c = fmt; *c && !full; ){
+        if (*c++ != '%') continue;
+        if (*c == '%'){ c++; continue; }
+        spec_t s;
+        c = spec_parse(c, &s);
+        if (s.star_w){ int w = va_arg(ap, int); PUT(w); }
+        if (s.star_p && !full){ int p = va_arg(ap, int); PUT(p); }
+        if (full) break;
+        uint32_t isz = int_size(&s);
+        if (isz == sizeof(long long) && isz != sizeof(long)){ long long v = va_arg(ap, long long); PUT(v); }
+        else if (isz == sizeof(long) && isz != sizeof(int)){ long v = va_arg(ap, long); PUT(v); }
+        else if (isz){ int v = va_arg(ap, int); PUT(v); }
+        else if (strchr("fFeEgGaA", s.conv)){
+            double v = (s.len == 'L') ? (double)va_arg(ap, long double) : va_arg(ap, double);
+            PUT(v);
+        }
+        else if (s.conv == 'p'){ void *v = va_arg(ap, void *); PUT(v); }
+        else if (s.conv == 's'){
+            const char *str = va_arg(ap, const char *);
+            if (str == NULL) str = "(null)";
+            if (n >= room){ full = 1; break; }
+            uint32_t len = 0, max = room - n - 1u;
+            if (max > 255u) max = 255u;
+            while (str[len] && len < max) len++;
+            if (str[len]) *cut = 1;
+            d[n++] = (uint8_t)len;
+            memcpy(d + n, str, len);
+            n += len;
+        }
+        else if (s.conv == 'n') (void)va_arg(ap, void *);   /* não escreve nada */
+    }
+    if (full) *cut = 1;
+    return n;
+}
+
+/* Reserva len bytes (múltiplo de 4). NULL se não couber. */
+static uint8_t *reserve(uint32_t len){
+    uint32_t h = __atomic_load_n(&head, __ATOMIC_RELAXED), need, off;
+    do {
+        uint32_t t = __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+        off = h & RING_MASK;
+        need = (LOG_RING_SIZE - off < len) ? (LOG_RING_SIZE - off) + len : len;
+        if (LOG_RING_SIZE - (h - t) < need) return NULL;
+    } while (!__atomic_compare_exchange_n(&head, &h, h + need, 1, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    /* pico por CAS: outro produtor ou ISR pode estar subindo ao mesmo tempo */
+    uint32_t used = h + need - __atomic_load_n(&tail, __ATOMIC_RELAXED);
+    uint32_t hw = __atomic_load_n(&s_stats.high_water, __ATOMIC_RELAXED);
+    while (used > hw &&
+           !__atomic_compare_exchange_n(&s_stats.high_water, &hw, used, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) { }
+    if (need != len){                                   /* sobra até o fim vira PAD */
+        __atomic_store_n((uint32_t *)&ring[off], (LOG_RING_SIZE - off) | F_PAD | F_COMMIT, __ATOMIC_RELEASE);
+        off = 0u;
+    }
+    return &ring[off];
+}
+
+void log_vprintf(uint8_t level, const char *fmt, va_list ap){
+    if (!log_enabled(level)){ stat_inc(&s_stats.filtered); return; }
+    if (!s_queued){ vprintf(fmt, ap); return; }
+
+    _Alignas(4) uint8_t rec[LOG_REC_MAX];
+    int cut = 0;
+    memcpy(rec, &fmt, sizeof(fmt));
+    va_list aq;
+    va_copy(aq, ap);
+    uint32_t n = (uint32_t)sizeof(fmt) + capture(rec + sizeof(fmt), LOG_REC_MAX - sizeof(fmt), fmt, aq, &cut);
+    va_end(aq);
+    if (cut) stat_inc(&s_stats.truncated);
+
+    uint32_t len = (HDR + n + 3u) & ~3u;
+    uint8_t *p = reserve(len);
+    if (p == NULL){ stat_inc(&s_stats.dropped); return; }
+    memcpy(p + HDR, rec, n);
+    __atomic_store_n((uint32_t *)p, len | ((uint32_t)level << 16) | F_COMMIT, __ATOMIC_RELEASE);
+    stat_inc(&s_stats.queued);
+}
+
+void log_printf(uint8_t level, const char *fmt, ...){
+    va_list ap;
+    va_start(ap, fmt);
+    log_vprintf(level, fmt, ap);
+    va_end(ap);
+}
+
+/* ============================= Consumidor =========================== */
+typedef struct { const uint8_t *p, *end; int ok; } rd_t;
+
+static int rd(rd_t *r, void *v, uint32_t n){
+    if ((uint32_t)(r->end - r->p) < n){ r->ok = 0; return 0; }
+    memcpy(v, r->p, n);
+    r->p += n;
+    return 1;
+}
+
+static long rd_int(rd_t *r, uint32_t size, int is_signed){
+    if (size == sizeof(long long) && size != sizeof(long)){ long long v = 0; rd(r, &v, size); return (long)v; }
+    if (size == sizeof(long) && size != sizeof(int)){ long v = 0; rd(r, &v, size); return v; }
+    int v = 0;
+    rd(r, &v, sizeof(v));
+    return is_signed ? (long)v : (long)(unsigned)v;
+}
+
+/* Formata um registro como o printf faria. Só esta função chama o newlib.
+   Sem long long no newlib-nano: ll/j saem pelo caminho de long (igual ao
+   printf dele). */
+static void render(char *out, uint32_t max, const uint8_t *p, uint32_t n){
+    rd_t r = { p, p + n, 1 };
+    const char *fmt = "";
+    uint32_t o = 0;
+    rd(&r, &fmt, sizeof(fmt));
+    for (const char *c = fmt; *c && o + 1u < max; ){
+        if (*c != '%'){ out[o++] = *c++; continue; }
+        if (c[1] == '%'){ out[o++] = '%'; c += 2; continue; }
+        spec_t s;
+        char sp[sizeof(s.spec) + 2 * 11 + 3];   /* spec, dois int, tamanho/conversão e '\0' */
+        c = spec_parse(c + 1, &s);
+        if (!r.ok || (r.p >= r.end && s.conv != 'n')){
+            int k = snprintf(out + o, max - o, "<?>");
+            o += (k > 0) ? (uint32_t)k : 0u;
+            continue;
+        }
+        int w = 0, pr = 0;
+        if (s.star_w) rd(&r, &w, sizeof(w));
+        if (s.star_p) rd(&r, &pr, sizeof(pr));
+        /* spec[] tem os '*' já trocados pelos valores lidos */
+        if (s.star_w || s.star_p){
+            char base[16];
+            memcpy(base, s.spec, s.n);
+            base[s.n] = '\0';
+            char *dot = strchr(base, '.');
+            if (dot) *dot = '\0';
+            uint32_t k = (uint32_t)snprintf(sp, sizeof(sp), "%s", base);
+            if (s.star_w) k += (uint32_t)snprintf(sp + k, sizeof(sp) - k, "%d", w);
+            if (dot){
+                k += (uint32_t)snprintf(sp + k, sizeof(sp) - k, ".");
+                if (s.star_p) k += (uint32_t)snprintf(sp + k, sizeof(sp) - k, "%d", pr);
+                else k += (uint32_t)snprintf(sp + k, sizeof(sp) - k, "%s", dot + 1);
+            }
+            (void)k;
+        } else {
+            memcpy(sp, s.spec, s.n);
+            sp[s.n] = '\0';
+        }
+        uint32_t sl = (uint32_t)strlen(sp);
+        if (sl > sizeof(sp) - 3u) sl = sizeof(sp) - 3u;     /* sempre cabe 'l', conversão e '\0' */
+        int k = 0;
+        uint32_t isz = int_size(&s);
+        if (isz){
+            long v = rd_int(&r, isz, strchr("dic", s.conv) != NULL);
+            if (s.conv == 'c'){ sp[sl] = 'c'; sp[sl + 1] = '\0'; k = snprintf(out + o, max - o, sp, (int)v); }
+            else {
+                if (s.len == 'h') v = strchr("di", s.conv) ? (long)(short)v : (long)(unsigned short)v;
+                if (s.len == 'H') v = strchr("di", s.conv) ? (long)(signed char)v : (long)(unsigned char)v;
+                sp[sl] = 'l'; sp[sl + 1] = s.conv; sp[sl + 2] = '\0';
+                if (strchr("di", s.conv)) k = snprintf(out + o, max - o, sp, v);
+                else k = snprintf(out + o, max - o, sp, (unsigned long)v);
+            }
+        } else if (strchr("fFeEgGaA", s.conv)){
+            double v = 0.0;
+            rd(&r, &v, sizeof(v));
+            sp[sl] = s.conv; sp[sl + 1] = '\0';
+            k = snprintf(out + o, max - o, sp, v);
+        } else if (s.conv == 'p'){
+            void *v = NULL;
+            rd(&r, &v, sizeof(v));
+            k = snprintf(out + o, max - o, "%p", v);
+        } else if (s.conv == 's'){
+            uint8_t len = 0;
+            static char str[256];          /* fora da pilha da LOG: um consumidor só */
+            rd(&r, &len, 1u);
+            if (!rd(&r, str, len)) len = 0;
+            str[len] = '\0';
+            sp[sl] = 's'; sp[sl + 1] = '\0';
+            k = snprintf(out + o, max - o, sp, str);
+        }
+        if (k > 0) o += (uint32_t)k;
+        if (o >= max){ o = max - 1u; stat_inc(&s_stats.truncated); }
+    }
+    out[o] = '\0';
+}
+
+uint32_t log_poll(void){
+    static char line[LOG_LINE_MAX];
+    uint32_t lines = 0;
+    uint32_t t = __atomic_load_n(&tail, __ATOMIC_RELAXED);
+    for (;;){
+        if (t == __atomic_load_n(&head, __ATOMIC_ACQUIRE)) break;
+        uint8_t *p = &ring[t & RING_MASK];
+        uint32_t h = __atomic_load_n((uint32_t *)p, __ATOMIC_ACQUIRE);
+        if (!(h & F_COMMIT)) break;                 /* produtor ainda escrevendo */
+        uint32_t len = h & 0xFFFFu;
+        if (!(h & F_PAD)){
+            render(line, sizeof(line), p + HDR, len - HDR);
+            s_sink(line);
+            s_stats.written++;
+            lines++;
+        }
+        memset(p, 0, len);
+        t += len;
+        __atomic_store_n(&tail, t, __ATOMIC_RELEASE);
+    }
+    uint32_t d = __atomic_load_n(&s_stats.dropped, __ATOMIC_RELAXED);
+    if (d != s_reported){
+        snprintf(line, sizeof(line), "[LOG] %lu mensagens descartadas\n", (unsigned long)(d - s_reported));
+        s_reported = d;
+        s_sink(line);
+    }
+    return lines;
+}
+
+#ifdef DRIVERS_FREERTOS
+static void log_task(void *arg){
+    (void)arg;
+    for (;;){
+        log_poll();
+        vTaskDelay(pdMS_TO_TICKS(LOG_TASK_PERIOD_MS));
+    }
+}
+
+int log_task_start(uint32_t prio){
+    log_init();
+    return (xTaskCreate(log_task, "LOG", LOG_TASK_STACK, NULL, (UBaseType_t)prio, NULL) == pdPASS) ? 0 : -1;
+}
+#endif
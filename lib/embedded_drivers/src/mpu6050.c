@@ -0,0 +1,252 @@
+#include <string.h>
+#include "mpu6050.h"
+#include "drv_time.h"
+
+/* Taxa = s_gyro_hz / s_div exatos (1000/33 = 30.30 Hz, não 30) */
+static uint16_t s_gyro_hz = 1000, s_div = 10;
+static uint8_t  s_dlpf = 3;      /* o que o init escreve */
+static mpu6050_fifo_stats_t fifo_stats;
+static uint64_t s_fifo_t;        /* carimbo da leitura do FIFO_COUNT   */
+static uint32_t s_fifo_frames;   /* quadros na FIFO naquele instante   */
+
+/* Leituras de amostras passam na frente do tráfego de configuração. */
+mpu6050_t mpu6050_main = {
+    { MPU6050_ADDR, I2C1_PRIO_HIGH, 0 },
+    { 0, 0, 4000, 500275, 1.0f / 16384.0f, 1.0f / 131.0f }
+};
+#define MAIN_ADDR (mpu6050_main.bus.addr7)
+
+/* mg/LSB = 2000/32768 << afs = 4000/65536 << afs: Q16 exato.
+   mdps/LSB = 1000/131 << fs (tabela do datasheet: 131, 65.5, 32.8, 16.4). */
+static void scale_set(mpu6050_scale_t *s, uint8_t afs, uint8_t fs) {
+    s->afs = afs;
+    s->fs  = fs;
+    s->accel_mg_q16  = 4000 << afs;
+    s->gyro_mdps_q16 = 500275 << fs;
+    s->accel_g_lsb  = (float)(1u << afs) / 16384.0f;
+    s->gyro_dps_lsb = (float)(1u << fs) / 131.0f;
+}
+
+int mpu6050_dev_init(mpu6050_t *m, uint8_t addr7) {
+    uint8_t who;
+    m->bus = (i2c1_dev_t){ addr7, I2C1_PRIO_HIGH, 0 };
+    // presença: WHO_AM_I com ACK (valor não conferido, clones variam)
+    if (i2c1_read_reg(addr7, MPU6050_REG_WHOAMI, &who) < 0) return -1;
+    // Wake up
+    if (i2c1_write_reg(addr7, MPU6050_REG_PWR1, 0x00) < 0) return -1;
+    // LPF ~42 Hz, gyro ±250 dps, accel ±2g, SampleRate 1k/(1+SMPLRT_DIV) -> 100 Hz (div=9)
+    if (i2c1_write_reg(addr7, MPU6050_REG_CONFIG, 0x03) < 0) return -1;
+    if (i2c1_write_reg(addr7, MPU6050_REG_GYROCFG, 0x00) < 0) return -1;
+    if (i2c1_write_reg(addr7, MPU6050_REG_ACCELCFG, 0x00) < 0) return -1;
+    if (i2c1_write_reg(addr7, MPU6050_REG_SMPLRT, 9)    < 0) return -1;
+    scale_set(&m->scale, MPU6050_ACCEL_2G, MPU6050_GYRO_250DPS);
+    return 0;
+}
+
+int mpu6050_init(void) {
+    return mpu6050_dev_init(&mpu6050_main, MAIN_ADDR);
+}
+
+_Static_assert(sizeof(mpu6050_raw_t) == MPU6050_FIFO_FRAME, "quadro da FIFO = mpu6050_raw_t");
+
+/* Bloco big-endian AX AY AZ T GX GY GZ: 3 palavras com REV16 (2 eixos por
+   instrução) + GZ. memcpy vira LDR (M4 aceita desalinhado). Lê tudo antes
+   de escrever, então funciona in-place. */
+void mpu6050_decode(const uint8_t *buf, mpu6050_raw_t *out) {
+    uint32_t w0, w1, w2;
+    memcpy(&w0, buf + 0, 4);
+    memcpy(&w1, buf + 4, 4);
+    memcpy(&w2, buf + 8, 4);
+    int16_t gz = (int16_t)((buf[12]<<8) | buf[13]);
+    w0 = drv_rev16(w0);
+    w1 = drv_rev16(w1);
+    w2 = drv_rev16(w2);
+    out->ax = (int16_t)w0;
+    out->ay = (int16_t)(w0 >> 16);
+    out->az = (int16_t)w1;
+    out->temp_raw = (int16_t)(w1 >> 16);
+    out->gx = (int16_t)w2;
+    out->gy = (int16_t)(w2 >> 16);
+    out->gz = gz;
+}
+
+int mpu6050_dev_read(mpu6050_t *m, mpu6050_raw_t *out) {
+    uint8_t buf[14];
+    if (i2c1_dev_read(&m->bus, MPU6050_REG_ACCEL, buf, 14) < 0) return -1;
+    mpu6050_decode(buf, out);
+    return 0;
+}
+
+int mpu6050_read_all(mpu6050_raw_t *out) {
+    return mpu6050_dev_read(&mpu6050_main, out);
+}
+
+int mpu6050_read_sample(mpu6050_sample_t *out) {
+    out->t_cyc = drv_cycles64();
+    return mpu6050_read_all(&out->raw);
+}
+
+int mpu6050_dev_read_start(mpu6050_t *m, mpu6050_async_t *a, i2c1_done_fn done, void *arg) {
+    a->xfer = (i2c1_xfer_t){
+        .addr7 = m->bus.addr7, .reg = MPU6050_REG_ACCEL, .op = I2C1_OP_READ, .prio = m->bus.prio,
+        .buf = a->buf, .len = sizeof(a->buf), .done = done, .arg = arg
+    };
+    return i2c1_xfer_submit(&a->xfer);
+}
+
+int mpu6050_read_start(mpu6050_async_t *a, i2c1_done_fn done, void *arg) {
+    return mpu6050_dev_read_start(&mpu6050_main, a, done, arg);
+}
+
+/* ============================== Escalas ============================== */
+int mpu6050_dev_set_accel_range(mpu6050_t *m, uint8_t afs) {
+    if (afs > MPU6050_ACCEL_16G) return -1;
+    if (i2c1_write_reg(m->bus.addr7, MPU6050_REG_ACCELCFG, (uint8_t)(afs << 3)) < 0) return -1;
+    scale_set(&m->scale, afs, m->scale.fs);
+    return 0;
+}
+
+int mpu6050_dev_set_gyro_range(mpu6050_t *m, uint8_t fs) {
+    if (fs > MPU6050_GYRO_2000DPS) return -1;
+    if (i2c1_write_reg(m->bus.addr7, MPU6050_REG_GYROCFG, (uint8_t)(fs << 3)) < 0) return -1;
+    scale_set(&m->scale, m->scale.afs, fs);
+    return 0;
+}
+
+int mpu6050_set_accel_range(uint8_t afs) { return mpu6050_dev_set_accel_range(&mpu6050_main, afs); }
+int mpu6050_set_gyro_range(uint8_t fs)   { return mpu6050_dev_set_gyro_range(&mpu6050_main, fs); }
+
+void mpu6050_autorange_init(mpu6050_autorange_t *a, uint16_t hold) {
+    *a = (mpu6050_autorange_t){
+        .min_afs = MPU6050_ACCEL_2G,    .max_afs = MPU6050_ACCEL_16G,
+        .min_fs  = MPU6050_GYRO_250DPS, .max_fs  = MPU6050_GYRO_2000DPS,
+        .hold = hold ? hold : 1u
+    };
+}
+
+static int32_t abs_max3(int16_t x, int16_t y, int16_t z) {
+    int32_t a = x < 0 ? -(int32_t)x : x;
+    int32_t b = y < 0 ? -(int32_t)y : y;
+    int32_t c = z < 0 ? -(int32_t)z : z;
+    if (b > a) a = b;
+    return (c > a) ? c : a;
+}
+
+/* Próximo passo: +1 se saturou, -1 depois de 'hold' amostras pequenas. */
+static int range_step(int32_t peak, uint8_t cur, uint8_t lo, uint8_t hi,
+                      uint16_t *small, uint16_t hold) {
+    if (peak >= MPU6050_AUTORANGE_SAT) {
+        *small = 0;
+        return (cur < hi) ? 1 : 0;
+    }
+    if (peak >= MPU6050_AUTORANGE_LOW || cur <= lo) { *small = 0; return 0; }
+    if (++*small < hold) return 0;
+    *small = 0;
+    return -1;
+}
+
+int mpu6050_autorange(mpu6050_autorange_t *a, const mpu6050_raw_t *r) {
+    int changed = 0;
+    int da = range_step(abs_max3(r->ax, r->ay, r->az), mpu6050_scale.afs,
+                        a->min_afs, a->max_afs, &a->acc_small, a->hold);
+    int dg = range_step(abs_max3(r->gx, r->gy, r->gz), mpu6050_scale.fs,
+                        a->min_fs, a->max_fs, &a->gyr_small, a->hold);
+    if (da) {
+        if (mpu6050_set_accel_range((uint8_t)(mpu6050_scale.afs + da)) < 0) return -1;
+        changed = 1;
+    }
+    if (dg) {
+        if (mpu6050_set_gyro_range((uint8_t)(mpu6050_scale.fs + dg)) < 0) return -1;
+        changed = 1;
+    }
+    a->changes += (uint32_t)changed;
+    return changed;
+}
+
+/* ============================ Taxa / DLPF ============================ */
+int mpu6050_set_rate(uint16_t rate_hz, uint8_t dlpf_cfg) {
+    if (dlpf_cfg > 6) dlpf_cfg = 6;
+    if (rate_hz > 1000u) rate_hz = 1000u;
+    uint32_t gyro_hz = (dlpf_cfg == 0) ? 8000u : 1000u;
+    uint32_t div = (rate_hz ? gyro_hz / rate_hz : 256u);
+    if (div < 1u) div = 1u;
+    if (div > 256u) div = 256u;
+
+    if (i2c1_write_reg(MAIN_ADDR, MPU6050_REG_CONFIG, dlpf_cfg) < 0) return -1;
+    if (i2c1_write_reg(MAIN_ADDR, MPU6050_REG_SMPLRT, (uint8_t)(div - 1u)) < 0) return -1;
+    s_gyro_hz = (uint16_t)gyro_hz;
+    s_div = (uint16_t)div;
+    s_dlpf = dlpf_cfg;
+    return 0;
+}
+
+uint16_t mpu6050_get_rate(void) { return (uint16_t)(s_gyro_hz / s_div); }
+uint32_t mpu6050_get_rate_mhz(void) { return (uint32_t)s_gyro_hz * 1000u / s_div; }
+uint8_t  mpu6050_get_dlpf(void) { return s_dlpf; }
+
+/* =============================== FIFO ================================ */
+#define USER_CTRL_FIFO_EN     0x40u
+#define USER_CTRL_FIFO_RESET  0x04u
+#define FIFO_EN_TEMP_XYZG_ACC 0xF8u   /* TEMP | XG | YG | ZG | ACCEL */
+#define INT_STATUS_FIFO_OFLOW 0x10u
+
+/* Desliga, zera e religa: o próximo byte lido é início de quadro. */
+static int fifo_reset(void) {
+    if (i2c1_write_reg(MAIN_ADDR, MPU6050_REG_USER_CTRL, 0x00) < 0) return -1;
+    if (i2c1_write_reg(MAIN_ADDR, MPU6050_REG_USER_CTRL, USER_CTRL_FIFO_RESET) < 0) return -1;
+    if (i2c1_write_reg(MAIN_ADDR, MPU6050_REG_USER_CTRL, USER_CTRL_FIFO_EN) < 0) return -1;
+    return 0;
+}
+
+int mpu6050_fifo_start(void) {
+    if (i2c1_write_reg(MAIN_ADDR, MPU6050_REG_FIFO_EN, FIFO_EN_TEMP_XYZG_ACC) < 0) return -1;
+    return fifo_reset();
+}
+
+int mpu6050_fifo_stop(void) {
+    if (i2c1_write_reg(MAIN_ADDR, MPU6050_REG_FIFO_EN, 0x00) < 0) return -1;
+    return i2c1_write_reg(MAIN_ADDR, MPU6050_REG_USER_CTRL, 0x00);
+}
+
+int mpu6050_fifo_read(mpu6050_raw_t *out, uint32_t max) {
+    uint8_t st;
+    uint8_t cnt[2];
+    /* INT_STATUS primeiro (ler limpa o OFLOW), depois o contador */
+    const i2c1_sg_t hdr[2] = {
+        { MPU6050_REG_INT_STATUS, &st, 1 },
+        { MPU6050_REG_FIFO_COUNT, cnt, 2 },
+    };
+
+    if (i2c1_dev_read_sg(&mpu6050_main.bus, hdr, 2) < 0) return -1;
+    s_fifo_t = drv_cycles64();
+    uint32_t count = ((uint32_t)cnt[0] << 8) | cnt[1];
+
+    /* Estourou (quadros sobrescritos) ou contador fora de múltiplo de 14:
+       o alinhamento dos quadros se perdeu, zera e recomeça. */
+    if ((st & INT_STATUS_FIFO_OFLOW) || count >= MPU6050_FIFO_SIZE || (count % MPU6050_FIFO_FRAME) != 0u) {
+        if (st & INT_STATUS_FIFO_OFLOW || count >= MPU6050_FIFO_SIZE) fifo_stats.overflows++;
+        fifo_stats.resyncs++;
+        return (fifo_reset() < 0) ? -1 : 0;
+    }
+
+    uint32_t n = count / MPU6050_FIFO_FRAME;
+    s_fifo_frames = n;
+    if (n > max) n = max;
+    if (n == 0) return 0;
+
+    /* Um burst só direto no vetor de saída e decodifica no lugar */
+    uint8_t *raw = (uint8_t *)out;
+    if (i2c1_dev_read(&mpu6050_main.bus, MPU6050_REG_FIFO_RW, raw, (uint16_t)(n * MPU6050_FIFO_FRAME)) < 0) return -1;
+    for (uint32_t i = 0; i < n; i++) mpu6050_decode(raw + i * MPU6050_FIFO_FRAME, &out[i]);
+
+    fifo_stats.samples += n;
+    return (int)n;
+}
+
+uint64_t mpu6050_fifo_sample_time(uint32_t i) {
+    uint64_t period = (uint64_t)SystemCoreClock * s_div / s_gyro_hz;
+    uint32_t back = (i < s_fifo_frames) ? s_fifo_frames - 1u - i : 0u;
+    return s_fifo_t - (uint64_t)back * period;
+}
+
+const mpu6050_fifo_stats_t *mpu6050_fifo_get_stats(void) { return &fifo_stats; }
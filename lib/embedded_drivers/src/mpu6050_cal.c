@@ -0,0 +1,184 @@
+#include <string.h>
+#include "mpu6050_cal.h"
+
+#define TC_MAX_Q16  16384   /* ±0.25 LSB/LSB */
+
+void mpu6050_cal_identity(mpu6050_cal_t *c) {
+    memset(c, 0, sizeof(*c));
+    for (int i = 0; i < 3; i++) c->scale_q14[i] = 16384;
+}
+
+/* Divisão com arredondamento ao mais próximo (somas negativas também) */
+static int16_t avg_round(int32_t sum, uint16_t n) {
+    int32_t h = (int32_t)(n / 2u);
+    return (int16_t)((sum >= 0 ? sum + h : sum - h) / (int32_t)n);
+}
+
+int mpu6050_cal_avg_get(const mpu6050_cal_avg_t *a, mpu6050_raw_t *mean) {
+    if (a->n == 0) return -1;
+    mean->ax = avg_round(a->sum[0], a->n);
+    mean->ay = avg_round(a->sum[1], a->n);
+    mean->az = avg_round(a->sum[2], a->n);
+    mean->gx = avg_round(a->sum[3], a->n);
+    mean->gy = avg_round(a->sum[4], a->n);
+    mean->gz = avg_round(a->sum[5], a->n);
+    mean->temp_raw = avg_round(a->sum[6], a->n);
+    return 0;
+}
+
+void mpu6050_cal_set_still(mpu6050_cal_t *c, const mpu6050_raw_t *mean) {
+    int32_t dt = (int32_t)mean->temp_raw - c->t_ref;
+    for (int i = 0; i < 3; i++)
+        c->off[i] = mpu6050_cal_sat16(c->off[i] + ((c->tc_q16[i] * dt) >> 16));
+    c->off[3] = mean->gx;
+    c->off[4] = mean->gy;
+    c->off[5] = mean->gz;
+    c->t_ref  = mean->temp_raw;
+}
+
+/* ---------------------------- 6 posições ---------------------------- */
+int mpu6050_cal6_add(mpu6050_cal6_t *p, const mpu6050_raw_t *mean) {
+    const int32_t v[3] = { mean->ax, mean->ay, mean->az };
+    const int32_t hi = MPU6050_CAL_ONE_G * 8 / 10, lo = MPU6050_CAL_ONE_G * 3 / 10;
+    int axis = -1;
+
+    for (int i = 0; i < 3; i++) {
+        int32_t m = v[i] < 0 ? -v[i] : v[i];
+        if (m > hi) { if (axis >= 0) return -1; axis = i; }
+        else if (m > lo) return -1;
+    }
+    if (axis < 0) return -1;
+
+    int down = v[axis] < 0;
+    if (down) p->down[axis] = (int16_t)v[axis];
+    else      p->up[axis]   = (int16_t)v[axis];
+    int face = axis * 2 + down;
+    p->temp[face] = mean->temp_raw;
+    p->have |= (uint8_t)(1u << face);
+    return face;
+}
+
+int mpu6050_cal6_solve(const mpu6050_cal6_t *p, mpu6050_cal_t *c) {
+    if (!mpu6050_cal6_done(p)) return -1;
+
+    int16_t off[3], scale[3];
+    for (int i = 0; i < 3; i++) {
+        int32_t span = (int32_t)p->up[i] - p->down[i];            /* 2 g medidos */
+        int32_t q14 = (2 * MPU6050_CAL_ONE_G * 16384 + span / 2) / span;
+        if (q14 < 8192 || q14 > 24576) return -1;
+        off[i]   = (int16_t)(((int32_t)p->up[i] + p->down[i]) / 2);
+        scale[i] = (int16_t)q14;
+    }
+
+    /* As 6 medidas saem em temperaturas um pouco diferentes: leva o offset
+       ao t_ref atual com o tc que já existir. */
+    for (int i = 0; i < 3; i++) {
+        int32_t tm = ((int32_t)p->temp[2 * i] + p->temp[2 * i + 1]) / 2;
+        int32_t dt = (int32_t)c->t_ref - tm;
+        c->off[i] = mpu6050_cal_sat16(off[i] + ((c->tc_q16[i] * dt) >> 16));
+        c->scale_q14[i] = scale[i];
+    }
+    return 0;
+}
+
+/* ---------------------- Coeficiente de temperatura ------------------- */
+void mpu6050_cal_tc_add(mpu6050_cal_tc_t *a, const mpu6050_raw_t *s) {
+    if (a->n == 0) a->t0 = s->temp_raw;
+    const int32_t x[6] = { s->ax, s->ay, s->az, s->gx, s->gy, s->gz };
+    int64_t t = (int64_t)s->temp_raw - a->t0;
+    a->st  += t;
+    a->stt += t * t;
+    for (int i = 0; i < 6; i++) {
+        a->sx[i]  += x[i];
+        a->stx[i] += t * x[i];
+    }
+    a->n++;
+}
+
+int mpu6050_cal_tc_solve(const mpu6050_cal_tc_t *a, mpu6050_cal_t *c, uint16_t min_span) {
+    if (a->n < 2) return -1;
+    /* n²·var(t) = n·Σt² - (Σt)²; rampa uniforme de largura R: var = R²/12 */
+    double n = (double)a->n;
+    double den = n * (double)a->stt - (double)a->st * (double)a->st;
+    double var = den / (n * n);
+    if (var <= 0.0 || 12.0 * var < (double)min_span * (double)min_span) return -1;
+
+    for (int i = 0; i < 6; i++) {
+        double num = n * (double)a->stx[i] - (double)a->st * (double)a->sx[i];
+        double k = num / den * 65536.0;
+        if (k >  TC_MAX_Q16) k =  TC_MAX_Q16;
+        if (k < -TC_MAX_Q16) k = -TC_MAX_Q16;
+        c->tc_q16[i] = (int32_t)(k < 0 ? k - 0.5 : k + 0.5);
+    }
+    return 0;
+}
+
+/* ---------------------------- Viés online ---------------------------- */
+void mpu6050_bias_init(mpu6050_bias_t *b, const mpu6050_cal_t *c, uint16_t win) {
+    memset(b, 0, sizeof(*b));
+    int32_t mg10 = (MPU6050_CAL_ONE_G / 100) >> mpu6050_scale.afs;     /* 10 mg */
+    b->win         = win ? win : 1u;
+    b->shift       = 3;
+    b->gyro_max    = (int16_t)(262 >> mpu6050_scale.fs);              /* 2 °/s */
+    b->acc_var_max = 3 * mg10 * mg10;
+    b->acc_ref[2]  = (int16_t)(MPU6050_CAL_ONE_G >> mpu6050_scale.afs);
+    b->acc_tol     = (int16_t)(10 * mg10);
+    for (int i = 0; i < 6; i++) b->off_q8[i] = (int32_t)c->off[i] * 256;
+}
+
+int mpu6050_bias_add(mpu6050_bias_t *b, mpu6050_cal_t *c, const mpu6050_raw_t *raw) {
+    const int16_t a[3] = { raw->ax, raw->ay, raw->az };
+    const int16_t g[3] = { raw->gx, raw->gy, raw->gz };
+    int32_t dt = (int32_t)raw->temp_raw - c->t_ref;
+
+    for (int i = 0; i < 3; i++) {
+        b->sum[i] += a[i];
+        b->sq[i]  += (int32_t)a[i] * a[i];
+        b->sum[3 + i] += g[i];
+        int32_t gc = mpu6050_cal_axis(c, 3 + i, g[i], dt);
+        if (gc > b->gyro_max || gc < -b->gyro_max) b->moving = 1;
+    }
+    b->sum[6] += raw->temp_raw;
+    if (++b->n < b->win) return 0;
+
+    /* fim da janela */
+    int64_t n = b->n, var = 0;
+    for (int i = 0; i < 3; i++) var += (n * b->sq[i] - (int64_t)b->sum[i] * b->sum[i]) / (n * n);
+    int still = !b->moving && var <= b->acc_var_max;
+    int32_t tm = avg_round(b->sum[6], b->n) - c->t_ref;
+    int32_t mean[6];
+    for (int i = 0; i < 6; i++) mean[i] = avg_round(b->sum[i], b->n);
+    memset(b->sum, 0, sizeof(b->sum));
+    memset(b->sq, 0, sizeof(b->sq));
+    b->n = 0;
+    b->moving = 0;
+    b->windows++;
+    if (!still) return 0;
+    b->still++;
+
+    /* Alvo = offset que zeraria esta janela, levado a t_ref pelo tc */
+    for (int i = 3; i < 6; i++) {
+        int32_t target = (mean[i] - ((c->tc_q16[i] * tm) >> 16)) * 256;
+        b->off_q8[i] += (target - b->off_q8[i]) / (1 << b->shift);
+        c->off[i] = mpu6050_cal_sat16((b->off_q8[i] + 128) >> 8);
+    }
+    if (b->track_acc) {
+        int ok = 1;
+        for (int i = 0; i < 3; i++) {
+            int32_t ac = mpu6050_cal_axis(c, i, (int16_t)mean[i], tm);
+            int32_t e = ac - b->acc_ref[i];
+            if (e > b->acc_tol || e < -b->acc_tol) ok = 0;
+        }
+        if (ok) {
+            for (int i = 0; i < 3; i++) {
+                /* raw = off(t) + ref / escala */
+                int32_t ref_raw = ((int32_t)b->acc_ref[i] * 16384 + c->scale_q14[i] / 2) / c->scale_q14[i];
+                int32_t target = (mean[i] - ref_raw - ((c->tc_q16[i] * tm) >> 16)) * 256;
+                b->off_q8[i] += (target - b->off_q8[i]) / (1 << b->shift);
+                c->off[i] = mpu6050_cal_sat16((b->off_q8[i] + 128) >> 8);
+            }
+            b->acc_updates++;
+        }
+    }
+    return 1;
+}
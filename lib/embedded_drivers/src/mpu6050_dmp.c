@@ -0,0 +1,177 @@
+#include <math.h>
+#include <string.h>
+#include "mpu6050_dmp.h"
+
+#define BUS (&mpu6050_main.bus)
+
+#define USER_CTRL_DMP_EN      0x80u
+#define USER_CTRL_FIFO_EN     0x40u
+#define USER_CTRL_DMP_RESET   0x08u
+#define USER_CTRL_FIFO_RESET  0x04u
+#define INT_STATUS_FIFO_OFLOW 0x10u
+#define MEM_CHUNK             16u
+
+static uint8_t s_loaded, s_active;
+static uint8_t s_packet_len = MPU6050_DMP_QUAT_RAW;
+static uint8_t s_prev_afs, s_prev_fs;
+static uint16_t s_prev_rate;
+static uint8_t  s_prev_dlpf;
+static mpu6050_dmp_stats_t s_stats;
+
+static int wreg(uint8_t reg, uint8_t v){ return i2c1_write_reg(mpu6050_main.bus.addr7, reg, v); }
+
+/* ========================== Memória do DMP ========================== */
+/* BANK_SEL e MEM_START são vizinhos: um burst de 2 B posiciona, e a porta
+   MEM_R_W avança sozinha dentro do banco. */
+static int mem_seek(uint16_t addr){
+    const uint8_t pos[2] = { (uint8_t)(addr >> 8), (uint8_t)addr };
+    return i2c1_dev_write(BUS, MPU6050_REG_BANK_SEL, pos, 2);
+}
+
+static uint16_t chunk_len(uint16_t addr, uint16_t n){
+    uint16_t room = (uint16_t)(256u - (addr & 0xFFu));
+    uint16_t c = (n < MEM_CHUNK) ? n : MEM_CHUNK;
+    return (c < room) ? c : room;
+}
+
+int mpu6050_dmp_mem_write(uint16_t addr, const uint8_t *d, uint16_t n){
+    while (n){
+        uint16_t c = chunk_len(addr, n);
+        if (mem_seek(addr) < 0) return -1;
+        if (i2c1_dev_write(BUS, MPU6050_REG_MEM_RW, d, c) < 0) return -1;
+        addr = (uint16_t)(addr + c); d += c; n = (uint16_t)(n - c);
+    }
+    return 0;
+}
+
+int mpu6050_dmp_mem_read(uint16_t addr, uint8_t *d, uint16_t n){
+    while (n){
+        uint16_t c = chunk_len(addr, n);
+        if (mem_seek(addr) < 0) return -1;
+        if (i2c1_dev_read(BUS, MPU6050_REG_MEM_RW, d, c) < 0) return -1;
+        addr = (uint16_t)(addr + c); d += c; n = (uint16_t)(n - c);
+    }
+    return 0;
+}
+
+int mpu6050_dmp_load(const mpu6050_dmp_image_t *img){
+    uint8_t chk[MEM_CHUNK];
+    s_loaded = 0;
+    if (img == NULL || img->code == NULL || img->size == 0) return -1;
+    if (img->packet_len != MPU6050_DMP_QUAT && img->packet_len != MPU6050_DMP_QUAT_RAW) return -1;
+    if (s_active && mpu6050_dmp_stop() < 0) return -1;
+
+    if (mpu6050_dmp_mem_write(0, img->code, img->size) < 0) return -1;
+    /* Confere: um byte errado no programa trava o DMP sem aviso. */
+    for (uint16_t a = 0; a < img->size; a = (uint16_t)(a + MEM_CHUNK)){
+        uint16_t c = chunk_len(a, (uint16_t)(img->size - a));
+        if (mpu6050_dmp_mem_read(a, chk, c) < 0) return -1;
+        if (memcmp(chk, img->code + a, c) != 0) return -1;
+    }
+    for (uint8_t i = 0; i < img->n_patch; i++)
+        if (mpu6050_dmp_mem_write(img->patch[i].addr, img->patch[i].data, img->patch[i].len) < 0) return -1;
+
+    const uint8_t start[2] = { (uint8_t)(img->start_addr >> 8), (uint8_t)img->start_addr };
+    if (i2c1_dev_write(BUS, MPU6050_REG_PRGM_START, start, 2) < 0) return -1;
+    s_packet_len = img->packet_len;
+    s_loaded = 1;
+    return 0;
+}
+
+/* ============================== Modos =============================== */
+static int fifo_reset(void){
+    if (wreg(MPU6050_REG_USER_CTRL, 0x00) < 0) return -1;
+    if (wreg(MPU6050_REG_USER_CTRL, USER_CTRL_DMP_RESET | USER_CTRL_FIFO_RESET) < 0) return -1;
+    return wreg(MPU6050_REG_USER_CTRL, USER_CTRL_DMP_EN | USER_CTRL_FIFO_EN);
+}
+
+int mpu6050_dmp_start(void){
+    if (!s_loaded) return -1;
+    if (s_active) return 0;
+    s_prev_afs  = mpu6050_scale.afs;
+    s_prev_fs   = mpu6050_scale.fs;
+    s_prev_rate = mpu6050_get_rate();
+    s_prev_dlpf = mpu6050_get_dlpf();
+
+    /* A imagem assume ±2000 dps / ±2 g e entrega um pacote por amostra */
+    if (mpu6050_set_gyro_range(MPU6050_GYRO_2000DPS) < 0) return -1;
+    if (mpu6050_set_accel_range(MPU6050_ACCEL_2G) < 0) return -1;
+    if (mpu6050_set_rate(MPU6050_DMP_RATE_HZ, 3) < 0) return -1;
+    if (wreg(MPU6050_REG_FIFO_EN, 0x00) < 0) return -1;      /* a FIFO é do DMP */
+    if (fifo_reset() < 0) return -1;
+    s_active = 1;
+    return 0;
+}
+
+int mpu6050_dmp_stop(void){
+    if (!s_active) return 0;
+    s_active = 0;
+    if (wreg(MPU6050_REG_USER_CTRL, 0x00) < 0) return -1;
+    if (wreg(MPU6050_REG_USER_CTRL, USER_CTRL_DMP_RESET | USER_CTRL_FIFO_RESET) < 0) return -1;
+    if (wreg(MPU6050_REG_USER_CTRL, 0x00) < 0) return -1;
+    if (mpu6050_set_gyro_range(s_prev_fs) < 0) return -1;
+    if (mpu6050_set_accel_range(s_prev_afs) < 0) return -1;
+    return mpu6050_set_rate(s_prev_rate, s_prev_dlpf);
+}
+
+int mpu6050_dmp_active(void){ return s_active; }
+
+/* ============================== Pacotes ============================= */
+static int32_t be32(const uint8_t *p){
+    return (int32_t)(((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3]);
+}
+static int16_t be16(const uint8_t *p){ return (int16_t)((p[0] << 8) | p[1]); }
+
+_Static_assert(sizeof(mpu6050_dmp_packet_t) >= MPU6050_DMP_QUAT_RAW, "pacote cabe no lugar");
+
+int mpu6050_dmp_read(mpu6050_dmp_packet_t *out, uint32_t max){
+    uint8_t st, cnt[2];
+    const i2c1_sg_t hdr[2] = {
+        { MPU6050_REG_INT_STATUS, &st, 1 },
+        { MPU6050_REG_FIFO_COUNT, cnt, 2 },
+    };
+    if (!s_active) return -1;
+    if (i2c1_dev_read_sg(BUS, hdr, 2) < 0) return -1;
+    s_stats.bytes += 3u;
+    uint32_t count = ((uint32_t)cnt[0] << 8) | cnt[1];
+
+    if ((st & INT_STATUS_FIFO_OFLOW) || count >= MPU6050_FIFO_SIZE || (count % s_packet_len) != 0u){
+        if ((st & INT_STATUS_FIFO_OFLOW) || count >= MPU6050_FIFO_SIZE) s_stats.overflows++;
+        s_stats.resyncs++;
+        return (fifo_reset() < 0) ? -1 : 0;
+    }
+
+    uint32_t n = count / s_packet_len;
+    if (n > max) n = max;
+    if (n == 0) return 0;
+
+    /* Burst direto em out[] e decodifica de trás para a frente: o pacote i
+       (bytes i*len) nunca fica depois do destino out[i]. */
+    uint8_t *raw = (uint8_t *)out;
+    if (i2c1_dev_read(BUS, MPU6050_REG_FIFO_RW, raw, (uint16_t)(n * s_packet_len)) < 0) return -1;
+    s_stats.bytes += n * s_packet_len;
+    for (uint32_t i = n; i-- > 0;){
+        uint8_t p[MPU6050_DMP_QUAT_RAW];
+        memcpy(p, raw + i * s_packet_len, s_packet_len);
+        mpu6050_dmp_packet_t *o = &out[i];
+        for (int k = 0; k < 4; k++) o->q[k] = be32(p + 4 * k);
+        for (int k = 0; k < 3; k++){
+            o->accel[k] = (s_packet_len == MPU6050_DMP_QUAT_RAW) ? be16(p + 16 + 2 * k) : 0;
+            o->gyro[k]  = (s_packet_len == MPU6050_DMP_QUAT_RAW) ? be16(p + 22 + 2 * k) : 0;
+        }
+    }
+    s_stats.packets += n;
+    return (int)n;
+}
+
+void mpu6050_dmp_to_ahrs(const mpu6050_dmp_packet_t *p, ahrs_t *a){
+    const float k = 1.0f / 1073741824.0f;
+    float q0 = p->q[0] * k, q1 = p->q[1] * k, q2 = p->q[2] * k, q3 = p->q[3] * k;
+    /* Q30 truncado: renormaliza para os helpers de ahrs.h */
+    float n2 = q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3;
+    if (n2 <= 0.0f) return;
+    float r = 1.0f / sqrtf(n2);
+    a->q0 = q0 * r; a->q1 = q1 * r; a->q2 = q2 * r; a->q3 = q3 * r;
+}
+
+const mpu6050_dmp_stats_t *mpu6050_dmp_get_stats(void){ return &s_stats; }
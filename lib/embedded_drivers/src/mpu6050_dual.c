@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include "mpu6050_dual.h"
+#include "drv_time.h"
+#include "log_task.h"
+
+#ifdef DRIVERS_FREERTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+void mpu6050_dual_init(mpu6050_dual_t *d, mpu6050_t *a, mpu6050_t *b) {
+    d->imu[0] = a;
+    d->imu[1] = b;
+    mpu6050_dual_reset_stats(d);
+}
+
+void mpu6050_dual_reset_stats(mpu6050_dual_t *d) {
+    d->stats = (mpu6050_dual_stats_t){ .skew_min_cyc = UINT32_MAX };
+}
+
+/* No ISR: x->t0 (32 bits) é o START; estende para 64 com o agora. */
+static void stamp(i2c1_xfer_t *x, void *arg) {
+    uint64_t now = drv_cycles64();
+    *(uint64_t *)arg = now - (uint32_t)((uint32_t)now - x->t0);
+}
+
+static void *waiter(void) {
+#ifdef DRIVERS_FREERTOS
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) return xTaskGetCurrentTaskHandle();
+#endif
+    return NULL;
+}
+
+int mpu6050_dual_read(mpu6050_dual_t *d, mpu6050_dual_sample_t *out) {
+    uint32_t n = d->imu[1] ? 2u : 1u;
+    out->ok = 0;
+
+    if (!i2c1_async_enabled()) {
+        for (uint32_t i = 0; i < n; i++) {
+            out->t_cyc[i] = drv_cycles64();
+            if (mpu6050_dev_read(d->imu[i], &out->raw[i]) == 0) out->ok |= (uint8_t)(1u << i);
+        }
+    } else {
+        for (uint32_t i = 0; i < n; i++) {
+            d->xfer[i] = (i2c1_xfer_t){
+                .addr7 = d->imu[i]->bus.addr7, .reg = MPU6050_REG_ACCEL, .op = I2C1_OP_READ,
+                .prio = d->imu[i]->bus.prio, .buf = d->buf[i], .len = 14,
+                .done = stamp, .arg = &d->t[i], .notify = (i == n - 1u) ? waiter() : NULL
+            };
+        }
+        /* as duas entram juntas: nada da mesma prioridade fica no meio */
+        uint32_t pm = drv_irq_save();
+        for (uint32_t i = 0; i < n; i++) (void)i2c1_xfer_submit(&d->xfer[i]);
+        drv_irq_restore(pm);
+
+        (void)i2c1_xfer_wait(&d->xfer[n - 1u]);
+        for (uint32_t i = 0; i < n; i++) {
+            if (d->xfer[i].status != I2C1_OK) continue;
+            mpu6050_decode(d->buf[i], &out->raw[i]);
+            out->t_cyc[i] = d->t[i];
+            out->ok |= (uint8_t)(1u << i);
+        }
+    }
+
+    for (uint32_t i = 0; i < n; i++)
+        if (!(out->ok & (1u << i))) d->stats.fail[i]++;
+
+    if (n == 2u && out->ok == 3u) {
+        mpu6050_dual_stats_t *s = &d->stats;
+        uint32_t skew = (uint32_t)(out->t_cyc[1] - out->t_cyc[0]);
+        s->n++;
+        s->skew_last_cyc = skew;
+        s->skew_sum_cyc += skew;
+        if (skew < s->skew_min_cyc) s->skew_min_cyc = skew;
+        if (skew > s->skew_max_cyc) s->skew_max_cyc = skew;
+    }
+    return (out->ok == (uint8_t)((1u << n) - 1u)) ? 0 : -1;
+}
+
+void mpu6050_dual_print(const mpu6050_dual_t *d) {
+    const mpu6050_dual_stats_t *s = &d->stats;
+    if (s->n == 0) {
+        LOG_I("[DUAL] sem pares (falhas %lu/%lu)\n",
+              (unsigned long)s->fail[0], (unsigned long)s->fail[1]);
+        return;
+    }
+    LOG_I("[DUAL] %lu pares, skew us: ultimo %lu min %lu med %lu max %lu, falhas %lu/%lu\n",
+          (unsigned long)s->n,
+          (unsigned long)drv_cyc_to_us(s->skew_last_cyc),
+          (unsigned long)drv_cyc_to_us(s->skew_min_cyc),
+          (unsigned long)drv_cyc_to_us(s->skew_sum_cyc / s->n),
+          (unsigned long)drv_cyc_to_us(s->skew_max_cyc),
+          (unsigned long)s->fail[0], (unsigned long)s->fail[1]);
+}
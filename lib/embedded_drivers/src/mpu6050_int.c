@@ -0,0 +1,195 @@
+#include <stddef.h>
+#include "mpu6050.h"
+#include "drv_time.h"
+
+#ifdef DRIVERS_FREERTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+/* DATA_RDY por EXTI. O ISR é o único que escreve 'edges' e o instante
+   (drv_cycles64());
+   a task é a única que escreve 'seen'. Sem seção crítica: a diferença
+   edges - seen diz quantas amostras chegaram desde a última espera. */
+#define INT_PIN_CFG_PULSE   0x00u   /* ativo alto, push-pull, pulso 50 us */
+#define INT_ENABLE_DATA_RDY 0x01u
+
+static void *volatile s_task;
+static volatile uint64_t s_t_cyc;
+static uint32_t s_seen;
+static mpu6050_drdy_stats_t s_stats;
+
+static void drdy_edge(uint64_t t){
+    s_t_cyc = t;
+    s_stats.edges++;
+#ifdef DRIVERS_FREERTOS
+    if (s_task){
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveIndexedFromISR((TaskHandle_t)s_task, MPU6050_DRDY_NOTIFY_INDEX, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+#endif
+}
+
+#ifndef DRIVERS_NATIVE
+void MPU6050_INT_IRQHandler(void){
+    const uint32_t bit = 1u << MPU6050_INT_PIN;
+    if (EXTI->PR & bit){
+        uint64_t t = drv_cycles64();
+        EXTI->PR = bit;
+        drdy_edge(t);
+    }
+}
+
+static void exti_on(void){
+    const uint32_t bit = 1u << MPU6050_INT_PIN;
+    const uint32_t port = ((uint32_t)MPU6050_INT_PORT - GPIOA_BASE) >> 10;
+    const uint32_t i = MPU6050_INT_PIN >> 2, s = (MPU6050_INT_PIN & 3u) * 4u;
+
+    gpio_clk_enable(MPU6050_INT_PORT);
+    gpio_mode(MPU6050_INT_PORT, MPU6050_INT_PIN, GPIO_MODE_IN);
+    gpio_pull(MPU6050_INT_PORT, MPU6050_INT_PIN, 2u);   /* pull-down: INT solto = 0 */
+
+    RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+    SYSCFG->EXTICR[i] = (SYSCFG->EXTICR[i] & ~(0xFu << s)) | (port << s);
+    EXTI->RTSR |=  bit;
+    EXTI->FTSR &= ~bit;
+    EXTI->PR    =  bit;
+    EXTI->IMR  |=  bit;
+
+    NVIC_SetPriority(MPU6050_INT_IRQn, MPU6050_INT_IRQ_PRIO);
+    NVIC_EnableIRQ(MPU6050_INT_IRQn);
+}
+
+/* Só mascara a linha: o vetor pode ser compartilhado com outros pinos. */
+static void exti_off(void){
+    EXTI->IMR &= ~(1u << MPU6050_INT_PIN);
+    EXTI->PR   =  (1u << MPU6050_INT_PIN);
+}
+#else
+void mpu6050_native_int(void){ drdy_edge(drv_cycles64()); }
+static void exti_on(void){}
+static void exti_off(void){}
+#endif
+
+int mpu6050_drdy_init(void *task){
+    uint8_t st;
+    s_task = task;
+    s_seen = s_stats.edges;
+    if (i2c1_write_reg(mpu6050_main.bus.addr7, MPU6050_REG_INT_PIN_CFG, INT_PIN_CFG_PULSE) < 0) return -1;
+    exti_on();
+    if (i2c1_write_reg(mpu6050_main.bus.addr7, MPU6050_REG_INT_ENABLE, INT_ENABLE_DATA_RDY) < 0) return -1;
+    /* descarta um status que tenha ficado pendurado */
+    return i2c1_read_reg(mpu6050_main.bus.addr7, MPU6050_REG_INT_STATUS, &st);
+}
+
+int mpu6050_drdy_stop(void){
+    exti_off();
+    s_task = NULL;
+    return i2c1_write_reg(mpu6050_main.bus.addr7, MPU6050_REG_INT_ENABLE, 0x00);
+}
+
+/* Dorme até edges != seen (ou timeout). 1 = houve borda, 0 = timeout. */
+static int edge_wait(uint32_t timeout_ms){
+#ifdef DRIVERS_FREERTOS
+    /* A notificação pode ter sobrado de uma amostra já consumida: o critério
+       é sempre o contador, a notificação só serve para dormir. */
+    if (s_task && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING && s_task == xTaskGetCurrentTaskHandle()){
+        TickType_t t0 = xTaskGetTickCount(), tmo = pdMS_TO_TICKS(timeout_ms);
+        while (s_stats.edges == s_seen){
+            TickType_t el = xTaskGetTickCount() - t0;
+            if (el >= tmo) return 0;
+            ulTaskNotifyTakeIndexed(MPU6050_DRDY_NOTIFY_INDEX, pdTRUE, tmo - el);
+        }
+    } else
+#endif
+    {
+        uint64_t t0 = drv_cycles64(), tmo = drv_us_to_cycles64((uint64_t)timeout_ms * 1000u);
+        while (s_stats.edges == s_seen){
+            if ((drv_cycles64() - t0) >= tmo) return 0;
+        }
+    }
+    return 1;
+}
+
+int mpu6050_drdy_wait(uint32_t timeout_ms, uint64_t *t_cyc){
+    if (!edge_wait(timeout_ms)) return 0;
+
+    /* par (contador, instante) consistente mesmo com uma borda no meio */
+    uint32_t n;
+    uint64_t t;
+    do { n = s_stats.edges; t = s_t_cyc; } while (n != s_stats.edges);
+
+    s_stats.missed += n - s_seen - 1u;
+    s_seen = n;
+    if (t_cyc) *t_cyc = t;
+    return 1;
+}
+
+const mpu6050_drdy_stats_t *mpu6050_drdy_get_stats(void){ return &s_stats; }
+
+/* ========================== Wake-on-motion ========================== */
+#define ACCEL_HPF_HOLD   0x07u   /* ACCEL_CONFIG: HPF congelado na amostra atual */
+#define ACCEL_FS         ((uint8_t)(mpu6050_scale.afs << 3))   /* mantém a escala */
+#define INT_ENABLE_MOT   0x40u
+#define PWR1_CYCLE       0x20u
+#define PWR1_TEMP_DIS    0x08u
+#define PWR2_STBY_GYRO   0x07u
+
+static int wreg(uint8_t reg, uint8_t v){ return i2c1_write_reg(mpu6050_main.bus.addr7, reg, v); }
+
+/* Espera sem segurar a CPU com o escalonador rodando (+1 tick: pelo menos
+   'ms' inteiros); antes dele ou sem FreeRTOS, gira no CYCCNT. */
+static void settle_ms(uint32_t ms){
+#ifdef DRIVERS_FREERTOS
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING){
+        vTaskDelay(pdMS_TO_TICKS(ms) + 1u);
+        return;
+    }
+#endif
+    uint32_t t0 = drv_cycles();
+    while ((drv_cycles() - t0) < drv_us_to_cycles(ms * 1000u)) {}
+}
+
+int mpu6050_wom_enter(void *task, uint16_t thr_mg, uint8_t dur_ms, uint8_t lp_wake){
+    uint8_t st;
+    uint32_t thr = thr_mg / 2u;                     /* 2 mg/LSB */
+    if (thr < 1u) thr = 1u;
+    if (thr > 255u) thr = 255u;
+
+    s_task = task;
+    s_seen = s_stats.edges;
+
+    /* Roteiro da nota de aplicação: HPF em reset, limiar e duração, espera
+       o HPF assentar e congela (a referência vira a atitude parada); só
+       então giros em standby e accel em modo ciclo. */
+    if (wreg(MPU6050_REG_ACCELCFG, ACCEL_FS) < 0) return -1;
+    if (wreg(MPU6050_REG_INT_PIN_CFG, INT_PIN_CFG_PULSE) < 0) return -1;
+    if (wreg(MPU6050_REG_MOT_THR, (uint8_t)thr) < 0) return -1;
+    if (wreg(MPU6050_REG_MOT_DUR, dur_ms ? dur_ms : 1u) < 0) return -1;
+    if (wreg(MPU6050_REG_INT_ENABLE, INT_ENABLE_MOT) < 0) return -1;
+    settle_ms(5u);
+    if (wreg(MPU6050_REG_ACCELCFG, ACCEL_FS | ACCEL_HPF_HOLD) < 0) return -1;
+    if (wreg(MPU6050_REG_PWR2, (uint8_t)(((lp_wake & 3u) << 6) | PWR2_STBY_GYRO)) < 0) return -1;
+    if (wreg(MPU6050_REG_PWR1, PWR1_CYCLE | PWR1_TEMP_DIS) < 0) return -1;
+
+    exti_on();
+    return i2c1_read_reg(mpu6050_main.bus.addr7, MPU6050_REG_INT_STATUS, &st);
+}
+
+int mpu6050_wom_wait(uint32_t timeout_ms){
+    if (!edge_wait(timeout_ms)) return 0;
+    s_seen = s_stats.edges;                         /* várias bordas = 1 despertar */
+    return 1;
+}
+
+int mpu6050_wom_exit(void){
+    uint8_t st;
+    exti_off();
+    s_task = NULL;
+    if (wreg(MPU6050_REG_PWR1, 0x00) < 0) return -1;
+    if (wreg(MPU6050_REG_PWR2, 0x00) < 0) return -1;
+    if (wreg(MPU6050_REG_ACCELCFG, ACCEL_FS) < 0) return -1;
+    if (wreg(MPU6050_REG_INT_ENABLE, 0x00) < 0) return -1;
+    return i2c1_read_reg(mpu6050_main.bus.addr7, MPU6050_REG_INT_STATUS, &st);
+}
@@ -0,0 +1,85 @@
+#ifdef DRIVERS_NATIVE
+#include <stddef.h>
+#include "i2c1.h"
+#include "drv_hal.h"
+
+/* Barramento emulado: cada transação vai direto ao dispositivo registrado
+   no endereço; endereço vazio = NACK (-1), como no alvo. */
+static const i2c_native_dev_t *devs[128];
+
+void i2c_native_attach(uint8_t addr7, const i2c_native_dev_t *dev){
+    devs[addr7 & 0x7Fu] = dev;
+}
+
+static i2c1_stats_t stats;
+
+const i2c1_stats_t *i2c1_get_stats(void){ return &stats; }
+void i2c1_reset_stats(void){ stats = (i2c1_stats_t){0}; }
+
+static uint32_t s_bus_hz = 100000u;
+
+void i2c1_init(uint32_t apb1_hz, uint32_t bus_hz){ (void)apb1_hz; s_bus_hz = bus_hz ? bus_hz : 100000u; }
+void i2c1_init_100k(uint32_t apb1_hz){ i2c1_init(apb1_hz, 100000u); }
+uint32_t i2c1_get_bus_hz(void){ return (s_bus_hz > 400000u) ? 400000u : s_bus_hz; }
+int  i2c1_bus_recover(void){ stats.recover++; return 0; }
+
+int i2c1_write_reg(uint8_t addr7, uint8_t reg, uint8_t data){
+    const i2c_native_dev_t *d = devs[addr7 & 0x7Fu];
+    if (d == NULL || d->write == NULL || d->write(d->ctx, reg, &data, 1) < 0){ stats.nack++; return -1; }
+    return 0;
+}
+
+int i2c1_write_multi(uint8_t addr7, uint8_t reg, const uint8_t *buf, uint32_t len){
+    if (len == 0) return 0;
+    const i2c_native_dev_t *d = devs[addr7 & 0x7Fu];
+    if (d == NULL || d->write == NULL || d->write(d->ctx, reg, buf, len) < 0){ stats.nack++; return -1; }
+    return 0;
+}
+
+int i2c1_read_reg(uint8_t addr7, uint8_t reg, uint8_t *data){
+    return i2c1_read_multi(addr7, reg, data, 1);
+}
+
+int i2c1_read_multi(uint8_t addr7, uint8_t reg, uint8_t *buf, uint32_t len){
+    if (len == 0) return 0;
+    const i2c_native_dev_t *d = devs[addr7 & 0x7Fu];
+    if (d == NULL || d->read == NULL || d->read(d->ctx, reg, buf, len) < 0){ stats.nack++; return -1; }
+    return 0;
+}
+
+/* Fila "por interrupção" no host: a transação roda inteira dentro do
+   submit e o callback é chamado na hora. O timeout vale como no alvo:
+   se o tempo no fio passa do timeout_us, termina em I2C1_ERR_TIMEOUT sem
+   chegar ao dispositivo. */
+static uint8_t async_on;
+
+void i2c1_async_init(void){ async_on = 1; }
+int  i2c1_async_enabled(void){ return async_on; }
+void i2c1_async_poll(void){}
+
+int i2c1_xfer_submit(i2c1_xfer_t *x){
+    if (x == NULL || x->op > I2C1_OP_READ) return -1;
+    if (x->op == I2C1_OP_READ && (x->len == 0 || x->buf == NULL)) return -1;
+    if (x->len && x->buf == NULL) return -1;
+
+    x->t0 = drv_cycles();
+    if (i2c1_read_us(x->len) > i2c1_xfer_timeout_us(x)){
+        stats.timeout++;
+        x->status = I2C1_ERR_TIMEOUT;
+        if (x->done) x->done(x, x->arg);
+        return 0;
+    }
+    const i2c_native_dev_t *d = devs[x->addr7 & 0x7Fu];
+    int r;
+    if (d == NULL)                r = -1;
+    else if (x->op == I2C1_OP_READ) r = d->read  ? d->read(d->ctx, x->reg, x->buf, x->len) : -1;
+    else                            r = d->write ? d->write(d->ctx, x->reg, x->buf, x->len) : -1;
+    if (r < 0) stats.nack++;
+    x->status = (r < 0) ? I2C1_ERR_NACK : I2C1_OK;
+    if (x->done) x->done(x, x->arg);
+    return 0;
+}
+
+int i2c1_xfer_wait(i2c1_xfer_t *x){ return x->status; }
+int i2c1_xfer_run(i2c1_xfer_t *x){ return (i2c1_xfer_submit(x) < 0) ? I2C1_ERR_BUS : x->status; }
+#endif /* DRIVERS_NATIVE */
@@ -0,0 +1,339 @@
+#ifdef DRIVERS_NATIVE
+#include <math.h>
+#include <string.h>
+#include "drivers_native.h"
+
+/* Modelo comportamental do banco de registros do MPU6050 (ver
+   drivers_native.h). Tudo em tempo virtual: só mpu6050_sim_run_ms() e
+   mpu6050_sim_advance() geram amostras, então o mesmo roteiro dá sempre o
+   mesmo resultado. */
+
+#define R_WHOAMI      0x75u
+#define R_PWR1        0x6Bu
+#define R_PWR2        0x6Cu
+#define R_SMPLRT      0x19u
+#define R_CONFIG      0x1Au
+#define R_GYROCFG     0x1Bu
+#define R_ACCELCFG    0x1Cu
+#define R_MOT_THR     0x1Fu
+#define R_MOT_DUR     0x20u
+#define R_FIFO_EN     0x23u
+#define R_INT_ENABLE  0x38u
+#define R_INT_STATUS  0x3Au
+#define R_DATA        0x3Bu      /* 0x3B..0x48: AX AY AZ T GX GY GZ */
+#define R_USER_CTRL   0x6Au
+#define R_BANK_SEL    0x6Du
+#define R_MEM_START   0x6Eu
+#define R_MEM_RW      0x6Fu
+#define R_PRGM_H      0x70u
+#define R_PRGM_L      0x71u
+#define R_FIFO_CNT_H  0x72u
+#define R_FIFO_CNT_L  0x73u
+#define R_FIFO_RW     0x74u
+
+#define PWR1_RESET    0x80u
+#define PWR1_SLEEP    0x40u
+#define PWR1_CYCLE    0x20u
+#define PWR1_TEMP_DIS 0x08u
+#define UC_DMP_EN     0x80u
+#define UC_FIFO_EN    0x40u
+#define UC_DMP_RESET  0x08u
+#define UC_FIFO_RESET 0x04u
+#define INT_DATA_RDY  0x01u
+#define INT_DMP       0x02u
+#define INT_OFLOW     0x10u
+#define INT_MOT       0x40u
+
+static void sim_reset(mpu6050_sim_t *s) {
+    memset(s->regs, 0, sizeof(s->regs));
+    s->regs[R_WHOAMI] = 0x68u;
+    s->regs[R_PWR1]   = PWR1_SLEEP;
+    s->fifo_head = 0;
+    s->fifo_count = 0;
+    s->mot_count = 0;
+}
+
+/* ------------------------------ FIFO -------------------------------- */
+/* Cheia: o mais antigo é sobrescrito e OFLOW sobe, como no chip. */
+static void fifo_push(mpu6050_sim_t *s, const uint8_t *b, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        if (s->fifo_count == sizeof(s->fifo)) {
+            s->fifo_head = (uint16_t)((s->fifo_head + 1u) % sizeof(s->fifo));
+            s->fifo_count--;
+            s->regs[R_INT_STATUS] |= INT_OFLOW;
+            s->stats.fifo_overflows++;
+        }
+        s->fifo[(s->fifo_head + s->fifo_count) % sizeof(s->fifo)] = b[i];
+        s->fifo_count++;
+    }
+}
+
+static uint8_t fifo_pop(mpu6050_sim_t *s) {
+    if (s->fifo_count == 0) return 0;
+    uint8_t v = s->fifo[s->fifo_head];
+    s->fifo_head = (uint16_t)((s->fifo_head + 1u) % sizeof(s->fifo));
+    s->fifo_count--;
+    return v;
+}
+
+/* --------------------------- registradores -------------------------- */
+/* Porta da memória do DMP: avança dentro do banco, como no chip. */
+static uint8_t *dmp_cell(mpu6050_sim_t *s) {
+    uint32_t a = ((uint32_t)(s->regs[R_BANK_SEL] & 0x1Fu) << 8) | s->regs[R_MEM_START];
+    s->regs[R_MEM_START]++;
+    return &s->dmp_mem[a % sizeof(s->dmp_mem)];
+}
+
+static int sim_write(void *ctx, uint8_t reg, const uint8_t *d, uint32_t n) {
+    mpu6050_sim_t *s = (mpu6050_sim_t *)ctx;
+    for (uint32_t i = 0; i < n; i++) {
+        uint8_t v = d[i];
+        reg &= 0x7Fu;
+        switch (reg) {
+        case R_PWR1:
+            if (v & PWR1_RESET) { sim_reset(s); reg++; continue; }
+            break;
+        case R_USER_CTRL:
+            if (v & UC_FIFO_RESET) { s->fifo_head = 0; s->fifo_count = 0; }
+            v &= (uint8_t)~(UC_FIFO_RESET | UC_DMP_RESET);   /* auto-limpam */
+            break;
+        case R_ACCELCFG:
+            /* HPF indo para "hold": a amostra atual vira a referência do WOM */
+            if ((v & 7u) == 7u && (s->regs[R_ACCELCFG] & 7u) != 7u) {
+                for (int k = 0; k < 3; k++)
+                    s->hpf_ref[k] = (int16_t)((s->regs[R_DATA + 2 * k] << 8) | s->regs[R_DATA + 2 * k + 1]);
+                s->mot_count = 0;
+            }
+            break;
+        case R_SMPLRT:
+        case R_CONFIG:
+            s->regs[reg++] = v;                           /* taxa nova vale já */
+            s->next_s = s->t_s + 1.0 / mpu6050_sim_rate_hz(s);
+            continue;
+        case R_MEM_RW:
+            *dmp_cell(s) = v;                             /* porta: reg fica */
+            continue;
+        case R_FIFO_RW:
+            continue;
+        case R_WHOAMI:
+        case R_INT_STATUS:
+        case R_FIFO_CNT_H:
+        case R_FIFO_CNT_L:
+            reg++;
+            continue;                                     /* só leitura */
+        default:
+            if (reg >= R_DATA && reg < R_DATA + 14u) { reg++; continue; }
+            break;
+        }
+        s->regs[reg++] = v;
+    }
+    s->stats.writes++;
+    return 0;
+}
+
+static int sim_read(void *ctx, uint8_t reg, uint8_t *d, uint32_t n) {
+    mpu6050_sim_t *s = (mpu6050_sim_t *)ctx;
+    int clear_status = 0;
+    uint16_t cnt = s->fifo_count;              /* contador congela no burst */
+    for (uint32_t i = 0; i < n; i++) {
+        reg &= 0x7Fu;
+        if (reg == R_FIFO_RW) { d[i] = fifo_pop(s); continue; }   /* sem incremento */
+        if (reg == R_MEM_RW)  { d[i] = *dmp_cell(s); continue; }
+        if (reg == R_FIFO_CNT_H)      d[i] = (uint8_t)(cnt >> 8);
+        else if (reg == R_FIFO_CNT_L) d[i] = (uint8_t)cnt;
+        else                          d[i] = s->regs[reg];
+        if (reg == R_INT_STATUS) clear_status = 1;
+        reg++;
+    }
+    if (clear_status) s->regs[R_INT_STATUS] = 0;   /* limpa na leitura */
+    s->stats.reads++;
+    s->stats.bytes_read += n;
+    return 0;
+}
+
+/* ------------------------------ amostras ---------------------------- */
+static const float lp_wake_hz[4] = { 1.25f, 5.0f, 20.0f, 40.0f };
+
+float mpu6050_sim_rate_hz(const mpu6050_sim_t *s) {
+    if (s->regs[R_PWR1] & PWR1_CYCLE) return lp_wake_hz[s->regs[R_PWR2] >> 6];
+    uint8_t dlpf = s->regs[R_CONFIG] & 7u;
+    float gyro_hz = (dlpf == 0u || dlpf == 7u) ? 8000.0f : 1000.0f;
+    return gyro_hz / (1.0f + s->regs[R_SMPLRT]);
+}
+
+static uint32_t rng_next(mpu6050_sim_t *s) {
+    uint32_t x = s->rng;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return s->rng = x;
+}
+
+static int16_t to_lsb(mpu6050_sim_t *s, float v, float lsb_per_unit, uint8_t fs_sel) {
+    float f = v * lsb_per_unit / (float)(1u << fs_sel);
+    if (s->noise_lsb) f += (float)((int32_t)(rng_next(s) % (2u * s->noise_lsb + 1u)) - (int32_t)s->noise_lsb);
+    if (f >  32767.0f) return 32767;
+    if (f < -32768.0f) return -32768;
+    return (int16_t)(f < 0 ? f - 0.5f : f + 0.5f);
+}
+
+/* Estado físico no instante t: função, trilha gravada ou valor fixo. */
+static void physics(mpu6050_sim_t *s, double t, float acc[3], float gyr[3], float *temp) {
+    memcpy(acc, s->acc_g, sizeof(s->acc_g));
+    memcpy(gyr, s->gyr_dps, sizeof(s->gyr_dps));
+    *temp = s->temp_c;
+    if (s->motion) {
+        s->motion(s->motion_ctx, t, acc, gyr, temp);
+    } else if (s->track && s->track_len) {
+        const int32_t *row = s->track[(uint64_t)(t * s->track_hz) % s->track_len];
+        for (int k = 0; k < 3; k++) {
+            acc[k] = (float)row[k] / 16384.0f;
+            gyr[k] = (float)row[3 + k] / 131.0f;
+        }
+    }
+}
+
+static void put16(uint8_t *p, int16_t v) { p[0] = (uint8_t)((uint16_t)v >> 8); p[1] = (uint8_t)v; }
+
+/* Quatérnio Q30 da atitude que a gravidade dá (mesma convenção de
+   ahrs_reset_to_accel), sem ruído: é o que o DMP entrega parado. */
+static void dmp_packet(const float acc[3], uint8_t *p) {
+    double roll  = atan2(acc[1], acc[2]);
+    double pitch = atan2(-acc[0], sqrt((double)acc[1] * acc[1] + (double)acc[2] * acc[2]));
+    double cr = cos(roll * 0.5), sr = sin(roll * 0.5), cp = cos(pitch * 0.5), sp = sin(pitch * 0.5);
+    double q[4] = { cr * cp, sr * cp, cr * sp, -sr * sp };
+    for (int k = 0; k < 4; k++) {
+        uint32_t v = (uint32_t)(int32_t)lrint(q[k] * 1073741823.0);
+        p[4 * k] = (uint8_t)(v >> 24); p[4 * k + 1] = (uint8_t)(v >> 16);
+        p[4 * k + 2] = (uint8_t)(v >> 8); p[4 * k + 3] = (uint8_t)v;
+    }
+}
+
+static void sample(mpu6050_sim_t *s, double t) {
+    float acc[3], gyr[3], temp;
+    uint8_t pwr1 = s->regs[R_PWR1], pwr2 = s->regs[R_PWR2];
+    uint8_t afs = (s->regs[R_ACCELCFG] >> 3) & 3u, fs = (s->regs[R_GYROCFG] >> 3) & 3u;
+    int16_t a[3], g[3], tr;
+    uint8_t ev = INT_DATA_RDY;
+    uint8_t before = s->regs[R_INT_STATUS];
+
+    physics(s, t, acc, gyr, &temp);
+    for (int k = 0; k < 3; k++) {
+        a[k] = (pwr2 & (0x20u >> k)) ? 0 : to_lsb(s, acc[k], 16384.0f, afs);
+        g[k] = (pwr2 & (0x04u >> k)) ? 0 : to_lsb(s, gyr[k], 131.0f, fs);
+    }
+    tr = (pwr1 & PWR1_TEMP_DIS) ? 0 : (int16_t)((temp - 36.53f) * 340.0f);
+
+    uint8_t *d = &s->regs[R_DATA];
+    put16(d + 0, a[0]); put16(d + 2, a[1]); put16(d + 4, a[2]);
+    put16(d + 6, tr);
+    put16(d + 8, g[0]); put16(d + 10, g[1]); put16(d + 12, g[2]);
+    s->stats.samples++;
+
+    /* DMP ligado: a FIFO recebe o pacote dele; senão os grupos de FIFO_EN
+       na ordem do burst */
+    if ((s->regs[R_USER_CTRL] & UC_DMP_EN) && (s->regs[R_PRGM_H] | s->regs[R_PRGM_L])) {
+        if (s->regs[R_USER_CTRL] & UC_FIFO_EN) {
+            uint8_t pkt[28];
+            dmp_packet(acc, pkt);
+            memcpy(pkt + 16, d, 6);                       /* accel */
+            memcpy(pkt + 22, d + 8, 6);                   /* giro  */
+            fifo_push(s, pkt, s->dmp_packet_len);
+            s->stats.dmp_packets++;
+            ev |= INT_DMP;
+        }
+    } else if (s->regs[R_USER_CTRL] & UC_FIFO_EN) {
+        uint8_t en = s->regs[R_FIFO_EN];
+        if (en & 0x08u) fifo_push(s, d, 6);
+        if (en & 0x80u) fifo_push(s, d + 6, 2);
+        if (en & 0x40u) fifo_push(s, d + 8, 2);
+        if (en & 0x20u) fifo_push(s, d + 10, 2);
+        if (en & 0x10u) fifo_push(s, d + 12, 2);
+    }
+
+    /* Movimento: |a - ref| acima de MOT_THR (2 mg/LSB) em algum eixo por
+       MOT_DUR amostras (1 no modo ciclo), com o HPF em "hold". */
+    if ((s->regs[R_ACCELCFG] & 7u) == 7u) {
+        int32_t thr = (int32_t)s->regs[R_MOT_THR] * 2 * 16384 / 1000 / (1 << afs);
+        int over = 0;
+        for (int k = 0; k < 3; k++) {
+            int32_t dlt = (int32_t)a[k] - s->hpf_ref[k];
+            if (dlt > thr || -dlt > thr) over = 1;
+        }
+        uint32_t need = (pwr1 & PWR1_CYCLE) ? 1u : (s->regs[R_MOT_DUR] ? s->regs[R_MOT_DUR] : 1u);
+        s->mot_count = over ? s->mot_count + 1u : 0u;
+        if (s->mot_count >= need) { ev |= INT_MOT; s->mot_count = 0; }
+    }
+
+    s->regs[R_INT_STATUS] |= ev;
+    /* borda no INT se algum evento habilitado subiu (OFLOW vem do push) */
+    uint8_t risen = (uint8_t)(s->regs[R_INT_STATUS] & (uint8_t)~before) | ev;
+    if ((risen & s->regs[R_INT_ENABLE]) && s->int_pin) {
+        s->stats.int_edges++;
+        mpu6050_native_int();
+    }
+}
+
+uint32_t mpu6050_sim_run_ms(mpu6050_sim_t *s, uint32_t ms) {
+    double end = s->t_s + ms / 1000.0;
+    uint32_t n = 0;
+    if (s->regs[R_PWR1] & PWR1_SLEEP) {      /* dormindo: o tempo passa, nada amostra */
+        s->t_s = s->next_s = end;
+        return 0;
+    }
+    while (s->next_s <= end + 1e-9) {       /* folga para o erro da soma dos períodos */
+        sample(s, s->next_s);
+        s->next_s += 1.0 / mpu6050_sim_rate_hz(s);
+        n++;
+    }
+    s->t_s = end;
+    return n;
+}
+
+uint32_t mpu6050_sim_advance(mpu6050_sim_t *s, uint32_t n) {
+    if (s->regs[R_PWR1] & PWR1_SLEEP) return 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (s->next_s < s->t_s) s->next_s = s->t_s;
+        sample(s, s->next_s);
+        s->t_s = s->next_s;
+        s->next_s += 1.0 / mpu6050_sim_rate_hz(s);
+    }
+    return n;
+}
+
+/* ------------------------------ fontes ------------------------------ */
+void mpu6050_sim_set_static(mpu6050_sim_t *s, float ax, float ay, float az,
+                            float gx, float gy, float gz) {
+    s->acc_g[0] = ax;  s->acc_g[1] = ay;  s->acc_g[2] = az;
+    s->gyr_dps[0] = gx; s->gyr_dps[1] = gy; s->gyr_dps[2] = gz;
+    s->motion = NULL;
+    s->track = NULL;
+}
+
+void mpu6050_sim_set_motion(mpu6050_sim_t *s, mpu6050_sim_motion_fn fn, void *ctx) {
+    s->motion = fn;
+    s->motion_ctx = ctx;
+}
+
+void mpu6050_sim_play(mpu6050_sim_t *s, const int32_t (*rows)[6], uint32_t n, uint16_t rate_hz) {
+    s->track = rows;
+    s->track_len = n;
+    s->track_hz = rate_hz ? rate_hz : 1u;
+    s->motion = NULL;
+}
+
+void mpu6050_sim_set_noise(mpu6050_sim_t *s, uint16_t lsb, uint32_t seed) {
+    s->noise_lsb = lsb;
+    s->rng = seed ? seed : 0x2545F491u;
+}
+
+void mpu6050_sim_init(mpu6050_sim_t *s, uint8_t addr7) {
+    memset(s, 0, sizeof(*s));
+    sim_reset(s);
+    s->acc_g[2] = 1.0f;                       /* parado, face para cima */
+    s->temp_c = 25.0f;
+    s->rng = 0x2545F491u;
+    s->int_pin = 1;
+    s->dmp_packet_len = 28;
+    s->dev = (i2c_native_dev_t){ s, sim_write, sim_read };
+    i2c_native_attach(addr7, &s->dev);
+}
+#endif /* DRIVERS_NATIVE */
@@ -0,0 +1,18 @@
+#ifdef DRIVERS_NATIVE
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#include "drv_hal.h"
+
+uint32_t SystemCoreClock = 100000000u;   /* nominal do F411 */
+
+uint32_t native_cycles(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+    return (uint32_t)(ns * (SystemCoreClock / 1000000u) / 1000u);
+}
+
+/* Atrasos do projeto não existem no host: viram no-op (podem ser sobrescritos). */
+__attribute__((weak)) void delay_ms(uint32_t ms){ (void)ms; }
+__attribute__((weak)) void delay_us(uint32_t us){ (void)us; }
+#endif /* DRIVERS_NATIVE */
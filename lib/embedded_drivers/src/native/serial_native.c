@@ -0,0 +1,33 @@
+#ifdef DRIVERS_NATIVE
+#include <stdio.h>
+#include "serial_stdio.h"
+
+/* USART de stdio no host: stdout/stdin. */
+void serial_init(uint32_t baud){ (void)baud; }
+void serial_stdio_init(uint32_t baud){ (void)baud; setvbuf(stdout, NULL, _IONBF, 0); }
+void serial_write(const char *s){ fputs(s, stdout); }
+void serial_putc(uint8_t c){ putchar(c); }
+int  serial_tx_done(void){ return 1; }
+int  serial_readable(void){ return 0; }
+int  serial_getc_blocking(void){ int c = getchar(); return (c == EOF) ? 0 : c; }
+
+/* Sem DMA no host: o stdout já não bloqueia o chamador. */
+static serial_tx_stats_t tx_stats;
+void serial_tx_async_init(uint8_t policy){ (void)policy; }
+void serial_tx_set_policy(uint8_t policy){ (void)policy; }
+int  serial_tx_async_enabled(void){ return 0; }
+void serial_flush(void){ fflush(stdout); }
+int  serial_write_raw(const void *buf, size_t n){ return (int)fwrite(buf, 1, n, stdout); }
+const serial_tx_stats_t *serial_tx_get_stats(void){ return &tx_stats; }
+
+/* RX: stdin do host não é um fluxo de quadros; leituras não bloqueantes
+   voltam vazias. */
+static serial_rx_stats_t rx_stats;
+void serial_rx_async_init(void){}
+int  serial_rx_async_enabled(void){ return 0; }
+int  serial_available(void){ return 0; }
+int  serial_read(void *buf, size_t max){ (void)buf; (void)max; return 0; }
+int  serial_read_frame(void *buf, size_t max){ (void)buf; (void)max; return 0; }
+int  serial_read_line(char *buf, size_t max){ (void)buf; (void)max; return 0; }
+const serial_rx_stats_t *serial_rx_get_stats(void){ return &rx_stats; }
+#endif /* DRIVERS_NATIVE */
@@ -0,0 +1,94 @@
+#ifdef DRIVERS_NATIVE
+#include <stdio.h>
+#include "../st7789_port.h"
+
+/* Controlador ST7789 emulado: só o suficiente para o driver (CASET, RASET,
+   RAMWR); o resto dos comandos é aceito e ignorado. */
+static uint16_t fb[LCD_W * LCD_H];
+
+static struct {
+    int      dc;              /* 0 = comando, 1 = dado */
+    uint8_t  cmd;
+    uint32_t nparam;
+    uint8_t  param[4];
+    uint16_t xs, xe, ys, ye;
+    uint16_t x, y;
+    uint8_t  hi;              /* 1º byte do pixel em RAMWR */
+    int      have_hi;
+} lcd;
+
+static void ram_put(uint16_t px){
+    if (lcd.x < LCD_W && lcd.y < LCD_H) fb[lcd.y * LCD_W + lcd.x] = px;
+    if (++lcd.x > lcd.xe){
+        lcd.x = lcd.xs;
+        if (++lcd.y > lcd.ye) lcd.y = lcd.ys;
+    }
+}
+
+static void feed(uint8_t b){
+    if (!lcd.dc){
+        lcd.cmd = b;
+        lcd.nparam = 0;
+        lcd.have_hi = 0;
+        if (b == 0x2C){ lcd.x = lcd.xs; lcd.y = lcd.ys; }
+        return;
+    }
+    switch (lcd.cmd){
+        case 0x2A:
+        case 0x2B:
+            if (lcd.nparam < 4) lcd.param[lcd.nparam++] = b;
+            if (lcd.nparam == 4){
+                uint16_t s = (uint16_t)((lcd.param[0] << 8) | lcd.param[1]);
+                uint16_t e = (uint16_t)((lcd.param[2] << 8) | lcd.param[3]);
+                if (lcd.cmd == 0x2A){ lcd.xs = s; lcd.xe = e; }
+                else                { lcd.ys = s; lcd.ye = e; }
+            }
+            break;
+        case 0x2C:
+            if (!lcd.have_hi){ lcd.hi = b; lcd.have_hi = 1; }
+            else { ram_put((uint16_t)((lcd.hi << 8) | b)); lcd.have_hi = 0; }
+            break;
+        default:
+            break;
+    }
+}
+
+void lcd_dc_cmd(void)   { lcd.dc = 0; }
+void lcd_dc_data(void)  { lcd.dc = 1; }
+void lcd_rst_high(void) {}
+void lcd_rst_low(void)  {}
+void lcd_blk_on(void)   {}
+void lcd_blk_off(void)  {}
+void spi_wait_idle(void){}
+void spi_set_8bit(void) {}
+void spi_set_16bit(void){}
+void spi_put16(uint16_t v){ feed((uint8_t)(v >> 8)); feed((uint8_t)v); }
+void spi_tx8(uint8_t b) { feed(b); }
+
+void lcd_port_init(uint8_t br_div){ (void)br_div; }
+void lcd_port_set_div(uint8_t br_div){ (void)br_div; }
+
+void lcd_port_dma_tx(const uint16_t *src, uint32_t count){
+    lcd.dc = 1;
+    while (count--) spi_put16(*src++);
+}
+
+const uint16_t *st7789_native_framebuffer(void){ return fb; }
+
+int st7789_native_save_ppm(const char *path){
+    FILE *f = fopen(path, "wb");
+    if (!f) return -1;
+    fprintf(f, "P6\n%d %d\n255\n", LCD_W, LCD_H);
+    for (int i = 0; i < LCD_W * LCD_H; i++){
+        uint16_t p = fb[i];
+        uint8_t rgb[3] = {
+            (uint8_t)(((p >> 11) & 0x1F) * 255 / 31),
+            (uint8_t)(((p >>  5) & 0x3F) * 255 / 63),
+            (uint8_t)(( p        & 0x1F) * 255 / 31)
+        };
+        fwrite(rgb, 1, 3, f);
+    }
+    fclose(f);
+    return 0;
+}
+#endif /* DRIVERS_NATIVE */
@@ -0,0 +1,230 @@
+#include <stdio.h>
+#include <math.h>
+#include "rgb565_blend.h"
+#include "drv_hal.h"
+
+/* ========================= Referência escalar ====================== */
+uint16_t rgb565_blend_ref(uint16_t fg, uint16_t bg, uint8_t alpha){
+    uint32_t ia = 255u - alpha;
+    uint32_t r = (((fg >> 11) & 0x1Fu) * alpha + ((bg >> 11) & 0x1Fu) * ia + 127u) / 255u;
+    uint32_t g = (((fg >>  5) & 0x3Fu) * alpha + ((bg >>  5) & 0x3Fu) * ia + 127u) / 255u;
+    uint32_t b = (( fg        & 0x1Fu) * alpha + ( bg        & 0x1Fu) * ia + 127u) / 255u;
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+/* ========================== Kernels 2 px/word ====================== */
+/* Empacota dois pixels numa palavra (p0 na metade baixa). */
+#if defined(__ARM_FEATURE_DSP)
+#define PACK2(p0, p1) __PKHBT((p0), (p1), 16)
+#else
+#define PACK2(p0, p1) (((p0) & 0xFFFFu) | ((uint32_t)(p1) << 16))
+#endif
+
+/* Alpha constante: cada canal dos 2 pixels fica numa lane de 16 bits e
+   um MUL de 32 bits escala as duas lanes de uma vez (produto <= 1008, sem
+   transbordar para a lane vizinha). k*: termo da frente + arredondamento. */
+static inline uint32_t blend_pair(uint32_t w, uint32_t ia, uint32_t kr, uint32_t kg, uint32_t kb){
+    uint32_t r = ((((w >> 11) & 0x001F001Fu) * ia + kr) >> 5) & 0x001F001Fu;
+    uint32_t g = ((((w >>  5) & 0x003F003Fu) * ia + kg) >> 5) & 0x003F003Fu;
+    uint32_t b = ((( w        & 0x001F001Fu) * ia + kb) >> 5) & 0x001F001Fu;
+    return (r << 11) | (g << 5) | b;
+}
+
+void rgb565_blend_span(uint16_t *dst, uint32_t n, uint16_t fg, uint32_t a5){
+    if (a5 == 0 || n == 0) return;
+    if (a5 >= BLEND_A_MAX){ while (n--) *dst++ = fg; return; }
+
+    uint32_t ia = BLEND_A_MAX - a5;
+    uint32_t kr = ((fg >> 11) & 0x1Fu) * a5 + 16u;
+    uint32_t kg = ((fg >>  5) & 0x3Fu) * a5 + 16u;
+    uint32_t kb = ( fg        & 0x1Fu) * a5 + 16u;
+    kr |= kr << 16; kg |= kg << 16; kb |= kb << 16;
+
+    /* cabeça desalinhada */
+    if (((uintptr_t)dst & 2u) != 0u){
+        *dst = (uint16_t)blend_pair(*dst, ia, kr, kg, kb);
+        dst++; n--;
+    }
+    uint32_t *d = (uint32_t*)dst;
+    for (uint32_t i = n >> 1; i; i--){
+        *d = blend_pair(*d, ia, kr, kg, kb);
+        d++;
+    }
+    if (n & 1u){
+        uint16_t *t = (uint16_t*)d;
+        *t = (uint16_t)blend_pair(*t, ia, kr, kg, kb);
+    }
+}
+
+/* Cobertura por pixel: layout expandido (1 MUL por pixel), lê/escreve pares. */
+static inline uint32_t blend_exp(uint32_t f, uint32_t bg, uint32_t a5){
+    uint32_t b = (bg | (bg << 16)) & 0x07E0F81Fu;
+    b += ((f - b) * a5) >> 5;
+    b &= 0x07E0F81Fu;
+    return (b | (b >> 16)) & 0xFFFFu;
+}
+
+static inline uint32_t blend_cov1(uint32_t f, uint16_t fg, uint32_t bg, uint32_t a5){
+    if (a5 == 0) return bg;
+    if (a5 >= BLEND_A_MAX) return fg;
+    return blend_exp(f, bg, a5);
+}
+
+void rgb565_blend_span_cov(uint16_t *dst, uint32_t n, uint16_t fg, const uint8_t *cov){
+    if (n == 0) return;
+    uint32_t f = (fg | ((uint32_t)fg << 16)) & 0x07E0F81Fu;
+
+    if (((uintptr_t)dst & 2u) != 0u){
+        *dst = (uint16_t)blend_cov1(f, fg, *dst, *cov++);
+        dst++; n--;
+    }
+    uint32_t *d = (uint32_t*)dst;
+    for (uint32_t i = n >> 1; i; i--){
+        uint32_t a0 = cov[0], a1 = cov[1];
+        cov += 2;
+        if ((a0 | a1) != 0u){           /* par só de fundo: nem lê */
+            uint32_t w = *d;
+            uint32_t p0 = blend_cov1(f, fg, w & 0xFFFFu, a0);
+            uint32_t p1 = blend_cov1(f, fg, w >> 16,     a1);
+            *d = PACK2(p0, p1);
+        }
+        d++;
+    }
+    if (n & 1u){
+        uint16_t *t = (uint16_t*)d;
+        *t = (uint16_t)blend_cov1(f, fg, *t, *cov);
+    }
+}
+
+/* 50%: (a & b) + ((a ^ b) >> 1) por canal; a máscara zera o LSB de cada
+   canal para o shift não vazar para o vizinho. 2 px por palavra, sem MUL. */
+void rgb565_blend_span_half(uint16_t *dst, uint32_t n, uint16_t fg){
+    if (n == 0) return;
+    uint32_t f = fg | ((uint32_t)fg << 16);
+
+    if (((uintptr_t)dst & 2u) != 0u){
+        uint32_t w = *dst;
+        *dst++ = (uint16_t)((w & f) + (((w ^ f) & 0xF7DEu) >> 1));
+        n--;
+    }
+    uint32_t *d = (uint32_t*)dst;
+    for (uint32_t i = n >> 1; i; i--){
+        uint32_t w = *d;
+        *d++ = (w & f) + (((w ^ f) & 0xF7DEF7DEu) >> 1);
+    }
+    if (n & 1u){
+        uint16_t *t = (uint16_t*)d;
+        uint32_t w = *t;
+        *t = (uint16_t)((w & f) + (((w ^ f) & 0xF7DEu) >> 1));
+    }
+}
+
+/* ======================= Primitivas anti-aliased =================== */
+static inline void plot_aa(uint16_t *buf, int w, int h, int x, int y, uint16_t color, uint32_t a5){
+    if (a5 == 0 || x < 0 || y < 0 || x >= w || y >= h) return;
+    uint16_t *p = &buf[y * w + x];
+    *p = (a5 >= BLEND_A_MAX) ? color : rgb565_blend(color, *p, a5);
+}
+
+/* Círculo cheio: miolo sólido, só a borda de ~1 px usa sqrtf.
+   Com d2 inteiro: d <= r-0.5  <=>  d2 <= r*r - r ;  d < r+0.5  <=>  d2 <= r*r + r */
+void rgb565_fill_circle_aa(uint16_t *buf, int w, int h, int cx, int cy, int r, uint16_t color){
+    if (r <= 0) return;
+    int in2  = r*r - r;
+    int out2 = r*r + r;
+    float rout = (float)r + 0.5f;
+
+    int ya = cy - r; if (ya < 0) ya = 0;
+    int yb = cy + r; if (yb >= h) yb = h - 1;
+    int xa = cx - r; if (xa < 0) xa = 0;
+    int xb = cx + r; if (xb >= w) xb = w - 1;
+
+    for (int y = ya; y <= yb; y++){
+        int dy = y - cy;
+        uint16_t *row = &buf[y * w];
+        for (int x = xa; x <= xb; x++){
+            int dx = x - cx;
+            int d2 = dx*dx + dy*dy;
+            if (d2 <= in2){
+                row[x] = color;
+            } else if (d2 <= out2){
+                int a = (int)((rout - sqrtf((float)d2)) * 32.0f + 0.5f);
+                if (a > 0) row[x] = rgb565_blend(color, row[x], (uint32_t)a);
+            }
+        }
+    }
+}
+
+/* Linha de Wu em ponto fixo 16.16: 2 pixels por coluna, pesos pela fração. */
+void rgb565_draw_line_aa(uint16_t *buf, int w, int h, int x0, int y0, int x1, int y1, uint16_t color){
+    int adx = (x1 > x0) ? (x1 - x0) : (x0 - x1);
+    int ady = (y1 > y0) ? (y1 - y0) : (y0 - y1);
+    int steep = ady > adx;
+    int t;
+    if (steep){ t = x0; x0 = y0; y0 = t;  t = x1; x1 = y1; y1 = t; }
+    if (x0 > x1){ t = x0; x0 = x1; x1 = t;  t = y0; y0 = y1; y1 = t; }
+
+    int dx = x1 - x0;
+    int32_t grad = dx ? (int32_t)(((int32_t)(y1 - y0) << 16) / dx) : 0;
+    int32_t yf = (int32_t)y0 << 16;
+
+    for (int x = x0; x <= x1; x++, yf += grad){
+        int yi = yf >> 16;
+        uint32_t fr = ((uint32_t)yf >> 11) & 31u;     /* fração em 5 bits */
+        if (steep){
+            plot_aa(buf, w, h, yi,     x, color, BLEND_A_MAX - fr);
+            plot_aa(buf, w, h, yi + 1, x, color, fr);
+        } else {
+            plot_aa(buf, w, h, x, yi,     color, BLEND_A_MAX - fr);
+            plot_aa(buf, w, h, x, yi + 1, color, fr);
+        }
+    }
+}
+
+/* ============================== Benchmark ========================== */
+#define BENCH_N 240   /* uma linha do painel */
+
+static void bench_print(const char *name, uint32_t cycles){
+    uint32_t cpp100 = (cycles * 100u) / BENCH_N;                        /* ciclos/px x100 */
+    uint32_t frame_us = (uint32_t)(((uint64_t)cycles * 240u) / (SystemCoreClock / 1000000u));
+    printf("[BLEND] %-5s %lu.%02lu cyc/px  (240x240: %lu us)\n", name,
+           (unsigned long)(cpp100 / 100u), (unsigned long)(cpp100 % 100u),
+           (unsigned long)frame_us);
+}
+
+void rgb565_blend_bench(void){
+    static uint16_t buf[BENCH_N] __attribute__((aligned(4)));
+    static uint8_t  a8[BENCH_N];
+    static uint8_t  cov[BENCH_N];
+    const uint16_t fg = 0xF800;
+    uint32_t t0, c;
+
+    for (int i = 0; i < BENCH_N; i++){ a8[i] = (uint8_t)(i * 37); cov[i] = (uint8_t)(a8[i] >> 3); }
+
+    for (int i = 0; i < BENCH_N; i++) buf[i] = (uint16_t)(i * 0x1357u);
+    t0 = drv_cycles();
+    for (int i = 0; i < BENCH_N; i++) buf[i] = rgb565_blend_ref(fg, buf[i], a8[i]);
+    c = drv_cycles() - t0;
+    bench_print("ref", c);
+
+    for (int i = 0; i < BENCH_N; i++) buf[i] = (uint16_t)(i * 0x1357u);
+    t0 = drv_cycles();
+    for (int i = 0; i < BENCH_N; i++) buf[i] = rgb565_blend(fg, buf[i], cov[i]);
+    c = drv_cycles() - t0;
+    bench_print("px", c);
+
+    t0 = drv_cycles();
+    rgb565_blend_span_cov(buf, BENCH_N, fg, cov);
+    c = drv_cycles() - t0;
+    bench_print("cov", c);
+
+    t0 = drv_cycles();
+    rgb565_blend_span(buf, BENCH_N, fg, 12);
+    c = drv_cycles() - t0;
+    bench_print("span", c);
+
+    t0 = drv_cycles();
+    rgb565_blend_span_half(buf, BENCH_N, fg);
+    c = drv_cycles() - t0;
+    bench_print("half", c);
+}
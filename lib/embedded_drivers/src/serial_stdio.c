@@ -0,0 +1,471 @@
+#ifndef DRIVERS_NATIVE
+#include "serial_stdio.h"
+#include "drv_hal.h"
+#include <sys/unistd.h>  // _write
+#include <stdio.h>
+#include <string.h>
+
+#ifdef DRIVERS_FREERTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+static inline void uart_putc(uint8_t c) {
+    while ((STDIO_USART->SR & USART_SR_TXE) == 0u) {}
+    STDIO_USART->DR = c;
+}
+static inline int uart_txc_done(void) {
+    return (STDIO_USART->SR & USART_SR_TC) != 0;
+}
+
+void serial_init(uint32_t baud) {
+    // Clocks
+    gpio_clk_enable(STDIO_TX_PORT);
+    gpio_clk_enable(STDIO_RX_PORT);
+    STDIO_USART_RCC_ENR |= STDIO_USART_RCC_BIT;
+
+    // TX/RX em AF (padrão PA9/PA10 AF7)
+    gpio_mode(STDIO_TX_PORT, STDIO_TX_PIN, GPIO_MODE_AF);
+    gpio_mode(STDIO_RX_PORT, STDIO_RX_PIN, GPIO_MODE_AF);
+    gpio_pull(STDIO_TX_PORT, STDIO_TX_PIN, 0u);
+    gpio_pull(STDIO_RX_PORT, STDIO_RX_PIN, 0u);
+    gpio_speed(STDIO_TX_PORT, STDIO_TX_PIN, 2u); // TX um pouco mais rápido
+    gpio_af(STDIO_TX_PORT, STDIO_TX_PIN, STDIO_USART_AF);
+    gpio_af(STDIO_RX_PORT, STDIO_RX_PIN, STDIO_USART_AF);
+
+    // 8N1 oversampling 16
+    STDIO_USART->CR1 = 0u;
+    STDIO_USART->CR2 = 0u;
+    STDIO_USART->CR3 = 0u;
+
+    // BRR (OVER8=0): mantissa.frac[3:0]
+    // Em F411: USART1 clock = PCLK2 (= APB2), aqui 100 MHz (clock.c)
+    uint32_t pclk = STDIO_USART_PCLK_HZ;
+    uint32_t div16 = (pclk + (baud/2u)) / baud; // arredonda
+    uint32_t mant  = div16 / 16u;
+    uint32_t frac  = div16 % 16u;
+    STDIO_USART->BRR = (mant << 4) | (frac & 0xFu);
+
+    // Habilita TX/RX e USART
+    STDIO_USART->CR1 |= USART_CR1_TE | USART_CR1_RE;
+    STDIO_USART->CR1 |= USART_CR1_UE;
+}
+
+void serial_stdio_init(uint32_t baud) {
+    serial_init(baud);
+    // stdout sem buffer para imprimir na hora
+    setvbuf(stdout, NULL, _IONBF, 0);
+}
+
+// ---- TX por DMA ----
+#define RING_MASK   (STDIO_TX_RING_SIZE - 1u)
+#define CHUNK_MAX   (STDIO_TX_RING_SIZE / 2u)   // OVERWRITE sempre acha metade livre
+_Static_assert((STDIO_TX_RING_SIZE & RING_MASK) == 0u, "STDIO_TX_RING_SIZE: potência de 2");
+
+/* Índices corridos (mascarar no acesso): tail <= next <= head.
+   [tail, next) é do DMA (em voo), [next, head) espera a vez. */
+static uint8_t  tx_ring[STDIO_TX_RING_SIZE];
+static volatile uint32_t tx_head, tx_tail, tx_next;
+static volatile uint32_t dma_start, dma_len;   // trecho em voo (len 0 = ocioso)
+static uint8_t  tx_async, tx_policy;
+static serial_tx_stats_t tx_stats;
+
+/* Com IRQ desligada. Manda o maior trecho contíguo pendente. */
+static void dma_kick(void) {
+    if (dma_len != 0u || tx_head == tx_next) return;
+    uint32_t off = tx_next & RING_MASK;
+    uint32_t n = tx_head - tx_next;
+    if (n > STDIO_TX_RING_SIZE - off) n = STDIO_TX_RING_SIZE - off;
+    if (n > CHUNK_MAX) n = CHUNK_MAX;
+
+    DMA_Stream_TypeDef *st = STDIO_TX_DMA_STREAM;
+    dma_clear(STDIO_TX_DMA, STDIO_TX_DMA_NUM, DMA_FLAGS_ALL(STDIO_TX_DMA_NUM));
+    st->M0AR = (uint32_t)&tx_ring[off];
+    st->NDTR = n;
+    dma_start = tx_next;
+    dma_len = n;
+    tx_next += n;
+    tx_stats.chunks++;
+    st->CR |= DMA_SxCR_EN;
+}
+
+void STDIO_TX_DMA_IRQHandler(void) {
+    uint32_t isr = dma_isr(STDIO_TX_DMA, STDIO_TX_DMA_NUM);
+    dma_clear(STDIO_TX_DMA, STDIO_TX_DMA_NUM, DMA_FLAGS_ALL(STDIO_TX_DMA_NUM));
+    if (isr & (DMA_FLAG_TC(STDIO_TX_DMA_NUM) | DMA_FLAG_TE(STDIO_TX_DMA_NUM))) {
+        tx_tail = tx_next;              // trecho inteiro (e o que OVERWRITE pulou) livre
+        dma_len = 0u;
+        dma_kick();
+    } else if (isr & DMA_FLAG_HT(STDIO_TX_DMA_NUM)) {
+        tx_tail = dma_start + dma_len / 2u;   // primeira metade já saiu
+    }
+}
+
+void serial_tx_async_init(uint8_t policy) {
+    tx_policy = policy;
+    if (tx_async) return;
+    RCC->AHB1ENR |= STDIO_TX_DMA_RCC_BIT;
+    DMA_Stream_TypeDef *st = STDIO_TX_DMA_STREAM;
+    dma_stream_off(st);
+    st->PAR = (uint32_t)&STDIO_USART->DR;
+    st->CR  = (STDIO_TX_DMA_CHANNEL << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_MINC | DMA_SxCR_DIR_0 |
+              DMA_SxCR_TCIE | DMA_SxCR_HTIE | DMA_SxCR_TEIE;          // M->P, 8 bits
+    st->FCR = 0u;                                                      // modo direto
+    NVIC_SetPriority(STDIO_TX_DMA_IRQn, STDIO_TX_IRQ_PRIO);
+    NVIC_EnableIRQ(STDIO_TX_DMA_IRQn);
+    while (!uart_txc_done()) {}          // o que o polling deixou no registrador
+    STDIO_USART->CR3 |= USART_CR3_DMAT;
+    tx_head = tx_tail = tx_next = 0u;
+    tx_async = 1;
+}
+
+void serial_tx_set_policy(uint8_t policy) { tx_policy = policy; }
+int  serial_tx_async_enabled(void) { return tx_async; }
+const serial_tx_stats_t *serial_tx_get_stats(void) { return &tx_stats; }
+
+/* Esperar só faz sentido se o ISR do DMA puder rodar. */
+static int can_wait(void) {
+    return __get_IPSR() == 0u && __get_PRIMASK() == 0u && __get_BASEPRI() == 0u;
+}
+
+static void wait_space(void) {
+#ifdef DRIVERS_FREERTOS
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) { vTaskDelay(1); return; }
+#endif
+    __WFI();                              // o próximo HT/TC acorda
+}
+
+/* Copia (com '\n' -> CRLF se crlf) até encher. Retorna quantos bytes de
+   p entraram. */
+static size_t ring_fill(const uint8_t *p, size_t count, int crlf) {
+    uint32_t pm = drv_irq_save();
+    uint32_t head = tx_head, free_b = STDIO_TX_RING_SIZE - (head - tx_tail);
+    size_t i = 0;
+
+    if (tx_policy == SERIAL_TX_OVERWRITE && free_b < count && tx_head != tx_next) {
+        tx_stats.discarded += tx_head - tx_next;          // fila antiga sai
+        head = tx_next;
+        free_b = STDIO_TX_RING_SIZE - (head - tx_tail);
+    }
+    uint32_t start = head;
+    for (; i < count; i++) {
+        uint32_t need = (crlf && p[i] == '\n') ? 2u : 1u;
+        if (free_b < need) break;
+        if (need == 2u) tx_ring[head++ & RING_MASK] = '\r';
+        tx_ring[head++ & RING_MASK] = p[i];
+        free_b -= need;
+    }
+    tx_stats.bytes += head - start;
+    tx_head = head;
+    uint32_t used = head - tx_tail;
+    if (used > tx_stats.high_water) tx_stats.high_water = used;
+    dma_kick();
+    drv_irq_restore(pm);
+    return i;
+}
+
+static void ring_write(const uint8_t *p, size_t count, int crlf) {
+    for (;;) {
+        size_t n = ring_fill(p, count, crlf);
+        p += n; count -= n;
+        if (count == 0u) return;
+        if (tx_policy != SERIAL_TX_BLOCK || !can_wait()) {
+            tx_stats.dropped += (uint32_t)count;
+            return;
+        }
+        tx_stats.waits++;
+        wait_space();
+    }
+}
+
+/* Bloco binário inteiro ou nada: quem decodifica não precisa lidar com
+   quadro pela metade. Copia em até dois memcpy (sem CRLF). */
+int serial_write_raw(const void *buf, size_t n) {
+    const uint8_t *p = (const uint8_t *)buf;
+    if (!tx_async) {
+        for (size_t i = 0; i < n; i++) uart_putc(p[i]);
+        return (int)n;
+    }
+    if (n > STDIO_TX_RING_SIZE / 2u) return 0;
+    for (;;) {
+        uint32_t pm = drv_irq_save();
+        uint32_t head = tx_head;
+        if (STDIO_TX_RING_SIZE - (head - tx_tail) < n && tx_policy == SERIAL_TX_OVERWRITE &&
+            tx_head != tx_next) {
+            tx_stats.discarded += tx_head - tx_next;
+            head = tx_next;
+        }
+        if (STDIO_TX_RING_SIZE - (head - tx_tail) >= n) {
+            uint32_t off = head & RING_MASK, a = STDIO_TX_RING_SIZE - off;
+            if (a > n) a = (uint32_t)n;
+            memcpy(&tx_ring[off], p, a);
+            memcpy(tx_ring, p + a, n - a);
+            tx_head = head + (uint32_t)n;
+            tx_stats.bytes += (uint32_t)n;
+            uint32_t used = tx_head - tx_tail;
+            if (used > tx_stats.high_water) tx_stats.high_water = used;
+            dma_kick();
+            drv_irq_restore(pm);
+            return (int)n;
+        }
+        drv_irq_restore(pm);
+        if (tx_policy != SERIAL_TX_BLOCK || !can_wait()) {
+            tx_stats.dropped += (uint32_t)n;
+            return 0;
+        }
+        tx_stats.waits++;
+        wait_space();
+    }
+}
+
+void serial_flush(void) {
+    if (tx_async && can_wait()) {
+        while (tx_tail != tx_head) {}
+    }
+    while (!uart_txc_done()) {}
+}
+
+void serial_write(const char *s) {
+    if (tx_async) {
+        size_t n = 0;
+        while (s[n]) n++;
+        ring_write((const uint8_t *)s, n, 1);
+        return;
+    }
+    while (*s) {
+        char c = *s++;
+        if (c == '\n') uart_putc('\r'); // CRLF
+        uart_putc((uint8_t)c);
+    }
+}
+
+// ---- RX por DMA circular ----
+#define RX_MASK     (STDIO_RX_RING_SIZE - 1u)
+#define RX_FRAMES   8u
+_Static_assert((STDIO_RX_RING_SIZE & RX_MASK) == 0u, "STDIO_RX_RING_SIZE: potência de 2");
+
+/* O DMA escreve em rx_ring sem parar; rx_head (corrido) é o quanto ele já
+   escreveu, atualizado a partir do NDTR em rx_sync(). HT/TC garantem um
+   sync a cada meia volta, então o delta nunca passa de uma volta. */
+static uint8_t  rx_ring[STDIO_RX_RING_SIZE];
+static volatile uint32_t rx_head, rx_tail, rx_pos;
+static uint32_t rx_frame[RX_FRAMES];              // rx_head em cada IDLE
+static volatile uint8_t rx_fhead, rx_ftail;
+static uint8_t  rx_async, rx_skip_lf;
+static serial_rx_stats_t rx_stats;
+
+/* Com IRQ desligada. */
+static void rx_sync(void) {
+    uint32_t pos = (STDIO_RX_RING_SIZE - STDIO_RX_DMA_STREAM->NDTR) & RX_MASK;
+    uint32_t n = (pos - rx_pos) & RX_MASK;
+    rx_pos = pos;
+    rx_head += n;
+    rx_stats.bytes += n;
+    uint32_t used = rx_head - rx_tail;
+    if (used > STDIO_RX_RING_SIZE) {               // o DMA deu a volta no leitor
+        rx_stats.overflows += used - STDIO_RX_RING_SIZE;
+        rx_tail = rx_head - STDIO_RX_RING_SIZE;
+    }
+    if (used > rx_stats.high_water) rx_stats.high_water = used;
+}
+
+/* Marca um fim de quadro; com a fila cheia o mais antigo some (dois
+   quadros viram um). */
+static void rx_mark_frame(void) {
+    uint8_t last = (uint8_t)(rx_fhead - 1u) & (RX_FRAMES - 1u);
+    if (rx_fhead != rx_ftail && rx_frame[last] == rx_head) return;
+    if ((uint8_t)(rx_fhead - rx_ftail) == RX_FRAMES) rx_ftail++;
+    rx_frame[rx_fhead & (RX_FRAMES - 1u)] = rx_head;
+    rx_fhead++;
+    rx_stats.frames++;
+}
+
+void STDIO_RX_DMA_IRQHandler(void) {
+    dma_clear(STDIO_RX_DMA, STDIO_RX_DMA_NUM, DMA_FLAGS_ALL(STDIO_RX_DMA_NUM));
+    rx_sync();
+}
+
+void STDIO_USART_IRQHandler(void) {
+    uint32_t sr = STDIO_USART->SR;
+    if (sr & (USART_SR_IDLE | USART_SR_ORE | USART_SR_FE | USART_SR_NE)) {
+        (void)STDIO_USART->DR;                     // SR + DR limpa IDLE/ORE/FE/NE
+        if (sr & USART_SR_ORE) rx_stats.ore++;
+        if (sr & (USART_SR_FE | USART_SR_NE)) rx_stats.errors++;
+        rx_sync();
+        if (sr & USART_SR_IDLE) rx_mark_frame();
+    }
+}
+
+void serial_rx_async_init(void) {
+    if (rx_async) return;
+    RCC->AHB1ENR |= STDIO_RX_DMA_RCC_BIT;
+    DMA_Stream_TypeDef *st = STDIO_RX_DMA_STREAM;
+    dma_stream_off(st);
+    dma_clear(STDIO_RX_DMA, STDIO_RX_DMA_NUM, DMA_FLAGS_ALL(STDIO_RX_DMA_NUM));
+    st->PAR  = (uint32_t)&STDIO_USART->DR;
+    st->M0AR = (uint32_t)rx_ring;
+    st->NDTR = STDIO_RX_RING_SIZE;
+    st->CR   = (STDIO_RX_DMA_CHANNEL << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_MINC | DMA_SxCR_CIRC |
+               DMA_SxCR_PL_1 | DMA_SxCR_TCIE | DMA_SxCR_HTIE;     // P->M, 8 bits, circular
+    st->FCR  = 0u;
+    rx_head = rx_tail = rx_pos = 0u;
+    rx_fhead = rx_ftail = 0u;
+    NVIC_SetPriority(STDIO_RX_DMA_IRQn, STDIO_RX_IRQ_PRIO);
+    NVIC_SetPriority(STDIO_USART_IRQn, STDIO_RX_IRQ_PRIO);
+    NVIC_EnableIRQ(STDIO_RX_DMA_IRQn);
+    NVIC_EnableIRQ(STDIO_USART_IRQn);
+    st->CR |= DMA_SxCR_EN;
+    (void)STDIO_USART->SR; (void)STDIO_USART->DR;  // descarta ORE/byte velho do polling
+    STDIO_USART->CR3 |= USART_CR3_DMAR | USART_CR3_EIE;
+    STDIO_USART->CR1 |= USART_CR1_IDLEIE;
+    rx_async = 1;
+}
+
+int  serial_rx_async_enabled(void) { return rx_async; }
+const serial_rx_stats_t *serial_rx_get_stats(void) { return &rx_stats; }
+
+/* Com IRQ desligada: descarta marcas de quadro que o leitor já passou. */
+static void rx_drop_frames(void) {
+    while (rx_ftail != rx_fhead && (int32_t)(rx_frame[rx_ftail & (RX_FRAMES - 1u)] - rx_tail) <= 0)
+        rx_ftail++;
+}
+
+/* Copia n bytes a partir de rx_tail e avança. */
+static void rx_take(uint8_t *dst, uint32_t n) {
+    uint32_t off = rx_tail & RX_MASK;
+    uint32_t a = STDIO_RX_RING_SIZE - off;
+    if (a > n) a = n;
+    for (uint32_t i = 0; i < a; i++) dst[i] = rx_ring[off + i];
+    for (uint32_t i = a; i < n; i++) dst[i] = rx_ring[i - a];
+    rx_tail += n;
+}
+
+int serial_available(void) {
+    if (!rx_async) return serial_readable();
+    uint32_t pm = drv_irq_save();
+    rx_sync();
+    uint32_t n = rx_head - rx_tail;
+    drv_irq_restore(pm);
+    return (int)n;
+}
+
+int serial_read(void *buf, size_t max) {
+    if (max == 0u) return 0;
+    if (!rx_async) {
+        if (!serial_readable()) return 0;
+        *(uint8_t *)buf = (uint8_t)(STDIO_USART->DR & 0xFF);
+        return 1;
+    }
+    uint32_t pm = drv_irq_save();
+    rx_sync();
+    uint32_t n = rx_head - rx_tail;
+    if (n > max) n = (uint32_t)max;
+    rx_take((uint8_t *)buf, n);
+    rx_drop_frames();
+    drv_irq_restore(pm);
+    return (int)n;
+}
+
+int serial_read_frame(void *buf, size_t max) {
+    if (!rx_async || max == 0u) return 0;
+    uint32_t pm = drv_irq_save();
+    rx_sync();
+    rx_drop_frames();
+    uint32_t n = 0u;
+    if (rx_ftail != rx_fhead) {
+        n = rx_frame[rx_ftail & (RX_FRAMES - 1u)] - rx_tail;
+        if (n > max) n = (uint32_t)max;           // o resto sai na próxima chamada
+        rx_take((uint8_t *)buf, n);
+        rx_drop_frames();
+    }
+    drv_irq_restore(pm);
+    return (int)n;
+}
+
+int serial_read_line(char *buf, size_t max) {
+    if (!rx_async || max < 2u) return 0;
+    uint32_t pm = drv_irq_save();
+    rx_sync();
+    int len = 0;
+    for (;;) {
+        uint32_t avail = rx_head - rx_tail, k;
+        if (avail && rx_skip_lf && rx_ring[rx_tail & RX_MASK] == '\n') { rx_tail++; avail--; }
+        if (avail) rx_skip_lf = 0;
+        for (k = 0; k < avail && k < max - 1u; k++) {
+            uint8_t c = rx_ring[(rx_tail + k) & RX_MASK];
+            if (c == '\n' || c == '\r') break;
+        }
+        if (k == avail && k < max - 1u) break;     // linha ainda incompleta
+        rx_take((uint8_t *)buf, k);
+        buf[k] = '\0';
+        if (k < avail && k < max - 1u) {           // consome o terminador
+            rx_skip_lf = (rx_ring[rx_tail & RX_MASK] == '\r');
+            rx_tail++;
+            rx_stats.lines++;
+        }
+        if (k) { len = (int)k; break; }            // linhas vazias não contam
+    }
+    rx_drop_frames();
+    drv_irq_restore(pm);
+    return len;
+}
+
+// ---- Retarget do printf: syscall _write ----
+int _write(int fd, const void *buf, size_t count) {
+    (void)fd; // stdout/stderr
+    const uint8_t *p = (const uint8_t*)buf;
+    if (tx_async) {                       // copia e volta; o DMA manda
+        ring_write(p, count, 1);
+        return (int)count;
+    }
+    for (size_t i = 0; i < count; i++) {
+        uint8_t c = p[i];
+        if (c == '\n') uart_putc('\r'); // CRLF
+        uart_putc(c);
+    }
+    while (!uart_txc_done()) {}
+    return (int)count;
+}
+
+// stdin: bloqueia até chegar pelo menos 1 byte e devolve o que já houver
+// (scanf/fgets remontam a linha). Sem o RX por DMA, 1 byte por polling.
+__attribute__((weak)) int _read(int fd, void *buf, size_t count) {
+    (void)fd;
+    if (count == 0u) return 0;
+    if (!rx_async) { *(uint8_t *)buf = (uint8_t)serial_getc_blocking(); return 1; }
+    int n;
+    while ((n = serial_read(buf, count)) == 0) {
+        if (!can_wait()) continue;
+        wait_space();                       // IDLE/HT/TC (ou o tick) acorda
+    }
+    return n;
+}
+// Opcional: stub mínimo (evita link-error caso use malloc em newlib nano)
+__attribute__((weak)) caddr_t _sbrk(int incr) {
+    extern uint8_t _end;     // fornecido pelo linker
+    static uint8_t *heap_end;
+    uint8_t *prev;
+    if (heap_end == 0) heap_end = &_end;
+    prev = heap_end;
+    heap_end += incr;
+    return (caddr_t)prev;
+}
+
+// Exposição opcional:
+void serial_putc(uint8_t c) { if (tx_async) ring_write(&c, 1, 0); else uart_putc(c); }
+int  serial_tx_done(void)   { return tx_head == tx_tail && uart_txc_done(); }
+int  serial_readable(void) {
+    if (rx_async) return serial_available() > 0;
+    return (STDIO_USART->SR & USART_SR_RXNE) != 0;
+}
+
+int  serial_getc_blocking(void) {
+    if (rx_async) {
+        uint8_t c;
+        while (serial_read(&c, 1) == 0) {}
+        return c;
+    }
+    while (!serial_readable()) {}
+    return (int)(STDIO_USART->DR & 0xFF);
+}
+#endif /* !DRIVERS_NATIVE */
@@ -0,0 +1,13 @@
+#include "spsc.h"
+
+int spsc_init(spsc_t *q, void *buf, uint32_t esz, uint32_t n){
+    if (buf == 0 || esz == 0 || n < 2u || (n & (n - 1u)) != 0u) return -1;
+    atomic_store_explicit(&q->head, 0u, memory_order_relaxed);
+    atomic_store_explicit(&q->tail, 0u, memory_order_relaxed);
+    q->overflows = 0;
+    q->high_water = 0;
+    q->buf = (uint8_t *)buf;
+    q->esz = esz;
+    q->mask = n - 1u;
+    return 0;
+}
@@ -0,0 +1,419 @@
+#include "st7789.h"
+#include "st7789_port.h"
+#include "font5x7.h"
+#include "rgb565_blend.h"
+#include "st7789_prof.h"
+
+/* delay_ms vem do projeto (delay.c / delay_rtos.c) ou do backend nativo */
+extern void delay_ms(uint32_t ms);
+
+/* ========================= Comandos do LCD ========================= */
+/* Envia comando 8-bit ao ST7789. */
+static inline void lcd_cmd(uint8_t c){ ST7789_PROF_BYTES(1); lcd_dc_cmd();  spi_set_8bit();  spi_tx8(c); }
+/* Envia dado 8-bit ao ST7789. */
+static inline void lcd_d8 (uint8_t d){ ST7789_PROF_BYTES(1); lcd_dc_data(); spi_set_8bit();  spi_tx8(d); }
+/* Envia dado 16-bit ao ST7789. */
+static inline void lcd_d16(uint16_t d){ ST7789_PROF_BYTES(2); lcd_dc_data(); spi_set_16bit(); spi_put16(d); spi_wait_idle(); }
+
+/* Reset por pino RST com atrasos padrão. */
+static inline void lcd_reset(void){
+    lcd_dc_data();
+    lcd_rst_high(); delay_ms(10);
+    lcd_rst_low();  delay_ms(50);
+    lcd_rst_high(); delay_ms(150);
+}
+
+/* Define janela de escrita e envia comando RAMWR (0x2C).
+   Coordenadas inclusivas. */
+static inline void set_addr(uint16_t x0,uint16_t y0,uint16_t x1,uint16_t y1){
+    ST7789_PROF_WINDOW();
+    lcd_cmd(0x2A); lcd_d16(x0); lcd_d16(x1);
+    lcd_cmd(0x2B); lcd_d16(y0); lcd_d16(y1);
+    lcd_cmd(0x2C);
+}
+
+/* Sequência de init para ST7789 (16bpp, RGB, INVON).
+   Se quiser BGR, troque o MADCTL (0x36) para 0x08. */
+static void st7789_init_sequence(void){
+    lcd_cmd(0x01); delay_ms(120);   /* SWRESET  */
+    lcd_cmd(0x11); delay_ms(120);   /* SLPOUT   */
+    lcd_cmd(0x36); lcd_d8(0x00);    /* MADCTL   (RGB)   */
+    lcd_cmd(0x3A); lcd_d8(0x55);    /* COLMOD   (16bpp) */
+    lcd_cmd(0xB2); lcd_d8(0x0C); lcd_d8(0x0C); lcd_d8(0x00); lcd_d8(0x33); lcd_d8(0x33);
+    lcd_cmd(0xB7); lcd_d8(0x35);
+    lcd_cmd(0xBB); lcd_d8(0x2B);
+    lcd_cmd(0xC0); lcd_d8(0x2C);
+    lcd_cmd(0xC2); lcd_d8(0x01);
+    lcd_cmd(0xC3); lcd_d8(0x0B);
+    lcd_cmd(0xC4); lcd_d8(0x20);
+    lcd_cmd(0xC6); lcd_d8(0x0F);
+    lcd_cmd(0xD0); lcd_d8(0xA4); lcd_d8(0xA1);
+    lcd_cmd(0x21);                /* INVON     */
+    lcd_cmd(0x29); delay_ms(20);  /* DISPON    */
+    set_addr(0,0,LCD_W-1,LCD_H-1);
+}
+
+/* Burst de meia-palavra constante (CPU) para n pixels. */
+static inline void push_solid(uint32_t n, uint16_t c){
+    ST7789_PROF_BYTES(2u * n);
+    lcd_dc_data();
+    spi_set_16bit();
+    while(n--) spi_put16(c);
+    spi_wait_idle();
+}
+
+/* ============================ API pública ========================== */
+void st7789_init(void){
+    lcd_port_init(5);                       /* /64 na partida, liga DMA */
+    st7789_prof_set_div(5);
+    lcd_blk_on();                           /* backlight ON   */
+    lcd_reset();
+    st7789_init_sequence();
+}
+
+void st7789_sleep(uint8_t on){
+    if (on){
+        lcd_blk_off();
+        lcd_cmd(0x28);                      /* DISPOFF  */
+        lcd_cmd(0x10); delay_ms(5);         /* SLPIN    */
+    } else {
+        lcd_cmd(0x11); delay_ms(5);         /* SLPOUT (RAM preservada) */
+        lcd_cmd(0x29);                      /* DISPON   */
+        lcd_blk_on();
+    }
+}
+
+void st7789_set_speed_div(uint8_t br_div){
+    if (br_div > 7) br_div = 7;
+    lcd_port_set_div(br_div);
+    st7789_prof_set_div(br_div);
+}
+
+void st7789_fill_screen(uint16_t color){
+    set_addr(0,0,LCD_W-1,LCD_H-1);
+    push_solid((uint32_t)LCD_W * LCD_H, color);
+}
+
+void st7789_fill_rect(uint16_t x,uint16_t y,uint16_t w,uint16_t h,uint16_t color){
+    if (x>=LCD_W || y>=LCD_H) return;
+    if (x+w>LCD_W) w = LCD_W-x;
+    if (y+h>LCD_H) h = LCD_H-y;
+    set_addr(x,y,x+w-1,y+h-1);
+    push_solid((uint32_t)w*h, color);
+}
+
+/* ============================ DMA helpers ========================== */
+/* DMA bloqueante com contabilidade do profiler. */
+static inline void lcd_dma_tx(const uint16_t *src, uint32_t count){
+    ST7789_PROF_BYTES(2u * count);
+    ST7789_PROF_T0(t0);
+    lcd_port_dma_tx(src, count);
+    ST7789_PROF_DMA(t0);
+}
+
+/* Envia um “sólido” (mesma cor) usando blocos repetidos. */
+static void lcd_tx_dma_solid(uint16_t color, uint32_t total_pixels){
+    enum { CHUNK = 128 };            /* 128 pixels por envio */
+    static uint16_t buf[CHUNK];
+
+    /* Preenche o bloco com a cor desejada */
+    for (int i = 0; i < CHUNK; i++) buf[i] = color;
+
+    while (total_pixels){
+        uint32_t n = (total_pixels > CHUNK) ? CHUNK : total_pixels;
+        lcd_dma_tx(buf, n);
+        total_pixels -= n;
+    }
+}
+
+/* ============================ API DMA ============================== */
+void st7789_fill_rect_dma(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color){
+    if (x>=LCD_W || y>=LCD_H) return;
+    if (x+w>LCD_W) w = LCD_W-x;
+    if (y+h>LCD_H) h = LCD_H-y;
+    if (w==0 || h==0) return;
+
+    /* Janela + RAMWR */
+    set_addr(x, y, x+w-1, y+h-1);
+
+    /* Envio sólido por blocos (MINC=1) */
+    lcd_tx_dma_solid(color, (uint32_t)w*h);
+}
+
+void st7789_fill_screen_dma(uint16_t color){
+    st7789_fill_rect_dma(0,0,LCD_W,LCD_H,color);
+}
+
+/* Copia um buffer w x h (row-major) para a janela (x,y) via DMA. */
+void st7789_blit(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *buf){
+    if (w==0 || h==0 || x+w>LCD_W || y+h>LCD_H) return;
+    set_addr(x, y, x+w-1, y+h-1);
+    uint32_t n = (uint32_t)w*h;
+    while (n){
+        uint32_t k = (n > 0xFFFFu) ? 0xFFFFu : n;   /* NDTR 16 bits */
+        lcd_dma_tx(buf, k);
+        buf += k; n -= k;
+    }
+}
+
+/* ============================ GFX básicas ========================== */
+void st7789_draw_pixel(uint16_t x, uint16_t y, uint16_t color){
+    if (x >= LCD_W || y >= LCD_H) return;
+    set_addr(x, y, x, y);
+    push_solid(1, color);
+}
+
+void st7789_draw_hline(uint16_t x, uint16_t y, uint16_t w, uint16_t color){
+    if (y >= LCD_H || x >= LCD_W) return;
+    if (x+w > LCD_W) w = LCD_W - x;
+    set_addr(x, y, x+w-1, y);
+    push_solid(w, color);
+}
+
+void st7789_draw_vline(uint16_t x, uint16_t y, uint16_t h, uint16_t color){
+    if (x >= LCD_W || y >= LCD_H) return;
+    if (y+h > LCD_H) h = LCD_H - y;
+    set_addr(x, y, x, y+h-1);
+    push_solid(h, color);
+}
+
+void st7789_draw_line(int x0, int y0, int x1, int y1, uint16_t color){
+    int dx = (x1 > x0) ? (x1 - x0) : (x0 - x1);
+    int sx = (x0 < x1) ? 1 : -1;
+    int dy = (y1 > y0) ? (y0 - y1) : (y1 - y0);
+    int sy = (y0 < y1) ? 1 : -1;
+    int err = dx + dy;
+    for (;;){
+        st7789_draw_pixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1) break;
+        int e2 = 2*err;
+        if (e2 >= dy){ err += dy; x0 += sx; }
+        if (e2 <= dx){ err += dx; y0 += sy; }
+    }
+}
+
+void st7789_draw_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color){
+    st7789_draw_hline(x, y, w, color);
+    st7789_draw_hline(x, y+h-1, w, color);
+    st7789_draw_vline(x, y, h, color);
+    st7789_draw_vline(x+w-1, y, h, color);
+}
+
+void st7789_draw_circle(int x0, int y0, int r, uint16_t color){
+    int x = r, y = 0, err = 0;
+    while (x >= y){
+        st7789_draw_pixel(x0+x, y0+y, color);
+        st7789_draw_pixel(x0+y, y0+x, color);
+        st7789_draw_pixel(x0-y, y0+x, color);
+        st7789_draw_pixel(x0-x, y0+y, color);
+        st7789_draw_pixel(x0-x, y0-y, color);
+        st7789_draw_pixel(x0-y, y0-x, color);
+        st7789_draw_pixel(x0+y, y0-x, color);
+        st7789_draw_pixel(x0+x, y0-y, color);
+        y++;
+        if (err <= 0){ err += 2*y+1; }
+        if (err > 0){ x--; err -= 2*x+1; }
+    }
+}
+
+void st7789_fill_circle(int x0, int y0, int r, uint16_t color){
+    int x = r, y = 0, err = 0;
+    while (x >= y){
+        st7789_draw_hline(x0-x, y0+y, 2*x+1, color);
+        st7789_draw_hline(x0-x, y0-y, 2*x+1, color);
+        st7789_draw_hline(x0-y, y0+x, 2*y+1, color);
+        st7789_draw_hline(x0-y, y0-x, 2*y+1, color);
+        y++;
+        if (err <= 0){ err += 2*y+1; }
+        if (err > 0){ x--; err -= 2*x+1; }
+    }
+}
+
+/* ============================== Texto ============================= */
+/* Glifo de ch; fora da fonte (controle, acentos em UTF-8/Latin-1) vira '?' */
+static const uint8_t *glyph_5x7(char ch){
+    unsigned char c = (unsigned char)ch;
+    if (c < 32u || c >= 32u + sizeof(FONT5x7) / sizeof(FONT5x7[0])) c = '?';
+    return FONT5x7[c - 32u];
+}
+
+static void draw_char_5x7(int x, int y, char ch, uint16_t fg, int scale, int bg_en, uint16_t bg){
+    const uint8_t* col = glyph_5x7(ch);
+    for (int cx=0; cx<5; cx++){
+        uint8_t bits = col[cx];
+        for (int sx=0; sx<scale; sx++){
+            int px = x + cx*scale + sx;
+            if (px < 0 || px >= LCD_W) continue;
+            for (int cy=0; cy<7; cy++){
+                int py0 = y + cy*scale;
+                if (py0 >= LCD_H) break;
+                if (bits & (1<<cy)) {
+                    set_addr(px, py0, px, py0 + (scale-1));
+                    push_solid(scale, fg);
+                } else if (bg_en){
+                    set_addr(px, py0, px, py0 + (scale-1));
+                    push_solid(scale, bg);
+                }
+            }
+        }
+    }
+    /* coluna de espaçamento à direita (bg opcional) */
+    if (bg_en){
+        for (int sx=0; sx<scale; sx++){
+            int px = x + 5*scale + sx;
+            if (px < 0 || px >= LCD_W) continue;
+            set_addr(px, y, px, y + 7*scale - 1);
+            push_solid(7*scale, bg);
+        }
+    }
+}
+
+void st7789_draw_text_5x7(int x, int y, const char* s, uint16_t fg, int scale, int bg_en, uint16_t bg){
+    int cx = x, cy = y;
+    if (scale < 1) scale = 1;
+    while(*s){
+        if (*s=='\n'){ cy += 8*scale; cx = x; s++; continue; }
+        draw_char_5x7(cx, cy, *s, fg, scale, bg_en, bg);
+        cx += 6*scale;
+        s++;
+        if (cx >= (LCD_W-6*scale)) { cy += 8*scale; cx = x; }
+        if (cy >= (LCD_H-8*scale)) break;
+    }
+}
+
+
+/* ========================== Anti-aliasing ========================== */
+/* O LCD não tem leitura (sem MISO): desenha num buffer com o fundo conhecido,
+   mistura ali e envia o bloco pronto por DMA. */
+#define AA_STRIP_W      64
+#define AA_STRIP_H      8
+#define AA_TEXT_MAX_SCALE 4
+#define AA_BUF_PIXELS   (6*AA_TEXT_MAX_SCALE * 7*AA_TEXT_MAX_SCALE)
+static uint16_t aa_buf[AA_BUF_PIXELS > AA_STRIP_W*AA_STRIP_H ? AA_BUF_PIXELS : AA_STRIP_W*AA_STRIP_H]
+    __attribute__((aligned(4)));
+
+static void aa_buf_fill(uint32_t n, uint16_t c){
+    for (uint32_t i = 0; i < n; i++) aa_buf[i] = c;
+}
+
+void st7789_fill_circle_aa(int x0, int y0, int r, uint16_t color, uint16_t bg){
+    int d = 2*r + 1;
+    if (r <= 0) return;
+    if (d > AA_STRIP_W){ st7789_fill_circle(x0, y0, r, color); return; }
+
+    int xa = x0 - r, xb = x0 + r + 1;
+    int ya = y0 - r, yb = y0 + r + 1;
+    if (xa < 0) xa = 0;
+    if (ya < 0) ya = 0;
+    if (xb > LCD_W) xb = LCD_W;
+    if (yb > LCD_H) yb = LCD_H;
+    int w = xb - xa;
+    if (w <= 0 || yb <= ya) return;
+
+    /* faixas de AA_STRIP_H linhas */
+    for (int sy = ya; sy < yb; sy += AA_STRIP_H){
+        int h = yb - sy;
+        if (h > AA_STRIP_H) h = AA_STRIP_H;
+        aa_buf_fill((uint32_t)w*h, bg);
+        rgb565_fill_circle_aa(aa_buf, w, h, x0 - xa, y0 - sy, r, color);
+        st7789_blit(xa, sy, w, h, aa_buf);
+    }
+}
+
+/* Wu direto no LCD: cada pixel é misturado com o fundo 'bg' informado. */
+void st7789_draw_line_aa(int x0, int y0, int x1, int y1, uint16_t color, uint16_t bg){
+    int adx = (x1 > x0) ? (x1 - x0) : (x0 - x1);
+    int ady = (y1 > y0) ? (y1 - y0) : (y0 - y1);
+    int steep = ady > adx;
+    int t;
+    if (steep){ t = x0; x0 = y0; y0 = t;  t = x1; x1 = y1; y1 = t; }
+    if (x0 > x1){ t = x0; x0 = x1; x1 = t;  t = y0; y0 = y1; y1 = t; }
+
+    int dx = x1 - x0;
+    int32_t grad = dx ? (int32_t)(((int32_t)(y1 - y0) << 16) / dx) : 0;
+    int32_t yf = (int32_t)y0 << 16;
+
+    for (int x = x0; x <= x1; x++, yf += grad){
+        int yi = yf >> 16;
+        uint32_t fr = ((uint32_t)yf >> 11) & 31u;
+        uint16_t c0 = fr ? rgb565_blend(color, bg, BLEND_A_MAX - fr) : color;
+        uint16_t c1 = rgb565_blend(color, bg, fr);
+        if (steep){
+            st7789_draw_pixel(yi, x, c0);
+            if (fr) st7789_draw_pixel(yi + 1, x, c1);
+        } else {
+            st7789_draw_pixel(x, yi, c0);
+            if (fr) st7789_draw_pixel(x, yi + 1, c1);
+        }
+    }
+}
+
+/* Cunha triangular (meia cobertura) no canto de uma célula vazia entre
+   dois pixels diagonais da fonte. (fx,fy) = canto: 0 = esquerda/topo. */
+static void aa_glyph_wedge(int bw, int cx, int cy, int s, int fx, int fy, uint16_t fg){
+    for (int v = 0; v < s; v++){
+        int dv = fy ? (s - 1 - v) : v;
+        uint16_t *row = &aa_buf[(cy*s + v) * bw + cx*s];
+        for (int u = 0; u < s; u++){
+            int du = fx ? (s - 1 - u) : u;
+            int k = du + dv;
+            if (k < s - 1)       row[u] = rgb565_blend(fg, row[u], BLEND_A_MAX / 2);
+            else if (k == s - 1) row[u] = rgb565_blend(fg, row[u], BLEND_A_MAX / 4);
+        }
+    }
+}
+
+static inline int glyph_bit(const uint8_t *col, int cx, int cy){
+    if (cx < 0 || cx > 4 || cy < 0 || cy > 6) return 0;
+    return (col[cx] >> cy) & 1;
+}
+
+static void draw_char_5x7_aa(int x, int y, char ch, uint16_t fg, int s, uint16_t bg){
+    int bw = 6*s, bh = 7*s;
+    if (x < 0 || y < 0 || x + bw > LCD_W || y + bh > LCD_H){
+        draw_char_5x7(x, y, ch, fg, s, 1, bg);
+        return;
+    }
+    const uint8_t* col = glyph_5x7(ch);
+
+    aa_buf_fill((uint32_t)bw*bh, bg);
+    for (int cx = 0; cx < 5; cx++){
+        for (int cy = 0; cy < 7; cy++){
+            if (!glyph_bit(col, cx, cy)) continue;
+            for (int v = 0; v < s; v++){
+                uint16_t *row = &aa_buf[(cy*s + v) * bw + cx*s];
+                for (int u = 0; u < s; u++) row[u] = fg;
+            }
+        }
+    }
+
+    /* suaviza os degraus das diagonais */
+    for (int cx = 0; cx < 5; cx++){
+        for (int cy = 0; cy < 6; cy++){
+            int a = glyph_bit(col, cx,   cy),   b = glyph_bit(col, cx+1, cy);
+            int c = glyph_bit(col, cx,   cy+1), d = glyph_bit(col, cx+1, cy+1);
+            if (a && d && !b && !c){
+                aa_glyph_wedge(bw, cx+1, cy,   s, 0, 1, fg);   /* b: canto inf. esq. */
+                aa_glyph_wedge(bw, cx,   cy+1, s, 1, 0, fg);   /* c: canto sup. dir. */
+            } else if (b && c && !a && !d){
+                aa_glyph_wedge(bw, cx,   cy,   s, 1, 1, fg);   /* a: canto inf. dir. */
+                aa_glyph_wedge(bw, cx+1, cy+1, s, 0, 0, fg);   /* d: canto sup. esq. */
+            }
+        }
+    }
+    st7789_blit(x, y, bw, bh, aa_buf);
+}
+
+void st7789_draw_text_5x7_aa(int x, int y, const char* s, uint16_t fg, int scale, uint16_t bg){
+    if (scale < 1) scale = 1;
+    if (scale > AA_TEXT_MAX_SCALE){ st7789_draw_text_5x7(x, y, s, fg, scale, 1, bg); return; }
+    int cx = x, cy = y;
+    while(*s){
+        if (*s=='\n'){ cy += 8*scale; cx = x; s++; continue; }
+        draw_char_5x7_aa(cx, cy, *s, fg, scale, bg);
+        cx += 6*scale;
+        s++;
+        if (cx >= (LCD_W-6*scale)) { cy += 8*scale; cx = x; }
+        if (cy >= (LCD_H-8*scale)) break;
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+/* Camada de porta do ST7789: GPIO de controle, SPI e DMA.
+   No alvo tudo que está no caminho quente (DC, TXE, DR) é inline com
+   porta/pino/instância constantes do drivers_config.h. */
+#include "drv_hal.h"
+
+#ifndef DRIVERS_NATIVE
+
+/* ========================== GPIO (BSRR) ============================ */
+static inline void lcd_dc_cmd(void)  { LCD_DC_PORT->BSRR  = (1u << (LCD_DC_PIN + 16)); }
+static inline void lcd_dc_data(void) { LCD_DC_PORT->BSRR  = (1u << LCD_DC_PIN); }
+static inline void lcd_rst_high(void){ LCD_RST_PORT->BSRR = (1u << LCD_RST_PIN); }
+static inline void lcd_rst_low(void) { LCD_RST_PORT->BSRR = (1u << (LCD_RST_PIN + 16)); }
+static inline void lcd_blk_on(void)  { LCD_BLK_PORT->BSRR = (1u << LCD_BLK_PIN); }
+static inline void lcd_blk_off(void) { LCD_BLK_PORT->BSRR = (1u << (LCD_BLK_PIN + 16)); }
+
+/* ============================ SPI core ============================= */
+/* Espera SPI ficar ocioso (BSY=0) e drena SR/DR. */
+static inline void spi_wait_idle(void){ while(LCD_SPI->SR & SPI_SR_BSY); (void)LCD_SPI->SR; (void)LCD_SPI->DR; }
+/* Configura SPI p/ quadro de 8 bits.  */
+static inline void spi_set_8bit(void){  LCD_SPI->CR1 &= ~SPI_CR1_SPE; LCD_SPI->CR1 &= ~SPI_CR1_DFF; LCD_SPI->CR1 |= SPI_CR1_SPE; }
+/* Configura SPI p/ quadro de 16 bits. */
+static inline void spi_set_16bit(void){ LCD_SPI->CR1 &= ~SPI_CR1_SPE; LCD_SPI->CR1 |=  SPI_CR1_DFF; LCD_SPI->CR1 |=  SPI_CR1_SPE; }
+/* Coloca 1 half-word no DR assim que houver espaço (sem esperar idle). */
+static inline void spi_put16(uint16_t v){ while(!(LCD_SPI->SR & SPI_SR_TXE)); LCD_SPI->DR = v; }
+/* Transmite 1 byte e aguarda idle. */
+static inline void spi_tx8(uint8_t b){ while(!(LCD_SPI->SR & SPI_SR_TXE)); *(__IO uint8_t*)&LCD_SPI->DR = b; spi_wait_idle(); }
+
+#else /* DRIVERS_NATIVE: controlador emulado em st7789_native.c */
+
+void lcd_dc_cmd(void);
+void lcd_dc_data(void);
+void lcd_rst_high(void);
+void lcd_rst_low(void);
+void lcd_blk_on(void);
+void lcd_blk_off(void);
+void spi_wait_idle(void);
+void spi_set_8bit(void);
+void spi_set_16bit(void);
+void spi_put16(uint16_t v);
+void spi_tx8(uint8_t b);
+
+#endif
+
+/* Inicializa GPIO de controle + SPI MODE3 com divisor br_div (0:/2 .. 7:/256). */
+void lcd_port_init(uint8_t br_div);
+/* Troca o prescaler do SPI. */
+void lcd_port_set_div(uint8_t br_div);
+/* Envia N half-words (DC=1, 16 bits) por DMA, bloqueante. count <= 65535. */
+void lcd_port_dma_tx(const uint16_t *src, uint32_t count);
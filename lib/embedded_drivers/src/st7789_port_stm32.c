@@ -0,0 +1,90 @@
+#ifndef DRIVERS_NATIVE
+#include "st7789_port.h"
+
+/* Inicializa SPI em MODE3 com divisor configurável.
+   Pinos SCK/MOSI/DC/RST/BLK/CS conforme drivers_config.h (board.h).
+   CS opcional (forçado LOW se existir). */
+void lcd_port_init(uint8_t br_div){
+    gpio_clk_enable(LCD_SCK_PORT);
+    gpio_clk_enable(LCD_MOSI_PORT);
+    gpio_clk_enable(LCD_DC_PORT);
+    gpio_clk_enable(LCD_RST_PORT);
+    gpio_clk_enable(LCD_BLK_PORT);
+    gpio_clk_enable(LCD_CS_PORT);
+    LCD_SPI_RCC_ENR |= LCD_SPI_RCC_BIT;
+
+    /* SCK, MOSI em AF */
+    gpio_mode(LCD_SCK_PORT,  LCD_SCK_PIN,  GPIO_MODE_AF);
+    gpio_mode(LCD_MOSI_PORT, LCD_MOSI_PIN, GPIO_MODE_AF);
+    gpio_af(LCD_SCK_PORT,  LCD_SCK_PIN,  LCD_SPI_AF);
+    gpio_af(LCD_MOSI_PORT, LCD_MOSI_PIN, LCD_SPI_AF);
+    gpio_speed(LCD_SCK_PORT,  LCD_SCK_PIN,  3u);
+    gpio_speed(LCD_MOSI_PORT, LCD_MOSI_PIN, 3u);
+
+    /* DC/RST/BLK/CS -> saída */
+    gpio_mode(LCD_DC_PORT,  LCD_DC_PIN,  GPIO_MODE_OUT);
+    gpio_mode(LCD_RST_PORT, LCD_RST_PIN, GPIO_MODE_OUT);
+    gpio_mode(LCD_BLK_PORT, LCD_BLK_PIN, GPIO_MODE_OUT);
+    gpio_mode(LCD_CS_PORT,  LCD_CS_PIN,  GPIO_MODE_OUT);
+    gpio_speed(LCD_DC_PORT,  LCD_DC_PIN,  3u);
+    gpio_speed(LCD_RST_PORT, LCD_RST_PIN, 3u);
+    gpio_speed(LCD_BLK_PORT, LCD_BLK_PIN, 3u);
+    gpio_speed(LCD_CS_PORT,  LCD_CS_PIN,  3u);
+
+    /* CS LOW fixo (se existir) */
+    pin_clr(LCD_CS_PORT, LCD_CS_PIN);
+
+    LCD_SPI->CR1 = 0; LCD_SPI->CR2 = 0;
+    LCD_SPI->CR1 = SPI_CR1_MSTR | ((uint32_t)br_div << SPI_CR1_BR_Pos) | SPI_CR1_SSM | SPI_CR1_SSI;
+    LCD_SPI->CR1 |= SPI_CR1_CPOL | SPI_CR1_CPHA;  /* MODE3 */
+    LCD_SPI->CR1 |= SPI_CR1_SPE;
+
+    RCC->AHB1ENR |= LCD_DMA_RCC_BIT;              /* habilita DMA */
+}
+
+void lcd_port_set_div(uint8_t br_div){
+    LCD_SPI->CR1 &= ~SPI_CR1_SPE;
+    LCD_SPI->CR1 &= ~SPI_CR1_BR;
+    LCD_SPI->CR1 |= ((uint32_t)br_div << SPI_CR1_BR_Pos);
+    LCD_SPI->CR1 |= SPI_CR1_SPE;
+}
+
+/* Envia N half-words (16-bit) da memória para o SPI via DMA. */
+void lcd_port_dma_tx(const uint16_t *src, uint32_t count){
+    /* SPI em 16-bit, DC=1 (dados) */
+    lcd_dc_data();
+    spi_set_16bit();
+
+    /* Desliga stream e limpa flags */
+    dma_stream_off(LCD_DMA_STREAM);
+    dma_clear(LCD_DMA, LCD_DMA_STREAM_NUM, DMA_FLAGS_ALL(LCD_DMA_STREAM_NUM));
+
+    /* Endereços e tamanho */
+    LCD_DMA_STREAM->PAR  = (uint32_t)&LCD_SPI->DR;  /* periférico */
+    LCD_DMA_STREAM->M0AR = (uint32_t)src;           /* memória (buffer) */
+    LCD_DMA_STREAM->NDTR = count;                   /* número de half-words */
+
+    /* Canal do config, Mem->Periph, PSIZE=16, MSIZE=16, MINC=1 */
+    LCD_DMA_STREAM->CR =
+        (LCD_DMA_CHANNEL << DMA_SxCR_CHSEL_Pos) |
+        DMA_SxCR_DIR_0            |   /* 01: Mem->Periph */
+        DMA_SxCR_PSIZE_0          |   /* 16-bit */
+        DMA_SxCR_MSIZE_0          |   /* 16-bit */
+        DMA_SxCR_MINC             |   /* incrementa memória */
+        DMA_SxCR_PL_1;
+
+    /* Habilita TXDMA e dispara */
+    LCD_SPI->CR2 |= SPI_CR2_TXDMAEN;
+    LCD_DMA_STREAM->CR |= DMA_SxCR_EN;
+
+    /* Espera TC */
+    while (!(dma_isr(LCD_DMA, LCD_DMA_STREAM_NUM) & DMA_FLAG_TC(LCD_DMA_STREAM_NUM)));
+
+    /* Desliga e limpa */
+    dma_stream_off(LCD_DMA_STREAM);
+    dma_clear(LCD_DMA, LCD_DMA_STREAM_NUM, DMA_FLAGS_ALL(LCD_DMA_STREAM_NUM));
+
+    LCD_SPI->CR2 &= ~SPI_CR2_TXDMAEN;
+    spi_wait_idle();
+}
+#endif /* !DRIVERS_NATIVE */
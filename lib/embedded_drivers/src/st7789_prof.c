@@ -0,0 +1,153 @@
+#ifdef ST7789_PROFILE
+#include <stdio.h>
+#include "st7789.h"
+#include "st7789_prof.h"
+#include "log_task.h"
+#include "fmt.h"
+
+st7789_prof_cnt_t st7789_prof_cnt;
+
+static st7789_prof_t prof = { .frame_min_cyc = 0xFFFFFFFFu };
+static uint8_t  spi_div = 5;
+static uint32_t t_begin;
+static uint32_t t_last_end;
+static uint8_t  have_end;
+static uint8_t  in_frame;
+
+void st7789_prof_set_div(uint8_t br_div){ spi_div = br_div; }
+
+void st7789_prof_reset(void){
+    prof = (st7789_prof_t){0};
+    prof.frame_min_cyc = 0xFFFFFFFFu;
+    st7789_prof_cnt = (st7789_prof_cnt_t){0};
+    have_end = 0;
+    in_frame = 0;
+}
+
+const st7789_prof_t *st7789_prof_get(void){ return &prof; }
+
+void st7789_prof_frame_begin(void){
+    t_begin = drv_cycles();
+    in_frame = 1;
+}
+
+static inline void hist_add(uint16_t *h, uint32_t bin){
+    if (bin >= ST7789_PROF_BINS) bin = ST7789_PROF_BINS - 1;
+    if (h[bin] != 0xFFFFu) h[bin]++;
+}
+
+void st7789_prof_frame_end(void){
+    uint32_t now = drv_cycles();
+    uint32_t cyc_ms = SystemCoreClock / 1000u;
+
+    /* end sem begin só fecha o período */
+    if (in_frame){
+        uint32_t f = now - t_begin;
+        prof.frame_cyc = f;
+        prof.frames++;
+        prof.frame_sum_cyc += f;
+        if (f < prof.frame_min_cyc) prof.frame_min_cyc = f;
+        if (f > prof.frame_max_cyc) prof.frame_max_cyc = f;
+
+        uint32_t ms = f / cyc_ms;
+        hist_add(prof.hist_frame, ms ? (uint32_t)(32 - __builtin_clz(ms)) : 0u);
+        in_frame = 0;
+    }
+
+    /* Período e utilização só a partir do 2º frame_end */
+    if (have_end){
+        uint32_t p = now - t_last_end;
+        prof.period_cyc = p;
+        prof.bytes   = st7789_prof_cnt.bytes;
+        prof.windows = st7789_prof_cnt.windows;
+        prof.dma_cyc = st7789_prof_cnt.dma_cyc;
+
+        /* tempo de fio: 8 bits x (2 << div) ciclos de PCLK, convertido p/ CPU */
+        uint64_t wire = (uint64_t)prof.bytes * 8u * (2u << spi_div);
+        wire = wire * SystemCoreClock / LCD_SPI_PCLK_HZ;
+        uint32_t pct = p ? (uint32_t)((wire * 100u) / p) : 0u;
+        prof.spi_pct = (pct > 100u) ? 100u : pct;
+
+        uint32_t fps = p ? SystemCoreClock / p : 0u;
+        hist_add(prof.hist_fps, (fps < 30u) ? fps / 5u : (fps < 60u ? 6u : 7u));
+        hist_add(prof.hist_spi, (prof.spi_pct * ST7789_PROF_BINS) / 100u);
+    }
+    st7789_prof_cnt = (st7789_prof_cnt_t){0};
+    t_last_end = now;
+    have_end = 1;
+}
+
+/* ciclos -> décimos de ms */
+static inline uint32_t cyc_ms10(uint32_t cyc){
+    return (uint32_t)(((uint64_t)cyc * 10u) / (SystemCoreClock / 1000u));
+}
+
+/* x10 com uma casa: "12.3" */
+static void fmt_x10(char *b, uint32_t n, uint32_t v10){
+    fmt_t w;
+    fmt_init(&w, b, n);
+    fmt_ufix(&w, v10, 1);
+}
+
+#define OV_W 84
+#define OV_H 36
+
+void st7789_prof_draw_overlay(int corner){
+    char buf[32];
+    fmt_t w;
+    int x = (corner & 1) ? LCD_W - OV_W : 0;
+    int y = (corner & 2) ? LCD_H - OV_H : 0;
+
+    st7789_fill_rect_dma(x, y, OV_W, OV_H, 0x0000);
+
+    /* todo quadro: sem snprintf (fmt.h) */
+    uint32_t fps10 = prof.period_cyc ? (uint32_t)(((uint64_t)SystemCoreClock * 10u) / prof.period_cyc) : 0u;
+    fmt_init(&w, buf, sizeof(buf));
+    FMT(&w, FMT_UFIX(cyc_ms10(prof.frame_cyc), 1), "ms ", FMT_UFIX(fps10, 1), "f");
+    st7789_draw_text_5x7(x + 2, y + 2, buf, 0xFFFF, 1, 0, 0);
+
+    fmt_reset(&w);
+    FMT(&w, "SPI", FMT_U(prof.spi_pct, 3, ' '), "% W", prof.windows);
+    st7789_draw_text_5x7(x + 2, y + 11, buf, 0xFFE0, 1, 0, 0);
+
+    /* histograma do tempo de quadro, normalizado pelo maior bin */
+    uint32_t hmax = 1;
+    for (int i = 0; i < ST7789_PROF_BINS; i++) if (prof.hist_frame[i] > hmax) hmax = prof.hist_frame[i];
+    for (int i = 0; i < ST7789_PROF_BINS; i++){
+        uint32_t h = (prof.hist_frame[i] * 14u + hmax - 1u) / hmax;
+        if (h) st7789_fill_rect_dma(x + 2 + i * 10, y + OV_H - 1 - h, 8, h, 0x07E0);
+    }
+}
+
+/* Linha montada inteira antes de ir para o log (não intercala com outras tasks) */
+static void print_hist(const char *name, const char *const *lbl, const uint16_t *h){
+    char line[96];
+    int n = 0;
+    for (int i = 0; i < ST7789_PROF_BINS && n < (int)sizeof(line); i++)
+        n += snprintf(line + n, sizeof(line) - (size_t)n, " %s:%u", lbl[i], (unsigned)h[i]);
+    LOG_I("[PROF] %-5s%s\n", name, line);
+}
+
+void st7789_prof_print(void){
+    static const char *const l_frame[ST7789_PROF_BINS] = { "<1", "1-2", "2-4", "4-8", "8-16", "16-32", "32-64", ">64" };
+    static const char *const l_fps[ST7789_PROF_BINS]   = { "<5", "5-10", "10-15", "15-20", "20-25", "25-30", "30-60", ">60" };
+    static const char *const l_spi[ST7789_PROF_BINS]   = { "0", "12", "25", "37", "50", "62", "75", "87" };
+    char mn[12], av[12], mx[12], pe[12], dm[12];
+    uint32_t avg = prof.frames ? (uint32_t)(prof.frame_sum_cyc / prof.frames) : 0u;
+
+    fmt_x10(mn, sizeof(mn), prof.frames ? cyc_ms10(prof.frame_min_cyc) : 0u);
+    fmt_x10(av, sizeof(av), cyc_ms10(avg));
+    fmt_x10(mx, sizeof(mx), cyc_ms10(prof.frame_max_cyc));
+    fmt_x10(pe, sizeof(pe), cyc_ms10(prof.period_cyc));
+    fmt_x10(dm, sizeof(dm), cyc_ms10(prof.dma_cyc));
+
+    LOG_I("[PROF] frames=%lu  frame min/avg/max %s/%s/%s ms  periodo %s ms\n",
+          (unsigned long)prof.frames, mn, av, mx, pe);
+    LOG_I("[PROF] ultimo periodo: %lu bytes  %lu janelas  DMA %s ms  SPI %lu%% (div %u)\n",
+          (unsigned long)prof.bytes, (unsigned long)prof.windows, dm,
+          (unsigned long)prof.spi_pct, (unsigned)spi_div);
+    print_hist("ms",  l_frame, prof.hist_frame);
+    print_hist("fps", l_fps,   prof.hist_fps);
+    print_hist("spi%", l_spi,  prof.hist_spi);
+}
+#endif /* ST7789_PROFILE */
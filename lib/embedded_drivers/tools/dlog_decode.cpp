@@ -0,0 +1,290 @@
+// Decodificador do log diferido (dlog.h) no PC.
+//
+// Lê os formatos da seção .dlog do ELF do firmware e remonta as mensagens
+// que chegam pela serial. O texto de printf normal passa direto.
+//
+//   g++ -O2 -std=c++17 dlog_decode.cpp -o dlog_decode
+//   stty -F /dev/ttyUSB0 115200 raw -echo
+//   ./dlog_decode .pio/build/blackpill_f411ce/firmware.elf /dev/ttyUSB0
+//
+// Sem arquivo de entrada lê do stdin. --hz muda o clock usado para converter
+// o carimbo (ciclos do DWT) em segundos (padrão 100 MHz).
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+const uint8_t kSync = 0xD1;
+
+// ------------------------------ ELF --------------------------------------
+template <typename T>
+T rd(const std::vector<uint8_t> &f, size_t off) {
+    T v{};
+    if (off + sizeof(T) <= f.size()) std::memcpy(&v, &f[off], sizeof(T));
+    return v;   // ELF LE lido num host LE
+}
+
+bool load_dlog_section(const std::string &path, std::string &out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) { std::cerr << "nao abriu " << path << "\n"; return false; }
+    std::vector<uint8_t> f((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (f.size() < 52 || std::memcmp(f.data(), "\x7f" "ELF", 4) != 0 || f[5] != 1) {
+        std::cerr << path << ": nao e ELF little-endian\n";
+        return false;
+    }
+    const bool is64 = (f[4] == 2);
+    uint64_t shoff;
+    uint16_t shentsize, shnum, shstrndx;
+    if (is64) {
+        shoff = rd<uint64_t>(f, 0x28);
+        shentsize = rd<uint16_t>(f, 0x3A);
+        shnum = rd<uint16_t>(f, 0x3C);
+        shstrndx = rd<uint16_t>(f, 0x3E);
+    } else {
+        shoff = rd<uint32_t>(f, 0x20);
+        shentsize = rd<uint16_t>(f, 0x2E);
+        shnum = rd<uint16_t>(f, 0x30);
+        shstrndx = rd<uint16_t>(f, 0x32);
+    }
+    auto sec = [&](uint16_t i, uint32_t &name, uint64_t &off, uint64_t &size) {
+        size_t h = shoff + static_cast<size_t>(i) * shentsize;
+        name = rd<uint32_t>(f, h);
+        off = is64 ? rd<uint64_t>(f, h + 0x18) : rd<uint32_t>(f, h + 0x10);
+        size = is64 ? rd<uint64_t>(f, h + 0x20) : rd<uint32_t>(f, h + 0x14);
+    };
+    uint32_t nm;
+    uint64_t stroff, strsize;
+    sec(shstrndx, nm, stroff, strsize);
+    for (uint16_t i = 0; i < shnum; i++) {
+        uint64_t off, size;
+        sec(i, nm, off, size);
+        if (stroff + nm >= f.size()) continue;
+        if (std::strcmp(reinterpret_cast<const char *>(&f[stroff + nm]), ".dlog") != 0) continue;
+        if (off + size > f.size()) break;
+        out.assign(reinterpret_cast<const char *>(&f[off]), size);
+        return true;
+    }
+    std::cerr << path << ": sem secao .dlog (compilou com -DDLOG_BINARY?)\n";
+    return false;
+}
+
+// ---------------------------- Argumentos ---------------------------------
+struct Reader {
+    const uint8_t *p, *end;
+    bool ok = true;
+
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int sh = 0; sh < 64; sh += 7) {
+            if (p >= end) { ok = false; return 0; }
+            uint8_t b = *p++;
+            v |= static_cast<uint64_t>(b & 0x7F) << sh;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;
+        return 0;
+    }
+    int64_t sint() {
+        uint64_t z = varint();
+        return static_cast<int64_t>(z >> 1) ^ -static_cast<int64_t>(z & 1);
+    }
+    uint32_t u32le() {
+        if (end - p < 4) { ok = false; p = end; return 0; }
+        uint32_t v;
+        std::memcpy(&v, p, 4);
+        p += 4;
+        return v;
+    }
+    float f32() {
+        uint32_t u = u32le();
+        float v;
+        std::memcpy(&v, &u, 4);
+        return v;
+    }
+    std::string str() {
+        if (p >= end) { ok = false; return {}; }
+        size_t n = *p++;
+        if (static_cast<size_t>(end - p) < n) { ok = false; n = end - p; }
+        std::string s(reinterpret_cast<const char *>(p), n);
+        p += n;
+        return s;
+    }
+};
+
+// Formata como o printf do alvo, lendo cada argumento conforme a conversão.
+std::string render(const char *fmt, Reader &r) {
+    std::string out;
+    char tmp[512];
+    for (const char *c = fmt; *c; c++) {
+        if (*c != '%') { out += *c; continue; }
+        if (c[1] == '%') { out += '%'; c++; continue; }
+        std::string spec = "%";
+        c++;
+        while (*c && std::strchr("-+ #0", *c)) spec += *c++;
+        auto width = [&]() {
+            if (*c == '*') {
+                int64_t v = r.sint();
+                spec += std::to_string(r.ok ? v : 0);
+                c++;
+            } else {
+                while (*c >= '0' && *c <= '9') spec += *c++;
+            }
+        };
+        width();
+        if (*c == '.') { spec += *c++; width(); }
+        std::string len;
+        while (*c && std::strchr("hljztL", *c)) len += *c++;
+        if (!*c) break;
+        char conv = *c;
+        if (!r.ok || r.p >= r.end) { out += "<?>"; continue; }
+
+        switch (conv) {
+        case 'd': case 'i': {
+            int64_t v = r.sint();
+            if (len.empty() || len == "l") v = static_cast<int32_t>(v);   // int/long de 32 bits
+            else if (len == "h") v = static_cast<int16_t>(v);
+            else if (len == "hh") v = static_cast<int8_t>(v);
+            std::snprintf(tmp, sizeof tmp, (spec + "lld").c_str(), static_cast<long long>(v));
+            break;
+        }
+        case 'u': case 'x': case 'X': case 'o': {
+            uint64_t v = static_cast<uint64_t>(r.sint());
+            if (len.empty() || len == "l") v = static_cast<uint32_t>(v);
+            else if (len == "h") v = static_cast<uint16_t>(v);
+            else if (len == "hh") v = static_cast<uint8_t>(v);
+            std::snprintf(tmp, sizeof tmp, (spec + "ll" + conv).c_str(), static_cast<unsigned long long>(v));
+            break;
+        }
+        case 'c':
+            std::snprintf(tmp, sizeof tmp, (spec + "c").c_str(), static_cast<int>(r.sint()));
+            break;
+        case 'p':
+            std::snprintf(tmp, sizeof tmp, "0x%llx", static_cast<unsigned long long>(r.sint()));
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            std::snprintf(tmp, sizeof tmp, (spec + conv).c_str(), static_cast<double>(r.f32()));
+            break;
+        case 's': {
+            std::string s = r.str();
+            std::snprintf(tmp, sizeof tmp, (spec + "s").c_str(), s.c_str());
+            break;
+        }
+        default:   // %n e desconhecidos: não consomem nada no alvo
+            tmp[0] = '\0';
+            break;
+        }
+        out += tmp;
+    }
+    return out;
+}
+
+uint8_t crc8(const uint8_t *p, size_t n) {
+    uint8_t c = 0;
+    while (n--) {
+        c ^= *p++;
+        for (int i = 0; i < 8; i++) c = (c & 0x80) ? static_cast<uint8_t>((c << 1) ^ 0x07) : static_cast<uint8_t>(c << 1);
+    }
+    return c;
+}
+
+// ------------------------------ Fluxo ------------------------------------
+class Decoder {
+public:
+    Decoder(std::string table, double hz) : table_(std::move(table)), hz_(hz) {}
+
+    void feed(uint8_t b) {
+        buf_.push_back(b);
+        for (;;) {
+            size_t i = 0;
+            while (i < buf_.size() && buf_[i] != kSync) i++;
+            if (i) { text(buf_.data(), i); buf_.erase(buf_.begin(), buf_.begin() + i); }
+            if (buf_.size() < 2) return;
+            size_t total = static_cast<size_t>(buf_[1]) + 3;
+            if (buf_.size() < total) return;
+            if (frame(&buf_[2], buf_[1], buf_[total - 1])) {
+                buf_.erase(buf_.begin(), buf_.begin() + total);
+            } else {                                  // não era quadro: 0xD1 é texto
+                text(buf_.data(), 1);
+                buf_.erase(buf_.begin());
+                bad_++;
+            }
+        }
+    }
+
+    void finish() {
+        text(buf_.data(), buf_.size());
+        buf_.clear();
+        std::fflush(stdout);
+        if (bad_) std::fprintf(stderr, "[dlog] %lu quadros invalidos\n", bad_);
+    }
+
+private:
+    bool frame(const uint8_t *p, size_t len, uint8_t crc) {
+        if (crc8(p, len) != crc) return false;
+        Reader r{p, p + len};
+        uint64_t id = r.varint();
+        uint32_t t = r.u32le();
+        if (!r.ok || id >= table_.size()) return false;
+
+        // Carimbo: ciclos de 32 bits estendidos (quadros a menos de uma volta)
+        if (!have_t_) { t64_ = t; have_t_ = true; }
+        else t64_ += static_cast<uint32_t>(t - last_t_);
+        last_t_ = t;
+
+        std::string msg = render(table_.c_str() + id, r);
+        if (!at_line_start_) std::fputc('\n', stdout);
+        std::printf("[%12.6f] %s", static_cast<double>(t64_) / hz_, msg.c_str());
+        at_line_start_ = !msg.empty() && msg.back() == '\n';
+        return true;
+    }
+
+    void text(const uint8_t *p, size_t n) {
+        if (!n) return;
+        std::fwrite(p, 1, n, stdout);
+        at_line_start_ = (p[n - 1] == '\n');
+    }
+
+    std::string table_;
+    double hz_;
+    std::vector<uint8_t> buf_;
+    uint64_t t64_ = 0;
+    uint32_t last_t_ = 0;
+    bool have_t_ = false;
+    bool at_line_start_ = true;
+    unsigned long bad_ = 0;
+};
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    std::string elf, input;
+    double hz = 100e6;
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--hz") && i + 1 < argc) hz = std::atof(argv[++i]);
+        else if (elf.empty()) elf = argv[i];
+        else input = argv[i];
+    }
+    if (elf.empty() || hz <= 0) {
+        std::fprintf(stderr, "uso: %s firmware.elf [entrada] [--hz 100000000]\n", argv[0]);
+        return 2;
+    }
+    std::string table;
+    if (!load_dlog_section(elf, table)) return 1;
+
+    FILE *in = input.empty() ? stdin : std::fopen(input.c_str(), "rb");
+    if (!in) { std::perror(input.c_str()); return 1; }
+    Decoder d(table, hz);
+    int c;
+    while ((c = std::fgetc(in)) != EOF) {
+        d.feed(static_cast<uint8_t>(c));
+        if (c == '\n') std::fflush(stdout);
+    }
+    d.finish();
+    return 0;
+}